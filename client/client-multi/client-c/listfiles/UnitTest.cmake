@@ -30,11 +30,23 @@ configure_file("${CMAKE_CURRENT_SOURCE_DIR}/sonar-project.properties.in"
                "${CMAKE_CURRENT_SOURCE_DIR}/sonar-project.properties"
               )
 
-add_executable  (test_ext_log_storage_memory
-                    test/platform-impl/test_ext_log_storage_memory.c
+if(NOT KAA_WITH_FILE_LOG_STORAGE)
+    add_executable  (test_ext_log_storage_memory
+                        test/platform-impl/test_ext_log_storage_memory.c
+                        test/kaa_test_external.c
+                    )
+    target_link_libraries(test_ext_log_storage_memory kaac ${OPENSSL_LIBRARIES} ${CUNIT_LIB_NAME})
+endif()
+
+add_executable  (test_ext_log_storage_file
+                    test/platform-impl/test_ext_log_storage_file.c
                     test/kaa_test_external.c
+                    ${KAA_SRC_FOLDER}/collections/kaa_list.c
+                    ${KAA_SRC_FOLDER}/utilities/kaa_log.c
+                    ${KAA_SRC_FOLDER}/platform-impl/posix/logger.c
+                    ${KAA_SRC_FOLDER}/platform-impl/posix/posix_file_log_storage.c
                 )
-target_link_libraries(test_ext_log_storage_memory kaac ${OPENSSL_LIBRARIES} ${CUNIT_LIB_NAME})
+target_link_libraries(test_ext_log_storage_file ${CUNIT_LIB_NAME})
 
 add_executable  (test_ext_log_upload_strategy_by_volume
                     test/platform-impl/test_ext_log_upload_strategy_by_volume.c
@@ -96,6 +108,14 @@ add_executable  (test_common
                 )
 target_link_libraries(test_common kaac ${OPENSSL_LIBRARIES} ${CUNIT_LIB_NAME})
 
+add_executable  (test_logger
+                    test/test_kaa_logger.c
+                    test/kaa_test_external.c
+                    ${KAA_SRC_FOLDER}/utilities/kaa_log.c
+                    ${KAA_SRC_FOLDER}/platform-impl/posix/logger.c
+                )
+target_link_libraries(test_logger ${CUNIT_LIB_NAME})
+
 add_executable  (test_log
                     test/test_kaa_log.c
                     test/kaa_test_external.c
@@ -104,6 +124,7 @@ add_executable  (test_log
                     ${KAA_SRC_FOLDER}/avro_src/encoding_binary.c
                     ${KAA_SRC_FOLDER}/collections/kaa_list.c
                     ${KAA_SRC_FOLDER}/utilities/kaa_log.c
+                    ${KAA_SRC_FOLDER}/utilities/kaa_lzf.c
                     ${KAA_SRC_FOLDER}/platform-impl/posix/logger.c
                     ${KAA_SRC_FOLDER}/kaa_platform_utils.c
                     ${KAA_SRC_FOLDER}/kaa_bootstrap_manager.c
@@ -150,12 +171,29 @@ add_executable  (test_kaa_tcp_channel_operation
                 )
 target_link_libraries(test_kaa_tcp_channel_operation kaac ${CUNIT_LIB_NAME})
 
+add_executable  (test_posix_event_loop
+                    test/platform-impl/test_posix_event_loop.c
+                    test/kaa_test_external.c
+                )
+target_link_libraries(test_posix_event_loop kaac ${CUNIT_LIB_NAME})
+
 add_executable  (test_kaa_configuration_manager
                     test/test_kaa_configuration.c
                     test/kaa_test_external.c
                 )
 target_link_libraries(test_kaa_configuration_manager kaac ${CUNIT_LIB_NAME})
 
+# Builds the configuration manager once more, so that its on-demand decoding is covered too.
+add_executable  (test_kaa_configuration_manager_decode_on_demand
+                    test/test_kaa_configuration.c
+                    test/kaa_test_external.c
+                    ${KAA_SRC_FOLDER}/kaa_configuration_manager.c
+                )
+set_target_properties(test_kaa_configuration_manager_decode_on_demand PROPERTIES
+                        COMPILE_DEFINITIONS KAA_CONFIGURATION_DECODE_ON_DEMAND
+                     )
+target_link_libraries(test_kaa_configuration_manager_decode_on_demand kaac ${CUNIT_LIB_NAME})
+
 add_executable  (test_kaa_common_schema
                     test/test_kaa_common_schema.c
                     test/kaa_test_external.c
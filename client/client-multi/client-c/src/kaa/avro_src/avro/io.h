@@ -29,10 +29,14 @@ struct avro_reader_t_ {
     int64_t read;
 };
 
+typedef int (*avro_write_callback_t)(void *context, const void *buf, int64_t len);
+
 struct avro_writer_t_ {
     const char *buf;
     int64_t len;
     int64_t written;
+    avro_write_callback_t callback;
+    void *context;
 };
 
 typedef struct avro_reader_t_ *avro_reader_t;
@@ -40,6 +44,7 @@ typedef struct avro_writer_t_ *avro_writer_t;
 
 avro_reader_t avro_reader_memory(const char *buf, int64_t len);
 avro_writer_t avro_writer_memory(const char *buf, int64_t len);
+avro_writer_t avro_writer_callback(avro_write_callback_t callback, void *context);
 
 int avro_read(avro_reader_t reader, void *buf, int64_t len);
 int avro_skip(avro_reader_t reader, int64_t len);
@@ -50,6 +50,21 @@ avro_writer_t avro_writer_memory(const char *buf, int64_t len)
 	return mem_writer;
 }
 
+avro_writer_t avro_writer_callback(avro_write_callback_t callback, void *context)
+{
+	if (!callback) {
+		return NULL;
+	}
+	struct avro_writer_t_ *cb_writer =
+	    (struct avro_writer_t_ *) calloc(1, sizeof(struct avro_writer_t_));
+	if (!cb_writer) {
+		return NULL;
+	}
+	cb_writer->callback = callback;
+	cb_writer->context = context;
+	return cb_writer;
+}
+
 static int
 avro_read_memory(struct avro_reader_t_ *reader, void *buf, int64_t len)
 {
@@ -109,6 +124,13 @@ avro_write_memory(struct avro_writer_t_ *writer, void *buf, int64_t len)
 int avro_write(avro_writer_t writer, void *buf, int64_t len)
 {
 	if (buf && len >= 0) {
+		if (writer->callback) {
+			int rval = writer->callback(writer->context, buf, len);
+			if (!rval) {
+				writer->written += len;
+			}
+			return rval;
+		}
         return avro_write_memory(writer, buf, len);
 	}
 	return EINVAL;
@@ -163,6 +163,7 @@ static kaa_error_t kaa_context_destroy(kaa_context_t *context)
     kaa_profile_manager_destroy(context->profile_manager);
     kaa_bootstrap_manager_destroy(context->bootstrap_manager);
     kaa_channel_manager_destroy(context->channel_manager);
+    kaa_status_flush(context->status->status_instance);
     kaa_status_destroy(context->status->status_instance);
     KAA_FREE(context->status);
 #ifndef KAA_DISABLE_FEATURE_LOGGING
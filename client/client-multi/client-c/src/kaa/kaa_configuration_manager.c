@@ -50,7 +50,7 @@ struct kaa_configuration_manager {
 };
 
 
-static kaa_root_configuration_t *kaa_configuration_manager_deserialize(char *buffer, size_t buffer_size)
+static kaa_root_configuration_t *kaa_configuration_manager_deserialize(const char *buffer, size_t buffer_size)
 {
     KAA_RETURN_IF_NIL2(buffer, buffer_size, NULL);
 
@@ -84,8 +84,10 @@ kaa_error_t kaa_configuration_manager_create(kaa_configuration_manager_t **confi
 #endif
     }
 
+    manager->root_record = NULL;
     if (buffer && buffer_size > 0) {
         ext_calculate_sha_hash(buffer, buffer_size, manager->configuration_hash);
+#ifndef KAA_CONFIGURATION_DECODE_ON_DEMAND
         manager->root_record = kaa_configuration_manager_deserialize(buffer, buffer_size);
 
         if (!manager->root_record) {
@@ -94,6 +96,7 @@ kaa_error_t kaa_configuration_manager_create(kaa_configuration_manager_t **confi
                 KAA_FREE(buffer);
             return KAA_ERR_NOMEM;
         }
+#endif
 
         if (need_deallocation)
             KAA_FREE(buffer);
@@ -174,27 +177,36 @@ kaa_error_t kaa_configuration_manager_handle_server_sync(kaa_configuration_manag
             uint32_t body_size = KAA_NTOHL(*((uint32_t *) reader->current));
             reader->current += sizeof(uint32_t);
 
-            char body[body_size];
-            kaa_error_t error_code = kaa_platform_message_read_aligned(reader, body, body_size);
-            if (error_code) {
-                KAA_LOG_ERROR(self->logger, error_code, "Failed to read configuration body, size %u", body_size);
+            // The body is hashed, stored and decoded in place, without being copied out of the reader.
+            const char *body = reader->current;
+            if (!body_size || !kaa_platform_message_is_buffer_large_enough(reader, kaa_aligned_size_get(body_size))) {
+                KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to read configuration body, size %u", body_size);
                 return KAA_ERR_READ_FAILED;
             }
 #if KAA_CONFIGURATION_DELTA_SUPPORT
 
 #else
+            kaa_root_configuration_t *root_record = NULL;
+#ifdef KAA_CONFIGURATION_DECODE_ON_DEMAND
+            if (self->root_receiver.on_configuration_updated)
+#endif
+            {
+                root_record = kaa_configuration_manager_deserialize(body, body_size);
+                if (!root_record) {
+                    KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to deserialize configuration body, size %u", body_size);
+                    return KAA_ERR_READ_FAILED;
+                }
+            }
+
             if (self->root_record)
                 self->root_record->destroy(self->root_record);
-
-            self->root_record = kaa_configuration_manager_deserialize(body, body_size);
-            if (!self->root_record) {
-                KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to deserialize configuration body, size %u", body_size);
-                return KAA_ERR_READ_FAILED;
-            }
+            self->root_record = root_record;
 
             ext_calculate_sha_hash(body, body_size, self->configuration_hash);
             ext_configuration_store(body, body_size);
 #endif
+            kaa_platform_message_skip(reader, kaa_aligned_size_get(body_size));
+
             if (self->root_receiver.on_configuration_updated)
                 self->root_receiver.on_configuration_updated(self->root_receiver.context, self->root_record);
         }
@@ -206,7 +218,34 @@ kaa_error_t kaa_configuration_manager_handle_server_sync(kaa_configuration_manag
 
 const kaa_root_configuration_t *kaa_configuration_manager_get_configuration(kaa_configuration_manager_t *self)
 {
-    return self ? self->root_record : NULL;
+    KAA_RETURN_IF_NIL(self, NULL);
+
+#ifdef KAA_CONFIGURATION_DECODE_ON_DEMAND
+    if (!self->root_record) {
+        char *buffer = NULL;
+        size_t buffer_size = 0;
+        bool need_deallocation = false;
+        ext_configuration_read(&buffer, &buffer_size, &need_deallocation);
+        if (!buffer || !buffer_size) {
+            need_deallocation = false;
+#if KAA_CONFIGURATION_DATA_LENGTH > 0
+            buffer = (char *)KAA_CONFIGURATION_DATA;
+            buffer_size = KAA_CONFIGURATION_DATA_LENGTH;
+#endif
+        }
+
+        if (buffer && buffer_size > 0) {
+            self->root_record = kaa_configuration_manager_deserialize(buffer, buffer_size);
+            if (!self->root_record)
+                KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to deserialize stored configuration, size %zu", buffer_size);
+        }
+
+        if (need_deallocation)
+            KAA_FREE(buffer);
+    }
+#endif
+
+    return self->root_record;
 }
 
 
@@ -37,6 +37,9 @@ extern "C" {
  *
  * @param[in] self      The valid pointer to @link kaa_configuration_manager_t @endlink instance.
  *
+ * If the SDK is built with KAA_CONFIGURATION_DECODE_ON_DEMAND, the configuration is decoded from
+ * the persistent storage on the first call after startup or an update without a root receiver.
+ *
  * @return  The current configuration data (NOTE: don't modify this instance), or NULL if something went wrong.
  *          Don't cache this pointer, it could become invalid after the next configuration update.
  */
@@ -98,6 +98,7 @@ typedef struct {
 struct kaa_event_manager_t {
     sent_events_tuple_t         events_awaiting_response;
     kaa_list_t                 *pending_events;
+    kaa_list_t                 *pending_events_tail;    /* NULL if unknown */
     kaa_list_t                 *event_callbacks;
     kaa_list_t                 *transactions;
     kaa_list_t                 *event_listeners_requests;
@@ -107,6 +108,12 @@ struct kaa_event_manager_t {
     size_t                      extension_payload_size;
     kaa_event_sequence_number_status_t sequence_number_status;
 
+    bool                         is_batching_enabled;
+    kaa_event_batching_settings_t batching_settings;
+    size_t                       batch_events_count;
+    size_t                       batch_size;
+    kaa_time_t                   batch_deadline;
+
     kaa_status_t                *status;
     kaa_channel_manager_t       *channel_manager;
     kaa_logger_t                *logger;
@@ -258,6 +265,7 @@ kaa_error_t kaa_event_manager_create(kaa_event_manager_t **event_manager_p
     KAA_RETURN_IF_NIL(*event_manager_p, KAA_ERR_NOMEM);
 
     (*event_manager_p)->pending_events = NULL;
+    (*event_manager_p)->pending_events_tail = NULL;
     (*event_manager_p)->events_awaiting_response.sent_events = NULL;
     (*event_manager_p)->events_awaiting_response.request_id =  (size_t) -1;
     (*event_manager_p)->event_callbacks = NULL;
@@ -270,6 +278,11 @@ kaa_error_t kaa_event_manager_create(kaa_event_manager_t **event_manager_p
 
     (*event_manager_p)->sequence_number_status = KAA_EVENT_SEQUENCE_NUMBER_UNSYNCHRONIZED;
 
+    (*event_manager_p)->is_batching_enabled = false;
+    (*event_manager_p)->batch_events_count = 0;
+    (*event_manager_p)->batch_size = 0;
+    (*event_manager_p)->batch_deadline = 0;
+
     (*event_manager_p)->status = status;
     (*event_manager_p)->channel_manager = channel_manager;
     (*event_manager_p)->logger = logger;
@@ -287,6 +300,29 @@ void kaa_event_manager_destroy(kaa_event_manager_t *self)
     }
 }
 
+static void kaa_event_reset_batch(kaa_event_manager_t *self)
+{
+    self->batch_events_count = 0;
+    self->batch_size = 0;
+}
+
+static void kaa_event_request_sync(kaa_event_manager_t *self)
+{
+    kaa_event_reset_batch(self);
+
+    kaa_transport_channel_interface_t *channel =
+            kaa_channel_manager_get_transport_channel(self->channel_manager, event_sync_services[0]);
+    if (channel)
+        channel->sync_handler(channel->context, event_sync_services, 1);
+}
+
+static bool kaa_event_is_batch_full(kaa_event_manager_t *self)
+{
+    const kaa_event_batching_settings_t *settings = &self->batching_settings;
+    return (settings->max_events && self->batch_events_count >= settings->max_events)
+        || (settings->max_size && self->batch_size >= settings->max_size);
+}
+
 static kaa_error_t kaa_fill_event_structure(kaa_event_t *event
                                           , size_t sequence_number
                                           , const char *fqn
@@ -383,11 +419,18 @@ kaa_error_t kaa_event_manager_send_event(kaa_event_manager_t *self
     }
 
     if (self->pending_events) {
-        if (!kaa_list_push_back(self->pending_events, event)) {
+        if (!self->pending_events_tail) {
+            self->pending_events_tail = self->pending_events;
+            while (kaa_list_has_next(self->pending_events_tail))
+                self->pending_events_tail = kaa_list_next(self->pending_events_tail);
+        }
+        kaa_list_t *tail = kaa_list_insert_after(self->pending_events_tail, event);
+        if (!tail) {
             KAA_LOG_ERROR(self->logger, KAA_ERR_NOMEM, "Failed to save a new event");
             kaa_event_destroy(event);
             return KAA_ERR_NOMEM;
         }
+        self->pending_events_tail = tail;
     } else {
         self->pending_events = kaa_list_create(event);
         if (!self->pending_events) {
@@ -395,13 +438,77 @@ kaa_error_t kaa_event_manager_send_event(kaa_event_manager_t *self
             kaa_event_destroy(event);
             return KAA_ERR_NOMEM;
         }
+        self->pending_events_tail = self->pending_events;
     }
 
-    kaa_transport_channel_interface_t *channel =
-            kaa_channel_manager_get_transport_channel(self->channel_manager, event_sync_services[0]);
-    if (channel)
-        channel->sync_handler(channel->context, event_sync_services, 1);
+    if (self->is_batching_enabled) {
+        if (!self->batch_events_count)
+            self->batch_deadline = KAA_TIME() + self->batching_settings.max_delay;
+        ++self->batch_events_count;
+        self->batch_size += event_data_size;
+
+        if (!kaa_event_is_batch_full(self)) {
+            KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Event is batched (%zu events, %zu bytes)"
+                                                    , self->batch_events_count, self->batch_size);
+            return KAA_ERR_NONE;
+        }
+    }
+
+    kaa_event_request_sync(self);
+
+    return KAA_ERR_NONE;
+}
+
+
 
+kaa_error_t kaa_event_manager_set_batching(kaa_event_manager_t *self, const kaa_event_batching_settings_t *settings)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_NOT_INITIALIZED);
+
+    if (!settings) {
+        self->is_batching_enabled = false;
+        return kaa_event_manager_flush(self);
+    }
+
+    self->batching_settings = *settings;
+    self->is_batching_enabled = true;
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t kaa_event_manager_flush(kaa_event_manager_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_NOT_INITIALIZED);
+
+    if (self->batch_events_count)
+        kaa_event_request_sync(self);
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t kaa_event_manager_get_next_timeout(kaa_event_manager_t *self, kaa_time_t *timeout)
+{
+    KAA_RETURN_IF_NIL2(self, timeout, KAA_ERR_BADPARAM);
+
+    if (!self->batch_events_count || !self->batching_settings.max_delay)
+        return KAA_ERR_NOT_FOUND;
+
+    *timeout = self->batch_deadline;
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t kaa_event_manager_check_timeouts(kaa_event_manager_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_NOT_INITIALIZED);
+
+    if (self->batch_events_count && self->batching_settings.max_delay && KAA_TIME() >= self->batch_deadline) {
+        KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Batched events deadline has passed (%zu events)", self->batch_events_count);
+        kaa_event_request_sync(self);
+    }
     return KAA_ERR_NONE;
 }
 
@@ -658,6 +765,8 @@ kaa_error_t kaa_event_request_serialize(kaa_event_manager_t *self, size_t reques
             self->events_awaiting_response.sent_events = kaa_lists_merge(self->events_awaiting_response.sent_events
                                                                        , self->pending_events);
             self->pending_events = NULL;
+            self->pending_events_tail = NULL;
+            kaa_event_reset_batch(self);
         }
         if (self->event_listeners_requests) {
             *((uint8_t *) writer->current) = EVENT_LISTENERS_FIELD;
@@ -826,12 +935,8 @@ kaa_error_t kaa_event_handle_server_sync(kaa_event_manager_t *self
                 }
             }
         }
-        if (kaa_list_get_size(self->pending_events) > 0) {
-            kaa_transport_channel_interface_t *channel =
-                    kaa_channel_manager_get_transport_channel(self->channel_manager, event_sync_services[0]);
-            if (channel)
-                channel->sync_handler(channel->context, event_sync_services, 1);
-        }
+        if (kaa_list_get_size(self->pending_events) > 0)
+            kaa_event_request_sync(self);
     }
 
     if (request_id == self->events_awaiting_response.request_id) {
@@ -1026,14 +1131,13 @@ kaa_error_t kaa_event_finish_transaction(kaa_event_manager_t *self, kaa_event_bl
             }
             if (trx->events && kaa_list_get_size(trx->events) > 0) {
                 self->pending_events = kaa_lists_merge(self->pending_events, trx->events);
+                self->pending_events_tail = NULL;
                 need_sync = true;
                 trx->events = NULL;
             }
             kaa_list_remove_at(&self->transactions, it, &destroy_transaction);
-            kaa_transport_channel_interface_t *channel =
-                    kaa_channel_manager_get_transport_channel(self->channel_manager, event_sync_services[0]);
-            if (need_sync && channel)
-                channel->sync_handler(channel->context, event_sync_services, 1);
+            if (need_sync)
+                kaa_event_request_sync(self);
 
             return KAA_ERR_NONE;
         }
@@ -30,6 +30,7 @@ extern "C" {
 
 #include <stddef.h>
 #include "kaa_error.h"
+#include "platform/time.h"
 #include "platform/ext_event_listeners_callback.h"
 
 typedef void (*kaa_event_callback_t)(const char *event_fqn, const char *event_data, size_t event_data_size, kaa_endpoint_id_p event_source);
@@ -40,6 +41,65 @@ typedef size_t kaa_event_block_id;
     typedef struct kaa_event_manager_t      kaa_event_manager_t;
 #endif
 
+/**
+ * @brief Event batching settings.
+ *
+ * Events sent outside of event blocks are accumulated and a single sync is
+ * requested once any of the limits is reached. A zero limit is not checked.
+ */
+typedef struct {
+    size_t          max_events;     /**< Number of accumulated events which triggers the sync */
+    size_t          max_size;       /**< Total size of accumulated event data which triggers the sync */
+    kaa_time_t      max_delay;      /**< Time (in KAA_TIME() units) since the first accumulated event which triggers the sync */
+} kaa_event_batching_settings_t;
+
+
+
+/**
+ * @brief Enables or disables event batching.
+ *
+ * @param[in]       self                Valid pointer to the event manager instance.
+ * @param[in]       settings            Batching settings. @code NULL @endcode disables batching and
+ *                                      sends the accumulated events.
+ *
+ * @return Error code.
+ */
+kaa_error_t kaa_event_manager_set_batching(kaa_event_manager_t *self, const kaa_event_batching_settings_t *settings);
+
+
+/**
+ * @brief Requests the sync of the accumulated events regardless of the batching limits.
+ *
+ * @param[in]       self                Valid pointer to the event manager instance.
+ *
+ * @return Error code.
+ */
+kaa_error_t kaa_event_manager_flush(kaa_event_manager_t *self);
+
+
+/**
+ * @brief Returns the time when the accumulated events must be sent.
+ *
+ * Use it to sleep until @link kaa_event_manager_check_timeouts @endlink should be called.
+ *
+ * @param[in]       self                Valid pointer to the event manager instance.
+ * @param[out]      timeout             The deadline in KAA_TIME() units.
+ *
+ * @return Error code. @c KAA_ERR_NOT_FOUND if no events are accumulated or the delay limit is not set.
+ */
+kaa_error_t kaa_event_manager_get_next_timeout(kaa_event_manager_t *self, kaa_time_t *timeout);
+
+
+/**
+ * @brief Requests the sync of the accumulated events if their deadline has passed.
+ *
+ * @param[in]       self                Valid pointer to the event manager instance.
+ *
+ * @return Error code.
+ */
+kaa_error_t kaa_event_manager_check_timeouts(kaa_event_manager_t *self);
+
+
 
 /**
  * @brief Initiates a request to the server to search for available event listeners by given FQNs.
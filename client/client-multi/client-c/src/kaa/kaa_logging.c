@@ -30,11 +30,14 @@
 #include "kaa_platform_common.h"
 #include "utilities/kaa_mem.h"
 #include "utilities/kaa_log.h"
+#include "utilities/kaa_lzf.h"
 #include "avro_src/avro/io.h"
 
 
 
 #define KAA_LOGGING_RECEIVE_UPDATES_FLAG   0x01
+#define KAA_LOGGING_COMPRESSION_FLAG       0x02     /* Client: able to compress buckets; server: accepts compressed buckets */
+#define KAA_LOGGING_COMPRESSED_FLAG        0x04     /* Records are LZF compressed, preceded by their uncompressed size */
 #define KAA_MAX_PADDING_LENGTH             (KAA_ALIGNMENT - 1)
 
 
@@ -63,6 +66,8 @@ struct kaa_log_collector {
     kaa_logger_t               *logger;
     kaa_list_t                 *timeouts;
     bool                        is_sync_ignored;
+    bool                        is_compression_enabled;
+    bool                        is_compression_accepted;
 };
 
 
@@ -159,6 +164,8 @@ kaa_error_t kaa_log_collector_create(kaa_log_collector_t **log_collector_p
     collector->logger                      = logger;
     collector->timeouts                    = NULL;
     collector->is_sync_ignored             = false;
+    collector->is_compression_enabled      = false;
+    collector->is_compression_accepted     = false;
 
     *log_collector_p = collector;
     return KAA_ERR_NONE;
@@ -195,6 +202,16 @@ kaa_error_t kaa_logging_init(kaa_log_collector_t *self, void *log_storage_contex
 
 
 
+kaa_error_t kaa_logging_set_compression(kaa_log_collector_t *self, bool enabled)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    self->is_compression_enabled = enabled;
+    KAA_LOG_DEBUG(self->logger, KAA_ERR_NONE, "Log bucket compression is %s", enabled ? "enabled" : "disabled");
+    return KAA_ERR_NONE;
+}
+
+
+
 static void update_storage(kaa_log_collector_t *self)
 {
     switch (ext_log_upload_strategy_decide(self->log_upload_strategy_context, self->log_storage_context)) {
@@ -258,6 +275,35 @@ kaa_error_t kaa_logging_add_record(kaa_log_collector_t *self, kaa_user_log_recor
 
 
 
+kaa_error_t kaa_logging_get_next_timeout(kaa_log_collector_t *self, kaa_time_t *timeout)
+{
+    KAA_RETURN_IF_NIL2(self, timeout, KAA_ERR_BADPARAM);
+    KAA_RETURN_IF_NIL(self->timeouts, KAA_ERR_NOT_FOUND);
+
+    kaa_list_t *it = self->timeouts;
+    *timeout = ((timeout_info_t *)kaa_list_get_data(it))->timeout;
+    while ((it = kaa_list_next(it))) {
+        kaa_time_t bucket_timeout = ((timeout_info_t *)kaa_list_get_data(it))->timeout;
+        if (bucket_timeout < *timeout)
+            *timeout = bucket_timeout;
+    }
+
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t kaa_logging_check_timeouts(kaa_log_collector_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    KAA_RETURN_IF_NIL(self->log_storage_context, KAA_ERR_NOT_INITIALIZED);
+
+    is_timeout(self);
+    return KAA_ERR_NONE;
+}
+
+
+
 kaa_error_t kaa_logging_request_get_size(kaa_log_collector_t *self, size_t *expected_size)
 {
     KAA_RETURN_IF_NIL2(self, expected_size, KAA_ERR_BADPARAM);
@@ -285,6 +331,93 @@ kaa_error_t kaa_logging_request_get_size(kaa_log_collector_t *self, size_t *expe
 
 
 
+static kaa_error_t write_records(kaa_log_collector_t *self
+                               , kaa_platform_message_writer_t *writer
+                               , size_t bucket_size
+                               , uint16_t *records_count)
+{
+    kaa_error_t error = KAA_ERR_NONE;
+
+    while (!error && bucket_size > sizeof(uint32_t)) {
+        size_t record_len = 0;
+        error = ext_log_storage_write_next_record(self->log_storage_context
+                                                , writer->current + sizeof(uint32_t)
+                                                , bucket_size - sizeof(uint32_t)
+                                                , self->log_bucket_id
+                                                , &record_len);
+        switch (error) {
+        case KAA_ERR_NONE:
+            ++(*records_count);
+            *((uint32_t *) writer->current) = KAA_HTONL(record_len);
+            writer->current += (sizeof(uint32_t) + record_len);
+            kaa_platform_message_write_alignment(writer);
+            bucket_size -= (kaa_aligned_size_get(record_len) + sizeof(uint32_t));
+            break;
+        case KAA_ERR_NOT_FOUND:
+        case KAA_ERR_INSUFFICIENT_BUFFER:
+            // These errors are normal if they appear after at least one record got serialized
+            if (!*records_count) {
+                KAA_LOG_ERROR(self->logger, error, "Failed to write the log record");
+                return error;
+            }
+            break;
+        default:
+            KAA_LOG_ERROR(self->logger, error, "Failed to write the log record");
+            return error;
+        }
+    }
+
+    return KAA_ERR_NONE;
+}
+
+
+
+/*
+ * Extracts records into a scratch buffer and writes them LZF compressed.
+ * Falls back to the raw records if they don't get smaller.
+ */
+static kaa_error_t write_compressed_records(kaa_log_collector_t *self
+                                          , kaa_platform_message_writer_t *writer
+                                          , size_t bucket_size
+                                          , uint16_t *records_count
+                                          , bool *is_compressed)
+{
+    char *work_memory = (char *) KAA_MALLOC(KAA_LZF_WORK_MEMORY_SIZE + bucket_size);
+    if (!work_memory) {
+        KAA_LOG_WARN(self->logger, KAA_ERR_NOMEM, "Failed to allocate log compression buffer, sending uncompressed");
+        return write_records(self, writer, bucket_size, records_count);
+    }
+
+    char *raw_records = work_memory + KAA_LZF_WORK_MEMORY_SIZE;
+    kaa_platform_message_writer_t raw_writer = { raw_records, raw_records, raw_records + bucket_size };
+
+    kaa_error_t error = write_records(self, &raw_writer, bucket_size, records_count);
+    if (error) {
+        KAA_FREE(work_memory);
+        return error;
+    }
+
+    size_t raw_size = raw_writer.current - raw_writer.begin;
+    size_t compressed_size = raw_size - sizeof(uint32_t);
+
+    if (raw_size > sizeof(uint32_t)
+            && !kaa_lzf_compress(raw_records, raw_size, writer->current + sizeof(uint32_t), &compressed_size, work_memory)) {
+        KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Compressed log records from %zu to %zu bytes", raw_size, compressed_size);
+        *((uint32_t *) writer->current) = KAA_HTONL(raw_size);
+        writer->current += sizeof(uint32_t) + compressed_size;
+        kaa_platform_message_write_alignment(writer);
+        *is_compressed = true;
+    } else {
+        memcpy(writer->current, raw_records, raw_size);
+        writer->current += raw_size;
+    }
+
+    KAA_FREE(work_memory);
+    return KAA_ERR_NONE;
+}
+
+
+
 kaa_error_t kaa_logging_request_serialize(kaa_log_collector_t *self, kaa_platform_message_writer_t *writer)
 {
     KAA_RETURN_IF_NIL2(self, writer, KAA_ERR_BADPARAM);
@@ -298,7 +431,7 @@ kaa_error_t kaa_logging_request_serialize(kaa_log_collector_t *self, kaa_platfor
 
     kaa_platform_message_writer_t tmp_writer = *writer;
 
-    char *extension_size_p = tmp_writer.current + sizeof(uint32_t); // Pointer to the extension size. Will be filled in later.
+    kaa_platform_message_writer_t header_writer = tmp_writer; // Extension options and size will be filled in later.
     kaa_error_t error = kaa_platform_message_write_extension_header(&tmp_writer
                                                                   , KAA_LOGGING_EXTENSION_TYPE
                                                                   , KAA_LOGGING_RECEIVE_UPDATES_FLAG
@@ -325,40 +458,24 @@ kaa_error_t kaa_logging_request_serialize(kaa_log_collector_t *self, kaa_platfor
     KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Extracting log records... (bucket size %zu)", bucket_size);
 
     uint16_t records_count = 0;
+    bool is_compressed = false;
 
-    while (!error && bucket_size > sizeof(uint32_t)) {
-        size_t record_len = 0;
-        error = ext_log_storage_write_next_record(self->log_storage_context
-                                                , tmp_writer.current + sizeof(uint32_t)
-                                                , bucket_size - sizeof(uint32_t)
-                                                , self->log_bucket_id
-                                                , &record_len);
-        switch (error) {
-        case KAA_ERR_NONE:
-            ++records_count;
-            *((uint32_t *) tmp_writer.current) = KAA_HTONL(record_len);
-            tmp_writer.current += (sizeof(uint32_t) + record_len);
-            kaa_platform_message_write_alignment(&tmp_writer);
-            bucket_size -= (kaa_aligned_size_get(record_len) + sizeof(uint32_t));
-            break;
-        case KAA_ERR_NOT_FOUND:
-        case KAA_ERR_INSUFFICIENT_BUFFER:
-            // These errors are normal if they appear after at least one record got serialized
-            if (!records_count) {
-                KAA_LOG_ERROR(self->logger, error, "Failed to write the log record");
-                return error;
-            }
-            break;
-        default:
-            KAA_LOG_ERROR(self->logger, error, "Failed to write the log record");
-            return error;
-        }
-    }
+    if (self->is_compression_enabled && self->is_compression_accepted)
+        error = write_compressed_records(self, &tmp_writer, bucket_size, &records_count, &is_compressed);
+    else
+        error = write_records(self, &tmp_writer, bucket_size, &records_count);
+    KAA_RETURN_IF_ERR(error);
 
     size_t payload_size = tmp_writer.current - writer->current - KAA_EXTENSION_HEADER_SIZE;
     KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Extracted %u log records; total payload size %zu", records_count, payload_size);
 
-    *((uint32_t *) extension_size_p) = KAA_HTONL(payload_size);
+    uint32_t options = KAA_LOGGING_RECEIVE_UPDATES_FLAG;
+    if (self->is_compression_enabled)
+        options |= KAA_LOGGING_COMPRESSION_FLAG;
+    if (is_compressed)
+        options |= KAA_LOGGING_COMPRESSED_FLAG;
+
+    kaa_platform_message_write_extension_header(&header_writer, KAA_LOGGING_EXTENSION_TYPE, options, payload_size);
     *((uint16_t *) records_count_p) = KAA_HTONS(records_count);
     *writer = tmp_writer;
 
@@ -379,6 +496,13 @@ kaa_error_t kaa_logging_handle_server_sync(kaa_log_collector_t *self
 {
     KAA_RETURN_IF_NIL2(self, reader, KAA_ERR_BADPARAM);
 
+    bool is_compression_accepted = (extension_options & KAA_LOGGING_COMPRESSION_FLAG);
+    if (is_compression_accepted != self->is_compression_accepted) {
+        KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "Server %s compressed log buckets"
+                , is_compression_accepted ? "accepts" : "doesn't accept");
+        self->is_compression_accepted = is_compression_accepted;
+    }
+
     uint32_t delivery_status_count;
     kaa_error_t error_code = kaa_platform_message_read(reader, &delivery_status_count, sizeof(uint32_t));
     KAA_RETURN_IF_ERR(error_code);
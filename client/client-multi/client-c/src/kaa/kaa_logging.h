@@ -25,7 +25,9 @@
 # define KAA_LOGGING_H_
 
 
+# include <stdbool.h>
 # include "gen/kaa_logging_gen.h"
+# include "platform/time.h"
 # include "platform/ext_log_storage.h"
 # include "platform/ext_log_upload_strategy.h"
 
@@ -74,6 +76,48 @@ kaa_error_t kaa_logging_init(kaa_log_collector_t *self, void *log_storage_contex
  */
 kaa_error_t kaa_logging_add_record(kaa_log_collector_t *self, kaa_user_log_record_t *entry);
 
+
+
+/**
+ * @brief Enables or disables compression of log buckets.
+ *
+ * When enabled, the client advertises compression support in the logging extension
+ * options and compresses buckets with LZF once the server confirms it accepts them.
+ * Buckets which don't get smaller are sent uncompressed. Disabled by default.
+ *
+ * @param[in] self       Pointer to a @link kaa_log_collector_t @endlink instance.
+ * @param[in] enabled    Whether log buckets should be compressed.
+ *
+ * @return  Error code.
+ */
+kaa_error_t kaa_logging_set_compression(kaa_log_collector_t *self, bool enabled);
+
+
+
+/**
+ * @brief Retrieves the time the earliest log delivery in progress times out at.
+ *
+ * @param[in]  self       Pointer to a @link kaa_log_collector_t @endlink instance.
+ * @param[out] timeout    The time in @c KAA_TIME() units.
+ *
+ * @return  Error code. @c KAA_ERR_NOT_FOUND if no log delivery is in progress.
+ */
+kaa_error_t kaa_logging_get_next_timeout(kaa_log_collector_t *self, kaa_time_t *timeout);
+
+
+
+/**
+ * @brief Checks whether any log delivery timed out. If so, undelivered records are returned
+ * to the log storage and the upload strategy is notified.
+ *
+ * Timeouts are also checked whenever a new record is added.
+ *
+ * @param[in] self    Pointer to a @link kaa_log_collector_t @endlink instance.
+ *
+ * @return  Error code.
+ */
+kaa_error_t kaa_logging_check_timeouts(kaa_log_collector_t *self);
+
 # ifdef __cplusplus
 }      /* extern "C" */
 # endif
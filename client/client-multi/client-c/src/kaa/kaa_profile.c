@@ -15,6 +15,7 @@
  */
 #include <string.h>
 #include <stdbool.h>
+#include <errno.h>
 #include "platform/stdio.h"
 #include "avro_src/avro/io.h"
 #include "platform/ext_sha.h"
@@ -53,6 +54,8 @@ typedef struct {
 
 struct kaa_profile_manager_t {
     bool need_resync;
+    bool has_profile_revision;
+    uint32_t profile_revision;
     kaa_bytes_t profile_body;
     kaa_digest profile_hash;
     kaa_channel_manager_t *channel_manager;
@@ -82,6 +85,8 @@ kaa_error_t kaa_profile_manager_create(kaa_profile_manager_t **profile_manager_p
     KAA_RETURN_IF_NIL(profile_manager->extension_data, KAA_ERR_NOMEM);
 
     profile_manager->need_resync = true;
+    profile_manager->has_profile_revision = false;
+    profile_manager->profile_revision = 0;
 
     profile_manager->profile_body.size = 0;
     profile_manager->profile_body.buffer = NULL;
@@ -89,7 +94,16 @@ kaa_error_t kaa_profile_manager_create(kaa_profile_manager_t **profile_manager_p
     profile_manager->status = status;
     profile_manager->logger = logger;
 
-    ext_calculate_sha_hash(NULL, 0, profile_manager->profile_hash);
+    /* Hash of the empty profile: ext_calculate_sha_hash() rejects empty data */
+    kaa_sha_context_t sha_context;
+    kaa_error_t error = ext_sha_hash_init(&sha_context);
+    if (!error)
+        error = ext_sha_hash_final(&sha_context, profile_manager->profile_hash);
+    if (error) {
+        KAA_FREE(profile_manager->extension_data);
+        KAA_FREE(profile_manager);
+        return error;
+    }
     ext_copy_sha_hash(profile_manager->status->profile_hash, profile_manager->profile_hash);
 
     *profile_manager_p = profile_manager;
@@ -390,11 +404,28 @@ kaa_error_t kaa_profile_handle_server_sync(kaa_profile_manager_t *self
     return error_code;
 }
 
-kaa_error_t kaa_profile_manager_update_profile(kaa_profile_manager_t *self, kaa_profile_t *profile_body)
-{
 #if PROFILE_SCHEMA_VERSION > 1
-    KAA_RETURN_IF_NIL2(self, profile_body, KAA_ERR_BADPARAM);
+typedef struct {
+    kaa_sha_context_t   sha;
+    char               *buffer;
+    size_t              size;
+    size_t              written;
+} kaa_profile_hashing_writer_t;
+
+/* Copies serialized profile data into the buffer and hashes it on the fly. */
+static int kaa_profile_hashing_write(void *context, const void *buf, int64_t len)
+{
+    kaa_profile_hashing_writer_t *writer = (kaa_profile_hashing_writer_t *) context;
+    if ((int64_t) (writer->size - writer->written) < len)
+        return ENOSPC;
 
+    memcpy(writer->buffer + writer->written, buf, len);
+    writer->written += len;
+    return ext_sha_hash_update(&writer->sha, (const char *) buf, len) ? EINVAL : 0;
+}
+
+static kaa_error_t kaa_profile_manager_apply_profile(kaa_profile_manager_t *self, kaa_profile_t *profile_body)
+{
     size_t serialized_profile_size = profile_body->get_size(profile_body);
     if (!serialized_profile_size) {
         KAA_LOG_ERROR(self->logger, KAA_ERR_BADDATA, "Failed to update profile: serialize profile size is null."
@@ -405,16 +436,30 @@ kaa_error_t kaa_profile_manager_update_profile(kaa_profile_manager_t *self, kaa_
     char *serialized_profile = (char *) KAA_MALLOC(serialized_profile_size * sizeof(char));
     KAA_RETURN_IF_NIL(serialized_profile, KAA_ERR_NOMEM);
 
-    avro_writer_t writer = avro_writer_memory(serialized_profile, serialized_profile_size);
+    kaa_profile_hashing_writer_t hashing_writer = { .buffer = serialized_profile, .size = serialized_profile_size };
+
+    avro_writer_t writer = avro_writer_callback(&kaa_profile_hashing_write, &hashing_writer);
     if (!writer) {
         KAA_FREE(serialized_profile);
         return KAA_ERR_NOMEM;
     }
+
+    kaa_error_t error = ext_sha_hash_init(&hashing_writer.sha);
+    if (error) {
+        avro_writer_free(writer);
+        KAA_FREE(serialized_profile);
+        return error;
+    }
+
     profile_body->serialize(writer, profile_body);
     avro_writer_free(writer);
 
     kaa_digest new_hash;
-    ext_calculate_sha_hash(serialized_profile, serialized_profile_size, new_hash);
+    error = ext_sha_hash_final(&hashing_writer.sha, new_hash);
+    if (error) {
+        KAA_FREE(serialized_profile);
+        return error;
+    }
 
     if (!memcmp(new_hash, self->status->profile_hash, SHA_1_DIGEST_LENGTH)) {
         self->need_resync = false;
@@ -444,8 +489,44 @@ kaa_error_t kaa_profile_manager_update_profile(kaa_profile_manager_t *self, kaa_
     if (channel)
         channel->sync_handler(channel->context, profile_sync_services, 1);
 
+    return KAA_ERR_NONE;
+}
 #endif
+
+kaa_error_t kaa_profile_manager_update_profile(kaa_profile_manager_t *self, kaa_profile_t *profile_body)
+{
+#if PROFILE_SCHEMA_VERSION > 1
+    KAA_RETURN_IF_NIL2(self, profile_body, KAA_ERR_BADPARAM);
+
+    self->has_profile_revision = false;
+    return kaa_profile_manager_apply_profile(self, profile_body);
+#else
+    return KAA_ERR_NONE;
+#endif
+}
+
+kaa_error_t kaa_profile_manager_update_profile_revision(kaa_profile_manager_t *self
+                                                      , kaa_profile_t *profile_body
+                                                      , uint32_t revision)
+{
+#if PROFILE_SCHEMA_VERSION > 1
+    KAA_RETURN_IF_NIL2(self, profile_body, KAA_ERR_BADPARAM);
+
+    if (self->has_profile_revision && self->profile_revision == revision) {
+        KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Profile revision %u is unchanged, skipping serialization", revision);
+        self->need_resync = false;
+        return KAA_ERR_NONE;
+    }
+
+    kaa_error_t error_code = kaa_profile_manager_apply_profile(self, profile_body);
+    if (!error_code) {
+        self->has_profile_revision = true;
+        self->profile_revision = revision;
+    }
+    return error_code;
+#else
     return KAA_ERR_NONE;
+#endif
 }
 
 kaa_error_t kaa_profile_manager_set_endpoint_access_token(kaa_profile_manager_t *self, const char *token)
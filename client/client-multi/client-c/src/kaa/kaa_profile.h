@@ -65,6 +65,23 @@ typedef kaa_profile_basic_endpoint_profile_test_t kaa_profile_t;
  */
 kaa_error_t kaa_profile_manager_update_profile(kaa_profile_manager_t *self, kaa_profile_t *profile);
 
+/**
+ * @brief Updates user profile tracked by the application-defined revision.
+ *
+ * Behaves as @link kaa_profile_manager_update_profile @endlink, but if @p revision
+ * equals the revision of the previously applied profile, the profile is neither
+ * serialized nor hashed. Increment the revision each time the profile is changed.
+ *
+ * @param[in] self      Profile manager instance.
+ * @param[in] profile   Filled in user-defined profile data structure.
+ * @param[in] revision  Revision of the profile data.
+ *
+ * @return      Error code.
+ */
+kaa_error_t kaa_profile_manager_update_profile_revision(kaa_profile_manager_t *self
+                                                      , kaa_profile_t *profile
+                                                      , uint32_t revision);
+
 
 
 /**
@@ -30,6 +30,9 @@ extern "C" {
 #define MAX_MESSAGE_LENGTH       0x0FFFFFFF
 #define PROTOCOL_VERSION         0x01
 
+#define KAA_CONNACK_LENGTH     2
+#define KAA_DISCONNECT_LENGTH  2
+
 #define KAA_SYNC_HEADER_LENGTH 12
 #define KAA_SYNC_ZIPPED_BIT    0x02
 #define KAA_SYNC_ENCRYPTED_BIT 0x04
@@ -26,20 +26,26 @@
 
 
 
-static kaatcp_error_t kaatcp_parser_message_done(kaatcp_parser_t *parser)
+static kaatcp_error_t kaatcp_parser_message_done(kaatcp_parser_t *parser, const char *payload)
 {
     KAA_RETURN_IF_NIL(parser, KAATCP_ERR_BAD_PARAM);
 
     switch (parser->message_type) {
         case KAATCP_MESSAGE_CONNACK:
+            if (parser->message_length < KAA_CONNACK_LENGTH) {
+                return KAATCP_ERR_INVALID_PROTOCOL;
+            }
             if (parser->handlers.connack_handler) {
-                kaatcp_connack_t connack = { *(parser->payload + 1) };
+                kaatcp_connack_t connack = { *(payload + 1) };
                 parser->handlers.connack_handler(parser->handlers.handlers_context, connack);
             }
             break;
         case KAATCP_MESSAGE_DISCONNECT:
+            if (parser->message_length < KAA_DISCONNECT_LENGTH) {
+                return KAATCP_ERR_INVALID_PROTOCOL;
+            }
             if (parser->handlers.disconnect_handler) {
-                kaatcp_disconnect_t disconnect = { *(parser->payload + 1) };
+                kaatcp_disconnect_t disconnect = { *(payload + 1) };
                 parser->handlers.disconnect_handler(parser->handlers.handlers_context, disconnect);
             }
             break;
@@ -51,7 +57,11 @@ static kaatcp_error_t kaatcp_parser_message_done(kaatcp_parser_t *parser)
         case KAATCP_MESSAGE_KAASYNC:
         {
             kaatcp_kaasync_header_t sync_header;
-            const char *cursor = parser->payload;
+            const char *cursor = payload;
+
+            if (parser->message_length < KAA_SYNC_HEADER_LENGTH) {
+                return KAATCP_ERR_INVALID_PROTOCOL;
+            }
 
             sync_header.protocol_name_length = KAA_NTOHS(*((uint16_t *) cursor));
             if (sync_header.protocol_name_length > KAATCP_PROTOCOL_NAME_MAX_SIZE) {
@@ -78,7 +88,14 @@ static kaatcp_error_t kaatcp_parser_message_done(kaatcp_parser_t *parser)
 
             sync_header.flags = *(cursor++);
 
-            if ((sync_header.flags & KAA_SYNC_SYNC_BIT) && parser->handlers.kaasync_handler) {
+            if ((sync_header.flags & KAA_SYNC_SYNC_BIT) && parser->handlers.kaasync_handler && parser->is_zero_copy) {
+                kaatcp_kaasync_t kaasync;
+                kaasync.sync_header = sync_header;
+                kaasync.sync_request_size = parser->message_length - KAA_SYNC_HEADER_LENGTH;
+                kaasync.sync_request = kaasync.sync_request_size ? (char *) cursor : NULL;
+
+                parser->handlers.kaasync_handler(parser->handlers.handlers_context, &kaasync);
+            } else if ((sync_header.flags & KAA_SYNC_SYNC_BIT) && parser->handlers.kaasync_handler) {
                 kaatcp_kaasync_t *kaasync = (kaatcp_kaasync_t *) KAA_MALLOC(sizeof(kaatcp_kaasync_t));
                 KAA_RETURN_IF_NIL(kaasync, KAATCP_ERR_NOMEM);
 
@@ -128,7 +145,7 @@ static kaatcp_error_t kaatcp_parser_process_byte(kaatcp_parser_t *parser, uint8_
                 if (parser->message_length) {
                     parser->state = KAATCP_PARSER_STATE_PROCESSING_PAYLOAD;
                 } else {
-                    return kaatcp_parser_message_done(parser);
+                    return kaatcp_parser_message_done(parser, parser->payload);
                 }
             }
             break;
@@ -139,6 +156,36 @@ static kaatcp_error_t kaatcp_parser_process_byte(kaatcp_parser_t *parser, uint8_
     return KAATCP_ERR_NONE;
 }
 
+/*
+ * Decodes the fixed header of a frame starting at begin. If the whole frame
+ * lies before end, stores its type and length in the parser and returns its
+ * payload, otherwise returns NULL leaving the parser untouched.
+ */
+static const char *kaatcp_parser_frame_payload(kaatcp_parser_t *parser, const char *begin, const char *end)
+{
+    const char *cursor = begin + 1;
+    uint32_t length = 0;
+    uint32_t multiplier = 1;
+    uint8_t byte;
+
+    do {
+        if (cursor == end || (size_t) (cursor - begin) > sizeof(uint32_t)) {
+            return NULL;
+        }
+        byte = *(cursor++);
+        length += (byte & ~FIRST_BIT) * multiplier;
+        multiplier *= FIRST_BIT;
+    } while (byte & FIRST_BIT);
+
+    if ((size_t) (end - cursor) < length) {
+        return NULL;
+    }
+
+    kaatcp_parser_retrieve_message_type(parser, *begin);
+    parser->message_length = length;
+    return cursor;
+}
+
 kaatcp_error_t kaatcp_parser_reset(kaatcp_parser_t *parser)
 {
     KAA_RETURN_IF_NIL(parser, KAATCP_ERR_BAD_PARAM);
@@ -152,6 +199,13 @@ kaatcp_error_t kaatcp_parser_reset(kaatcp_parser_t *parser)
     return KAATCP_ERR_NONE;
 }
 
+kaatcp_error_t kaatcp_parser_set_zero_copy(kaatcp_parser_t *parser, uint8_t enabled)
+{
+    KAA_RETURN_IF_NIL(parser, KAATCP_ERR_BAD_PARAM);
+    parser->is_zero_copy = enabled;
+    return KAATCP_ERR_NONE;
+}
+
 kaatcp_error_t kaatcp_parser_init(kaatcp_parser_t *parser
                                 , const kaatcp_parser_handlers_t *handlers)
 {
@@ -160,6 +214,7 @@ kaatcp_error_t kaatcp_parser_init(kaatcp_parser_t *parser
     kaatcp_error_t rval = kaatcp_parser_reset(parser);
     KAA_RETURN_IF_ERR(rval);
 
+    parser->is_zero_copy = 0;
     parser->handlers = *handlers;
     return rval;
 }
@@ -172,17 +227,31 @@ kaatcp_error_t kaatcp_parser_process_buffer(kaatcp_parser_t *parser, const char
     const char *buf_cursor = buf;
 
     while (buf_cursor != buf + buf_size) {
+        if (parser->is_zero_copy && parser->state == KAATCP_PARSER_STATE_NONE) {
+            const char *payload = kaatcp_parser_frame_payload(parser, buf_cursor, buf + buf_size);
+            if (payload) {
+                buf_cursor = payload + parser->message_length;
+                rval = kaatcp_parser_message_done(parser, payload);
+                KAA_RETURN_IF_ERR(rval);
+                continue;
+            }
+        }
+
         if (parser->state == KAATCP_PARSER_STATE_PROCESSING_PAYLOAD) {
             uint32_t remaining_size = parser->message_length - parser->processed_payload_length;
             uint32_t buffer_remaining_size = buf + buf_size - buf_cursor;
             uint32_t bytes_to_read = (remaining_size > buffer_remaining_size) ? buffer_remaining_size : remaining_size;
 
+            if (parser->processed_payload_length + bytes_to_read > KAATCP_PARSER_MAX_MESSAGE_LENGTH) {
+                return KAATCP_ERR_BUFFER_NOT_ENOUGH;
+            }
+
             memcpy(parser->payload + parser->processed_payload_length, buf_cursor, bytes_to_read);
             parser->processed_payload_length += bytes_to_read;
             buf_cursor += bytes_to_read;
 
             if (parser->message_length == parser->processed_payload_length) {
-                rval = kaatcp_parser_message_done(parser);
+                rval = kaatcp_parser_message_done(parser, parser->payload);
                 KAA_RETURN_IF_ERR(rval);
             }
         } else {
@@ -56,6 +56,7 @@ typedef struct {
     uint32_t                 message_length;
     uint32_t                 processed_payload_length;
     uint32_t                 length_multiplier;
+    uint8_t                  is_zero_copy;
     char                     payload[KAATCP_PARSER_MAX_MESSAGE_LENGTH];
 
     kaatcp_parser_handlers_t handlers;
@@ -68,6 +69,15 @@ kaatcp_error_t kaatcp_parser_init(kaatcp_parser_t *parser
 
 kaatcp_error_t kaatcp_parser_reset(kaatcp_parser_t *parser);
 
+/*
+ * In the zero-copy mode the KAASYNC message passed to the handler is owned by
+ * the parser and valid only during the handler call: it must not be destroyed
+ * with kaatcp_parser_kaasync_destroy(). Its sync request points directly into
+ * the buffer given to kaatcp_parser_process_buffer() when the whole frame is
+ * contained in it, otherwise into the parser's own payload storage.
+ */
+kaatcp_error_t kaatcp_parser_set_zero_copy(kaatcp_parser_t *parser, uint8_t enabled);
+
 kaatcp_error_t kaatcp_parser_process_buffer(kaatcp_parser_t *parser
                                           , const char *buf
                                           , size_t buf_size);
@@ -43,6 +43,29 @@ static uint8_t create_basic_header(uint8_t message_type, size_t length, char *me
     return 0;
 }
 
+static uint8_t get_basic_header_size(size_t length)
+{
+    uint8_t size = 1;
+    do {
+        length /= FIRST_BIT;
+        ++size;
+    } while (length);
+    return size;
+}
+
+size_t kaatcp_get_request_connect_header_size(size_t session_key_size
+                                            , size_t signature_size
+                                            , size_t sync_request_size)
+{
+    size_t header_size = KAA_CONNECT_HEADER_LENGTH + session_key_size + signature_size;
+    return get_basic_header_size(header_size + sync_request_size) + header_size;
+}
+
+size_t kaatcp_get_request_kaasync_header_size(size_t sync_request_size)
+{
+    return get_basic_header_size(sync_request_size + KAA_SYNC_HEADER_LENGTH) + KAA_SYNC_HEADER_LENGTH;
+}
+
 kaatcp_error_t kaatcp_fill_connect_message(uint16_t keepalive, uint32_t next_protocol_id
                                          , char *sync_request, size_t sync_request_size
                                          , char *session_key, size_t session_key_size
@@ -139,7 +162,9 @@ kaatcp_error_t kaatcp_get_request_connect(const kaatcp_connect_t *message
     }
 
     if (message->sync_request) {
-        memcpy(cursor, message->sync_request, message->sync_request_size);
+        if (message->sync_request != cursor) {
+            memmove(cursor, message->sync_request, message->sync_request_size);
+        }
         cursor += message->sync_request_size;
     }
     *buf_size = cursor - buf;
@@ -259,7 +284,9 @@ kaatcp_error_t kaatcp_get_request_kaasync(const kaatcp_kaasync_t *message, char
     KAA_RETURN_IF_ERR(rval);
 
     if (message->sync_request) {
-        memcpy(cursor, message->sync_request, message->sync_request_size);
+        if (message->sync_request != cursor) {
+            memmove(cursor, message->sync_request, message->sync_request_size);
+        }
         cursor += message->sync_request_size;
     }
     *buf_size = cursor - buf;
@@ -31,6 +31,18 @@ kaatcp_error_t kaatcp_fill_connect_message(uint16_t keepalive, uint32_t next_pro
                                          , char *signature, size_t signature_size
                                          , kaatcp_connect_t *message);
 
+/*
+ * Sizes of the frame parts preceding the sync request. A caller may serialize
+ * the sync request right after the reserved header space of the output buffer:
+ * kaatcp_get_request_connect() and kaatcp_get_request_kaasync() then only write
+ * the header in front of it instead of copying the payload.
+ */
+size_t kaatcp_get_request_connect_header_size(size_t session_key_size
+                                            , size_t signature_size
+                                            , size_t sync_request_size);
+
+size_t kaatcp_get_request_kaasync_header_size(size_t sync_request_size);
+
 kaatcp_error_t kaatcp_get_request_connect(const kaatcp_connect_t *message
                                         , char *buf
                                         , size_t *buf_size);
@@ -19,6 +19,7 @@
 #include "platform/stdio.h"
 #include "platform/ext_sha.h"
 #include "platform/ext_status.h"
+#include "platform/time.h"
 #include "kaa_status.h"
 #include "kaa_common.h"
 #include "utilities/kaa_mem.h"
@@ -35,6 +36,18 @@
         memcpy(TO, FROM, SIZE); \
         TO += SIZE;
 
+static void kaa_status_remember_stored(kaa_status_t *self)
+{
+    self->stored.event_seq_n = self->event_seq_n;
+    self->stored.config_seq_n = self->config_seq_n;
+    self->stored.log_bucket_id = self->log_bucket_id;
+    self->stored.is_registered = self->is_registered;
+    self->stored.is_attached = self->is_attached;
+    memcpy(self->stored.endpoint_public_key_hash, self->endpoint_public_key_hash, SHA_1_DIGEST_LENGTH);
+    memcpy(self->stored.profile_hash, self->profile_hash, SHA_1_DIGEST_LENGTH);
+    self->changed_fields = 0;
+}
+
 kaa_error_t kaa_status_create(kaa_status_t ** kaa_status_p)
 {
     KAA_RETURN_IF_NIL(kaa_status_p, KAA_ERR_BADPARAM);
@@ -50,6 +63,8 @@ kaa_error_t kaa_status_create(kaa_status_t ** kaa_status_p)
     memset(kaa_status->endpoint_public_key_hash, 0, SHA_1_DIGEST_LENGTH);
     memset(kaa_status->profile_hash, 0, SHA_1_DIGEST_LENGTH);
     kaa_status->endpoint_access_token = NULL;
+    kaa_status->last_store_time = 0;
+    kaa_status->save_interval = KAA_STATUS_SAVE_INTERVAL;
 
     char *  read_buf = NULL;
     char *  read_buf_head = NULL;
@@ -83,6 +98,9 @@ kaa_error_t kaa_status_create(kaa_status_t ** kaa_status_p)
     if (needs_deallocation)
         KAA_FREE(read_buf_head);
 
+    kaa_status_remember_stored(kaa_status);
+    kaa_status->last_store_time = KAA_TIME();
+
     *kaa_status_p = kaa_status;
     return KAA_ERR_NONE;
 }
@@ -107,12 +125,41 @@ kaa_error_t kaa_status_set_endpoint_access_token(kaa_status_t * self, const char
     if (!self->endpoint_access_token)
         return KAA_ERR_NOMEM;
     strcpy(self->endpoint_access_token, token);
+    self->changed_fields |= KAA_STATUS_FIELD_ACCESS_TOKEN;
     return KAA_ERR_NONE;
 }
 
-kaa_error_t kaa_status_save(kaa_status_t *self)
+uint32_t kaa_status_get_changed_fields(kaa_status_t *self)
+{
+    KAA_RETURN_IF_NIL(self, 0);
+
+    uint32_t changed_fields = self->changed_fields;
+    if (self->stored.is_registered != self->is_registered)
+        changed_fields |= KAA_STATUS_FIELD_REGISTERED;
+    if (self->stored.is_attached != self->is_attached)
+        changed_fields |= KAA_STATUS_FIELD_ATTACHED;
+    if (self->stored.event_seq_n != self->event_seq_n)
+        changed_fields |= KAA_STATUS_FIELD_EVENT_SEQ_N;
+    if (self->stored.config_seq_n != self->config_seq_n)
+        changed_fields |= KAA_STATUS_FIELD_CONFIG_SEQ_N;
+    if (self->stored.log_bucket_id != self->log_bucket_id)
+        changed_fields |= KAA_STATUS_FIELD_LOG_BUCKET_ID;
+    if (memcmp(self->stored.endpoint_public_key_hash, self->endpoint_public_key_hash, SHA_1_DIGEST_LENGTH))
+        changed_fields |= KAA_STATUS_FIELD_EP_KEY_HASH;
+    if (memcmp(self->stored.profile_hash, self->profile_hash, SHA_1_DIGEST_LENGTH))
+        changed_fields |= KAA_STATUS_FIELD_PROFILE_HASH;
+    return changed_fields;
+}
+
+kaa_error_t kaa_status_set_save_interval(kaa_status_t *self, kaa_time_t interval)
 {
     KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    self->save_interval = interval;
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t kaa_status_store(kaa_status_t *self)
+{
 
     size_t endpoint_access_token_length = self->endpoint_access_token ? strlen(self->endpoint_access_token) : 0;
     size_t buffer_size = KAA_STATUS_STATIC_SIZE + sizeof(endpoint_access_token_length) + endpoint_access_token_length;
@@ -138,5 +185,33 @@ kaa_error_t kaa_status_save(kaa_status_t *self)
 
     KAA_FREE(buffer_head);
 
+    kaa_status_remember_stored(self);
+    self->last_store_time = KAA_TIME();
+
     return KAA_ERR_NONE;
 }
+
+kaa_error_t kaa_status_save(kaa_status_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    uint32_t changed_fields = kaa_status_get_changed_fields(self);
+    if (!changed_fields)
+        return KAA_ERR_NONE;
+
+    if (!(changed_fields & ~KAA_STATUS_DEFERRABLE_FIELDS)
+            && (KAA_TIME() - self->last_store_time) < self->save_interval)
+        return KAA_ERR_NONE;
+
+    return kaa_status_store(self);
+}
+
+kaa_error_t kaa_status_flush(kaa_status_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    if (!kaa_status_get_changed_fields(self))
+        return KAA_ERR_NONE;
+
+    return kaa_status_store(self);
+}
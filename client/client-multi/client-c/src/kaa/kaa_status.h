@@ -24,6 +24,33 @@ extern "C" {
 #include "kaa_error.h"
 #include "kaa_common.h"
 #include "platform/ext_sha.h"
+#include "platform/time.h"
+
+/**
+ * Minimal interval (in KAA_TIME() units) between two stores of the status
+ * caused only by sequence number changes. 0 means store on every change.
+ */
+#ifndef KAA_STATUS_SAVE_INTERVAL
+# define KAA_STATUS_SAVE_INTERVAL   0
+#endif
+
+/**
+ * Status fields which may change since the last store.
+ */
+#define KAA_STATUS_FIELD_REGISTERED         0x01
+#define KAA_STATUS_FIELD_ATTACHED           0x02
+#define KAA_STATUS_FIELD_EVENT_SEQ_N        0x04
+#define KAA_STATUS_FIELD_CONFIG_SEQ_N       0x08
+#define KAA_STATUS_FIELD_LOG_BUCKET_ID      0x10
+#define KAA_STATUS_FIELD_EP_KEY_HASH        0x20
+#define KAA_STATUS_FIELD_PROFILE_HASH       0x40
+#define KAA_STATUS_FIELD_ACCESS_TOKEN       0x80
+
+/**
+ * Fields which changes may be coalesced over the save interval.
+ * Changes of any other field are stored immediately.
+ */
+#define KAA_STATUS_DEFERRABLE_FIELDS        (KAA_STATUS_FIELD_EVENT_SEQ_N | KAA_STATUS_FIELD_CONFIG_SEQ_N | KAA_STATUS_FIELD_LOG_BUCKET_ID)
 
 #ifndef KAA_STATUS_T
 # define KAA_STATUS_T
@@ -38,11 +65,51 @@ typedef struct
     kaa_digest      profile_hash;
 
     char *          endpoint_access_token;
+
+    uint32_t        changed_fields;         /*!< Fields explicitly marked as changed since the last store */
+    kaa_time_t      last_store_time;
+    kaa_time_t      save_interval;
+
+    struct {                                /*!< Field values as of the last store */
+        uint32_t    event_seq_n;
+        uint32_t    config_seq_n;
+        uint16_t    log_bucket_id;
+        bool        is_registered;
+        bool        is_attached;
+        kaa_digest  endpoint_public_key_hash;
+        kaa_digest  profile_hash;
+    } stored;
 } kaa_status_t;
 
 #endif
 
 
+/**
+ * @brief Returns the set of KAA_STATUS_FIELD_* which differ from the last stored status.
+ */
+uint32_t kaa_status_get_changed_fields(kaa_status_t *self);
+
+/**
+ * @brief Sets the minimal interval between stores caused by sequence number changes only.
+ *
+ * @param[in]   self        Status instance.
+ * @param[in]   interval    Interval in KAA_TIME() units. 0 disables coalescing.
+ */
+kaa_error_t kaa_status_set_save_interval(kaa_status_t *self, kaa_time_t interval);
+
+/**
+ * @brief Stores the status if any field changed since the last store.
+ *
+ * Changes of sequence numbers only are postponed until the save interval elapses.
+ */
+kaa_error_t kaa_status_save(kaa_status_t *self);
+
+/**
+ * @brief Stores pending status changes regardless of the save interval.
+ */
+kaa_error_t kaa_status_flush(kaa_status_t *self);
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
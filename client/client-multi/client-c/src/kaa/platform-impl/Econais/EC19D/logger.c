@@ -37,11 +37,12 @@ int ext_format_sprintf(char * buffer, size_t buffer_size, const char * format,
         const char * log_level_name, const char * truncated_name, int lineno,
         kaa_error_t error_code)
 {
-    time_t t = ext_get_systime();
+    uint32_t msec = sndc_sys_getTimestamp_msec();
+    time_t t = (time_t) (msec / 1000);
     struct tm* tp = gmtime(&t);
 
     return snprintf(buffer, buffer_size, format, 1900 + tp->tm_year,
-            tp->tm_mon + 1, tp->tm_mday, tp->tm_hour, tp->tm_min, tp->tm_sec,
+            tp->tm_mon + 1, tp->tm_mday, tp->tm_hour, tp->tm_min, tp->tm_sec, (int) (msec % 1000),
             log_level_name, truncated_name, lineno, error_code);
 }
 
@@ -19,18 +19,144 @@
 #include <sndc_crypto_api.h>
 #include "../../../kaa_common.h"
 #include "../../../platform/ext_sha.h"
+#include <string.h>
+
+/*
+ * The SDK crypto API only hashes complete buffers, so the incremental
+ * calculation is done in software.
+ */
+typedef struct {
+    uint32_t    h[5];
+    uint64_t    length;
+    uint8_t     block[64];
+    size_t      block_size;
+} ec19d_sha1_context_t;
+
+typedef char kaa_sha_context_size_check[(sizeof(ec19d_sha1_context_t) <= KAA_SHA_CONTEXT_SIZE) ? 1 : -1];
+
+#define SHA1_ROTL(X, N) (((X) << (N)) | ((X) >> (32 - (N))))
 
 
 
 kaa_error_t ext_calculate_sha_hash(const char *data, size_t data_size, kaa_digest digest)
 {
-    KAA_RETURN_IF_NIL(digest, KAA_ERR_BADPARAM);
+    KAA_RETURN_IF_NIL3(data, data_size, digest, KAA_ERR_BADPARAM);
 
     sndc_crypto_sha1(1, (uint8_t **)&data, &data_size, digest);
 
     return KAA_ERR_NONE;
 }
 
+static void ec19d_sha1_process_block(ec19d_sha1_context_t *ctx, const uint8_t *block)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = ((uint32_t) block[i * 4] << 24) | ((uint32_t) block[i * 4 + 1] << 16)
+             | ((uint32_t) block[i * 4 + 2] << 8) | (uint32_t) block[i * 4 + 3];
+    }
+    for (int i = 16; i < 80; ++i) {
+        w[i] = SHA1_ROTL(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = ctx->h[0], b = ctx->h[1], c = ctx->h[2], d = ctx->h[3], e = ctx->h[4];
+    for (int i = 0; i < 80; ++i) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t temp = SHA1_ROTL(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = SHA1_ROTL(b, 30);
+        b = a;
+        a = temp;
+    }
+
+    ctx->h[0] += a;
+    ctx->h[1] += b;
+    ctx->h[2] += c;
+    ctx->h[3] += d;
+    ctx->h[4] += e;
+}
+
+kaa_error_t ext_sha_hash_init(kaa_sha_context_t *context)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+
+    ec19d_sha1_context_t *ctx = (ec19d_sha1_context_t *) context->state;
+    ctx->h[0] = 0x67452301;
+    ctx->h[1] = 0xEFCDAB89;
+    ctx->h[2] = 0x98BADCFE;
+    ctx->h[3] = 0x10325476;
+    ctx->h[4] = 0xC3D2E1F0;
+    ctx->length = 0;
+    ctx->block_size = 0;
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t ext_sha_hash_update(kaa_sha_context_t *context, const char *data, size_t data_size)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    if (!data_size)
+        return KAA_ERR_NONE;
+    KAA_RETURN_IF_NIL(data, KAA_ERR_BADPARAM);
+
+    ec19d_sha1_context_t *ctx = (ec19d_sha1_context_t *) context->state;
+    ctx->length += data_size;
+    while (data_size) {
+        size_t chunk = sizeof(ctx->block) - ctx->block_size;
+        if (chunk > data_size)
+            chunk = data_size;
+        memcpy(ctx->block + ctx->block_size, data, chunk);
+        ctx->block_size += chunk;
+        data += chunk;
+        data_size -= chunk;
+        if (ctx->block_size == sizeof(ctx->block)) {
+            ec19d_sha1_process_block(ctx, ctx->block);
+            ctx->block_size = 0;
+        }
+    }
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t ext_sha_hash_final(kaa_sha_context_t *context, kaa_digest digest)
+{
+    KAA_RETURN_IF_NIL2(context, digest, KAA_ERR_BADPARAM);
+
+    ec19d_sha1_context_t *ctx = (ec19d_sha1_context_t *) context->state;
+    uint64_t bit_length = ctx->length * 8;
+
+    ctx->block[ctx->block_size++] = 0x80;
+    if (ctx->block_size > sizeof(ctx->block) - sizeof(bit_length)) {
+        memset(ctx->block + ctx->block_size, 0, sizeof(ctx->block) - ctx->block_size);
+        ec19d_sha1_process_block(ctx, ctx->block);
+        ctx->block_size = 0;
+    }
+    memset(ctx->block + ctx->block_size, 0, sizeof(ctx->block) - sizeof(bit_length) - ctx->block_size);
+    for (int i = 0; i < 8; ++i) {
+        ctx->block[sizeof(ctx->block) - 1 - i] = (uint8_t) (bit_length >> (i * 8));
+    }
+    ec19d_sha1_process_block(ctx, ctx->block);
+
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4]     = (unsigned char) (ctx->h[i] >> 24);
+        digest[i * 4 + 1] = (unsigned char) (ctx->h[i] >> 16);
+        digest[i * 4 + 2] = (unsigned char) (ctx->h[i] >> 8);
+        digest[i * 4 + 3] = (unsigned char) ctx->h[i];
+    }
+    return KAA_ERR_NONE;
+}
+
 kaa_error_t ext_copy_sha_hash(kaa_digest_p dst, const kaa_digest_p src)
 {
     KAA_RETURN_IF_NIL2(dst, src, KAA_ERR_BADPARAM);
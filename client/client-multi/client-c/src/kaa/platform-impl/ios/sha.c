@@ -25,12 +25,41 @@
 
 kaa_error_t ext_calculate_sha_hash(const char *data, size_t data_size, kaa_digest digest)
 {
-    KAA_RETURN_IF_NIL(digest, KAA_ERR_BADPARAM);
+    KAA_RETURN_IF_NIL3(data, data_size, digest, KAA_ERR_BADPARAM);
 
     CC_SHA1((const unsigned char *)data, data_size, digest);
     return KAA_ERR_NONE;
 }
 
+typedef char kaa_sha_context_size_check[(sizeof(CC_SHA1_CTX) <= KAA_SHA_CONTEXT_SIZE) ? 1 : -1];
+
+kaa_error_t ext_sha_hash_init(kaa_sha_context_t *context)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+
+    CC_SHA1_Init((CC_SHA1_CTX *)context->state);
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t ext_sha_hash_update(kaa_sha_context_t *context, const char *data, size_t data_size)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    if (!data_size)
+        return KAA_ERR_NONE;
+    KAA_RETURN_IF_NIL(data, KAA_ERR_BADPARAM);
+
+    CC_SHA1_Update((CC_SHA1_CTX *)context->state, data, data_size);
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t ext_sha_hash_final(kaa_sha_context_t *context, kaa_digest digest)
+{
+    KAA_RETURN_IF_NIL2(context, digest, KAA_ERR_BADPARAM);
+
+    CC_SHA1_Final(digest, (CC_SHA1_CTX *)context->state);
+    return KAA_ERR_NONE;
+}
+
 kaa_error_t ext_copy_sha_hash(kaa_digest_p dst, const kaa_digest_p src)
 {
     KAA_RETURN_IF_NIL2(dst, src, KAA_ERR_BADPARAM);
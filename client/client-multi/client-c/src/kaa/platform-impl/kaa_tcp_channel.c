@@ -32,6 +32,10 @@
 #include "../kaa_platform_common.h"
 #include "kaa_tcp_channel.h"
 
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+#include "../kaa_event.h"
+#endif
+
 
 
 #define KAA_TCP_CHANNEL_IN_BUFFER_SIZE     1024
@@ -83,7 +87,13 @@ typedef struct {
 
 typedef struct {
     uint16_t      keepalive_interval;
-    kaa_time_t    last_sent_keepalive;
+    uint16_t      ping_interval;            /* Idle time before PING, adapted within the bounds below */
+    uint16_t      min_ping_interval;
+    uint16_t      max_ping_interval;
+    uint16_t      failed_ping_interval;     /* Smallest idle time the connection did not survive, 0 if unknown */
+    bool          is_ping_pending;
+    kaa_time_t    last_ping_time;
+    kaa_time_t    last_sent_keepalive;      /* Last time anything was written to the socket */
     kaa_time_t    last_receive_keepalive;
 } kaa_tcp_keepalive_t ;
 
@@ -111,9 +121,13 @@ typedef struct {
     kaa_buffer_t                   *in_buffer;
     kaa_buffer_t                   *out_buffer;
     kaatcp_parser_t                *parser;
+    kaatcp_message_type_t          out_message_type;    /* Frame being serialized in place into out_buffer */
     uint16_t                       message_id;
     kaa_tcp_keepalive_t            keepalive;
     kaa_tcp_encrypt_t              encryption;
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    kaa_event_manager_t            *event_manager;      /* Its batched events deadline bounds the max timeout */
+#endif
 } kaa_tcp_channel_t;
 
 
@@ -151,6 +165,8 @@ static kaa_error_t kaa_tcp_write_buffer(kaa_tcp_channel_t *self);
 static char* kaa_tcp_write_pending_services_allocator_fn(void *context, size_t buffer_size);
 static kaa_error_t kaa_tcp_channel_ping(kaa_tcp_channel_t *self);
 static kaa_error_t kaa_tcp_channel_disconnect_internal(kaa_tcp_channel_t *self, kaatcp_disconnect_reason_t return_code);
+static void kaa_tcp_channel_reset_ping_interval(kaa_tcp_keepalive_t *keepalive);
+static void kaa_tcp_channel_on_ping_result(kaa_tcp_channel_t *self, bool is_succeeded);
 
 
 
@@ -241,6 +257,7 @@ kaa_error_t kaa_tcp_channel_create(kaa_transport_channel_interface_t *self
      * Initializes keepalive configuration.
      */
     kaa_tcp_channel->keepalive.keepalive_interval = KAA_TCP_CHANNEL_KEEPALIVE;
+    kaa_tcp_channel_reset_ping_interval(&kaa_tcp_channel->keepalive);
     kaa_tcp_channel->keepalive.last_sent_keepalive = KAA_TIME();
     kaa_tcp_channel->keepalive.last_receive_keepalive = kaa_tcp_channel->keepalive.last_sent_keepalive;
 
@@ -275,6 +292,8 @@ kaa_error_t kaa_tcp_channel_create(kaa_transport_channel_interface_t *self
     parser_handler.handlers_context   = (void *) kaa_tcp_channel;
 
     kaatcp_error_t parser_error_code = kaatcp_parser_init(kaa_tcp_channel->parser, &parser_handler);
+    if (!parser_error_code)
+        parser_error_code = kaatcp_parser_set_zero_copy(kaa_tcp_channel->parser, true);
     if (parser_error_code) {
         KAA_LOG_ERROR(logger, KAA_ERR_TCPCHANNEL_PARSER_INIT_FAILED, "Failed to initialize Kaa TCP parser (error_code %d)", parser_error_code);
         kaa_tcp_channel_destroy_context(kaa_tcp_channel);
@@ -799,7 +818,28 @@ kaa_error_t kaa_tcp_channel_get_max_timeout(kaa_transport_channel_interface_t *s
     KAA_RETURN_IF_NIL3(self, self->context, max_timeout, KAA_ERR_BADPARAM);
 
     kaa_tcp_channel_t *tcp_channel = (kaa_tcp_channel_t *) self->context;
-    *max_timeout = tcp_channel->keepalive.keepalive_interval / 2;
+    kaa_tcp_keepalive_t *keepalive = &tcp_channel->keepalive;
+    kaa_time_t now = KAA_TIME();
+
+    if (!keepalive->keepalive_interval || tcp_channel->channel_state != KAA_TCP_CHANNEL_AUTHORIZED) {
+        *max_timeout = keepalive->ping_interval;
+    } else {
+        kaa_time_t deadline = (keepalive->is_ping_pending ? keepalive->last_ping_time : keepalive->last_sent_keepalive)
+                            + keepalive->ping_interval;
+        *max_timeout = (deadline > now) ? (uint16_t) (deadline - now) : 1;
+    }
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    kaa_time_t events_deadline;
+    if (tcp_channel->event_manager
+            && !kaa_event_manager_get_next_timeout(tcp_channel->event_manager, &events_deadline)) {
+        uint16_t events_timeout = 1;
+        if (events_deadline > now)
+            events_timeout = (events_deadline - now < UINT16_MAX) ? (uint16_t) (events_deadline - now) : UINT16_MAX;
+        if (!*max_timeout || events_timeout < *max_timeout)
+            *max_timeout = events_timeout;
+    }
+#endif
 
     return KAA_ERR_NONE;
 }
@@ -813,6 +853,11 @@ kaa_error_t kaa_tcp_channel_check_keepalive(kaa_transport_channel_interface_t *s
     kaa_error_t error_code = KAA_ERR_NONE;
     kaa_tcp_channel_t *tcp_channel = (kaa_tcp_channel_t *) self->context;
 
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    if (tcp_channel->event_manager)
+        kaa_event_manager_check_timeouts(tcp_channel->event_manager);
+#endif
+
     if (tcp_channel->access_point.state == AP_SET) {
         kaa_dns_resolve_listener_t resolve_listener;
         resolve_listener.context = (void *) tcp_channel;
@@ -876,10 +921,16 @@ kaa_error_t kaa_tcp_channel_check_keepalive(kaa_transport_channel_interface_t *s
             return error_code;
         }
 
-        kaa_time_t interval = KAA_TIME() - tcp_channel->keepalive.last_sent_keepalive;
+        kaa_time_t now = KAA_TIME();
 
-        if (interval >= (tcp_channel->keepalive.keepalive_interval / 2)) {
-            //Send ping request
+        if (tcp_channel->keepalive.is_ping_pending) {
+            if (now - tcp_channel->keepalive.last_ping_time >= tcp_channel->keepalive.ping_interval) {
+                KAA_LOG_WARN(tcp_channel->logger, KAA_ERR_TIMEOUT, "Kaa TCP channel [0x%08X] PING response was not received in %u seconds"
+                                                        , tcp_channel->access_point.id, tcp_channel->keepalive.ping_interval);
+                error_code = kaa_tcp_channel_socket_io_error(tcp_channel);
+            }
+        } else if (now - tcp_channel->keepalive.last_sent_keepalive >= tcp_channel->keepalive.ping_interval) {
+            //Send ping request only if nothing else was sent during the ping interval
 
             error_code = kaa_tcp_channel_ping(tcp_channel);
         }
@@ -919,6 +970,7 @@ kaa_error_t kaa_tcp_channel_set_keepalive_timeout(kaa_transport_channel_interfac
     kaa_tcp_channel_t *tcp_channel = (kaa_tcp_channel_t *)self->context;
 
     tcp_channel->keepalive.keepalive_interval = keepalive;
+    kaa_tcp_channel_reset_ping_interval(&tcp_channel->keepalive);
 
     KAA_LOG_INFO(tcp_channel->logger,KAA_ERR_NONE,"Kaa TCP channel [0x%08X] keepalive is set to %u seconds"
                                     , tcp_channel->access_point.id, tcp_channel->keepalive.keepalive_interval);
@@ -928,6 +980,100 @@ kaa_error_t kaa_tcp_channel_set_keepalive_timeout(kaa_transport_channel_interfac
 
 
 
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+kaa_error_t kaa_tcp_channel_set_event_manager(kaa_transport_channel_interface_t *self
+                                            , kaa_event_manager_t *event_manager)
+{
+    KAA_RETURN_IF_NIL2(self, self->context, KAA_ERR_BADPARAM);
+    kaa_tcp_channel_t *tcp_channel = (kaa_tcp_channel_t *)self->context;
+
+    tcp_channel->event_manager = event_manager;
+    return KAA_ERR_NONE;
+}
+#endif
+
+
+
+kaa_error_t kaa_tcp_channel_set_keepalive_bounds(kaa_transport_channel_interface_t *self
+                                               , uint16_t min_interval
+                                               , uint16_t max_interval)
+{
+    KAA_RETURN_IF_NIL2(self, self->context, KAA_ERR_BADPARAM);
+    kaa_tcp_channel_t *tcp_channel = (kaa_tcp_channel_t *)self->context;
+    kaa_tcp_keepalive_t *keepalive = &tcp_channel->keepalive;
+
+    if (!min_interval || min_interval > max_interval || max_interval > keepalive->keepalive_interval)
+        return KAA_ERR_BADPARAM;
+
+    keepalive->min_ping_interval = min_interval;
+    keepalive->max_ping_interval = max_interval;
+    keepalive->failed_ping_interval = 0;
+    if (keepalive->ping_interval < min_interval)
+        keepalive->ping_interval = min_interval;
+    if (keepalive->ping_interval > max_interval)
+        keepalive->ping_interval = max_interval;
+
+    KAA_LOG_INFO(tcp_channel->logger, KAA_ERR_NONE, "Kaa TCP channel [0x%08X] ping interval bounds are set to [%u, %u] seconds"
+                                    , tcp_channel->access_point.id, min_interval, max_interval);
+
+    return KAA_ERR_NONE;
+}
+
+
+
+static void kaa_tcp_channel_reset_ping_interval(kaa_tcp_keepalive_t *keepalive)
+{
+    keepalive->ping_interval = keepalive->keepalive_interval / 2;
+    keepalive->min_ping_interval = keepalive->ping_interval;
+    keepalive->max_ping_interval = keepalive->ping_interval;
+    keepalive->failed_ping_interval = 0;
+    keepalive->is_ping_pending = false;
+}
+
+
+
+/*
+ * Adapts the ping interval to the observed NAT/firewall idle timeout:
+ * a connection lost while waiting for PINGRESP halves the interval, each
+ * PINGRESP after a full idle interval increases it by 1/8, staying below
+ * the interval which already failed.
+ */
+static void kaa_tcp_channel_on_ping_result(kaa_tcp_channel_t *self, bool is_succeeded)
+{
+    kaa_tcp_keepalive_t *keepalive = &self->keepalive;
+    if (!keepalive->is_ping_pending)
+        return;
+    keepalive->is_ping_pending = false;
+
+    uint16_t interval = keepalive->ping_interval;
+    if (is_succeeded) {
+        uint16_t upper = keepalive->max_ping_interval;
+        if (keepalive->failed_ping_interval) {
+            uint16_t safe = keepalive->failed_ping_interval - keepalive->failed_ping_interval / 4;
+            if (safe < upper)
+                upper = safe;
+        }
+        uint16_t step = interval / 8 ? interval / 8 : 1;
+        if (interval < upper)
+            interval = (upper - interval > step) ? interval + step : upper;
+    } else {
+        if (!keepalive->failed_ping_interval || interval < keepalive->failed_ping_interval)
+            keepalive->failed_ping_interval = interval;
+        interval /= 2;
+    }
+
+    if (interval < keepalive->min_ping_interval)
+        interval = keepalive->min_ping_interval;
+
+    if (interval != keepalive->ping_interval) {
+        KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "Kaa TCP channel [0x%08X] ping interval changed from %u to %u seconds"
+                                                , self->access_point.id, keepalive->ping_interval, interval);
+        keepalive->ping_interval = interval;
+    }
+}
+
+
+
 kaa_error_t kaa_tcp_channel_disconnect(kaa_transport_channel_interface_t  *self)
 {
     KAA_RETURN_IF_NIL2(self, self->context, KAA_ERR_BADPARAM);
@@ -950,6 +1096,7 @@ void kaa_tcp_channel_connack_message_callback(void *context, kaatcp_connack_t me
             if (channel->keepalive.keepalive_interval > 0) {
                 channel->keepalive.last_receive_keepalive = KAA_TIME();
                 channel->keepalive.last_sent_keepalive = channel->keepalive.last_receive_keepalive;
+                channel->keepalive.is_ping_pending = false;
             }
 
         } else {
@@ -1005,8 +1152,6 @@ void kaa_tcp_channel_kaasync_message_callback(void *context, kaatcp_kaasync_t *m
                                                                                         , channel->access_point.id, zipped, encrypted);
     }
 
-    kaatcp_parser_kaasync_destroy(message);
-
     //Check if service supports only bootstrap, after sync it disconnects.
     if (channel->channel_operation_type == KAA_SERVER_BOOTSTRAP) {
         channel->sync_state = KAA_TCP_CHANNEL_SYNC_OP_FINISHED;
@@ -1022,6 +1167,7 @@ void kaa_tcp_channel_pingresp_message_callback(void *context)
     kaa_tcp_channel_t *channel = (kaa_tcp_channel_t *)context;
 
     channel->keepalive.last_receive_keepalive = KAA_TIME();
+    kaa_tcp_channel_on_ping_result(channel, true);
 
     KAA_LOG_INFO(channel->logger, KAA_ERR_NONE, "Kaa TCP channel [0x%08X] PING message received"
                                                                     , channel->access_point.id);
@@ -1039,6 +1185,8 @@ kaa_error_t kaa_tcp_channel_socket_io_error(kaa_tcp_channel_t *self)
     KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "Kaa TCP channel [0x%08X] closing socket"
                                                                 , self->access_point.id);
 
+    kaa_tcp_channel_on_ping_result(self, false);
+
     kaa_error_t error_code = KAA_ERR_NONE;
 
     self->access_point.state = AP_RESOLVED;
@@ -1091,11 +1239,6 @@ kaa_error_t kaa_tcp_channel_authorize(kaa_tcp_channel_t *self)
 
     kaa_error_t error_code = KAA_ERR_NONE;
 
-    char *buffer = NULL;
-    size_t buffer_size = 0;
-    error_code = kaa_buffer_allocate_space(self->out_buffer, &buffer, &buffer_size);
-    KAA_RETURN_IF_ERR(error_code);
-
     kaa_serialize_info_t serialize_info;
     serialize_info.services = self->supported_services;
     serialize_info.services_count = self->supported_service_count;
@@ -1105,6 +1248,7 @@ kaa_error_t kaa_tcp_channel_authorize(kaa_tcp_channel_t *self)
     char *sync_buffer = NULL;
     size_t sync_size = 0;
 
+    self->out_message_type = KAATCP_MESSAGE_CONNECT;
     error_code = kaa_platform_protocol_serialize_client_sync(self->transport_context.platform_protocol
                                                            , &serialize_info
                                                            , &sync_buffer
@@ -1127,13 +1271,9 @@ kaa_error_t kaa_tcp_channel_authorize(kaa_tcp_channel_t *self)
 
         KAA_LOG_ERROR(self->logger, error_code, "Kaa TCP channel [0x%08X] failed to serialize supported services",
                                                                                             self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return error_code;
     }
 
-
-
     kaatcp_connect_t connect_message;
     kaatcp_error_t kaatcp_error_code =
             kaatcp_fill_connect_message(1.2 * self->keepalive.keepalive_interval
@@ -1149,18 +1289,23 @@ kaa_error_t kaa_tcp_channel_authorize(kaa_tcp_channel_t *self)
     if (kaatcp_error_code) {
         KAA_LOG_ERROR(self->logger, KAA_ERR_TCPCHANNEL_PARSER_ERROR, "Kaa TCP channel [0x%08X] failed to fill CONNECT message",
                                                                                                             self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return KAA_ERR_TCPCHANNEL_PARSER_ERROR;
     }
 
+    /*
+     * The sync request was serialized in place after the space reserved for the CONNECT header,
+     * so only the header is written here.
+     */
+    char *buffer = NULL;
+    size_t buffer_size = 0;
+    error_code = kaa_buffer_allocate_space(self->out_buffer, &buffer, &buffer_size);
+    KAA_RETURN_IF_ERR(error_code);
+
     kaatcp_error_code = kaatcp_get_request_connect(&connect_message, buffer, &buffer_size);
 
     if (kaatcp_error_code) {
         KAA_LOG_ERROR(self->logger, KAA_ERR_TCPCHANNEL_PARSER_ERROR, "Kaa TCP channel [0x%08X] failed to get serialize CONNECT message",
                                                                                                                     self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return KAA_ERR_TCPCHANNEL_PARSER_ERROR;
     }
 
@@ -1168,12 +1313,6 @@ kaa_error_t kaa_tcp_channel_authorize(kaa_tcp_channel_t *self)
                                                                         , self->access_point.id, buffer_size);
 
     error_code = kaa_buffer_lock_space(self->out_buffer, buffer_size);
-
-    if (sync_buffer) {
-        KAA_FREE(sync_buffer);
-        sync_buffer = NULL;
-    }
-
     KAA_RETURN_IF_ERR(error_code);
 
     self->channel_state = KAA_TCP_CHANNEL_AUTHORIZING;
@@ -1459,11 +1598,6 @@ kaa_error_t kaa_tcp_channel_write_pending_services(kaa_tcp_channel_t *self
 
     KAA_RETURN_IF_NIL2(service, services_count, KAA_ERR_NONE);
 
-    char *buffer = NULL;
-    size_t buffer_size = 0;
-    kaa_error_t error_code = kaa_buffer_allocate_space(self->out_buffer, &buffer, &buffer_size);
-    KAA_RETURN_IF_ERR(error_code);
-
     kaa_serialize_info_t serialize_info;
     serialize_info.services = service;
     serialize_info.services_count = services_count;
@@ -1473,10 +1607,11 @@ kaa_error_t kaa_tcp_channel_write_pending_services(kaa_tcp_channel_t *self
     char *sync_buffer = NULL;
     size_t sync_size = 0;
 
-    error_code = kaa_platform_protocol_serialize_client_sync(self->transport_context.platform_protocol
-                                                           , &serialize_info
-                                                           , &sync_buffer
-                                                           , &sync_size);
+    self->out_message_type = KAATCP_MESSAGE_KAASYNC;
+    kaa_error_t error_code = kaa_platform_protocol_serialize_client_sync(self->transport_context.platform_protocol
+                                                                       , &serialize_info
+                                                                       , &sync_buffer
+                                                                       , &sync_size);
 
     KAA_LOG_TRACE(self->logger, KAA_ERR_NONE, "Kaa TCP channel [0x%08X] serialized client sync (%zu bytes)"
                                                                         , self->access_point.id, sync_size);
@@ -1486,8 +1621,6 @@ kaa_error_t kaa_tcp_channel_write_pending_services(kaa_tcp_channel_t *self
     if (error_code) {
         KAA_LOG_ERROR(self->logger, error_code, "Kaa TCP channel [0x%08X] failed to serialize client sync"
                                                                                     , self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return error_code;
     }
 
@@ -1506,17 +1639,21 @@ kaa_error_t kaa_tcp_channel_write_pending_services(kaa_tcp_channel_t *self
     if (parser_error_code) {
         KAA_LOG_ERROR(self->logger, KAA_ERR_TCPCHANNEL_PARSER_ERROR, "Kaa TCP channel [0x%08X] failed to fill KAASYNC message"
                                                                                                         , self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return KAA_ERR_TCPCHANNEL_PARSER_ERROR;
     }
 
+    /*
+     * The sync request was serialized in place after the space reserved for the KAASYNC header.
+     */
+    char *buffer = NULL;
+    size_t buffer_size = 0;
+    error_code = kaa_buffer_allocate_space(self->out_buffer, &buffer, &buffer_size);
+    KAA_RETURN_IF_ERR(error_code);
+
     parser_error_code = kaatcp_get_request_kaasync(&kaa_sync_message, buffer, &buffer_size);
     if (parser_error_code) {
         KAA_LOG_ERROR(self->logger, KAA_ERR_TCPCHANNEL_PARSER_ERROR, "Kaa TCP channel [0x%08X] failed to serialize KAASYNC message"
                                                                                                                 , self->access_point.id);
-        if (sync_buffer)
-            KAA_FREE(sync_buffer);
         return KAA_ERR_TCPCHANNEL_PARSER_ERROR;
     }
 
@@ -1524,11 +1661,6 @@ kaa_error_t kaa_tcp_channel_write_pending_services(kaa_tcp_channel_t *self
                                                                                 , self->access_point.id, sync_size);
 
     error_code = kaa_buffer_lock_space(self->out_buffer, buffer_size);
-
-    if (sync_buffer) {
-        KAA_FREE(sync_buffer);
-        sync_buffer = NULL;
-    }
     KAA_RETURN_IF_ERR(error_code);
 
     error_code = kaa_tcp_write_buffer(self);
@@ -1559,6 +1691,8 @@ kaa_error_t kaa_tcp_write_buffer(kaa_tcp_channel_t *self)
                                              , &bytes_written);
         switch (io_error) {
             case KAA_TCP_SOCK_IO_OK:
+                if (bytes_written > 0)
+                    self->keepalive.last_sent_keepalive = KAA_TIME();
                 error_code = kaa_buffer_free_allocated_space(self->out_buffer, bytes_written);
                 KAA_LOG_TRACE(self->logger, error_code, "Kaa TCP channel [0x%08X] %zu bytes were successfully written"
                                                                                 , self->access_point.id, bytes_written);
@@ -1578,12 +1712,34 @@ kaa_error_t kaa_tcp_write_buffer(kaa_tcp_channel_t *self)
 
 /*
  * Memory allocator for kaa_platform_protocol_serialize_client_sync() method.
+ * Returns the space in out_buffer right after the header of the frame being built,
+ * so the sync request is serialized directly into its final position.
  */
 char *kaa_tcp_write_pending_services_allocator_fn(void *context, size_t buffer_size)
 {
     KAA_RETURN_IF_NIL2(context, buffer_size, NULL);
-    char *buffer = (char *) KAA_MALLOC(buffer_size);
-    return buffer;
+    kaa_tcp_channel_t *channel = (kaa_tcp_channel_t *) context;
+
+    size_t header_size = 0;
+    if (channel->out_message_type == KAATCP_MESSAGE_CONNECT) {
+        header_size = kaatcp_get_request_connect_header_size(
+                channel->encryption.aes_session_key ? channel->encryption.aes_session_key_size : 0
+              , channel->encryption.signature ? channel->encryption.signature_size : 0
+              , buffer_size);
+    } else {
+        header_size = kaatcp_get_request_kaasync_header_size(buffer_size);
+    }
+
+    char *buffer = NULL;
+    size_t free_size = 0;
+    kaa_error_t error_code = kaa_buffer_allocate_space(channel->out_buffer, &buffer, &free_size);
+    if (error_code || free_size < header_size + buffer_size) {
+        KAA_LOG_ERROR(channel->logger, KAA_ERR_BUFFER_IS_NOT_ENOUGH, "Kaa TCP channel [0x%08X] not enough space "
+                "in the output buffer for %zu bytes", channel->access_point.id, header_size + buffer_size);
+        return NULL;
+    }
+
+    return buffer + header_size;
 }
 
 
@@ -1611,6 +1767,8 @@ kaa_error_t kaa_tcp_channel_ping(kaa_tcp_channel_t * self)
     error_code = kaa_buffer_lock_space(self->out_buffer, buffer_size);
 
     self->keepalive.last_sent_keepalive = KAA_TIME();
+    self->keepalive.last_ping_time = self->keepalive.last_sent_keepalive;
+    self->keepalive.is_ping_pending = true;
 
     KAA_LOG_INFO(self->logger,KAA_ERR_NONE,"Kaa TCP channel [0x%08X] going to send PING message (%zu bytes)"
                                                                         , self->access_point.id, buffer_size);
@@ -27,6 +27,11 @@
 extern "C" {
 #endif
 
+#ifndef KAA_EVENT_MANAGER_T
+# define KAA_EVENT_MANAGER_T
+    typedef struct kaa_event_manager_t      kaa_event_manager_t;
+#endif
+
 
 typedef enum {
     FD_READ,
@@ -117,6 +122,10 @@ kaa_error_t kaa_tcp_channel_process_event(kaa_transport_channel_interface_t *sel
  * @brief Retrieves the maximum timeout for the multiplexing I/O like select/poll.
  * Used for @link kaa_tcp_channel_check_keepalive @endlink needs.
  *
+ * Once the channel is authorized, the timeout is the time left until the next
+ * keepalive is due, which is postponed by any other data sent to the server.
+ * If the event manager is set, the timeout doesn't exceed the deadline of its batched events.
+ *
  * @param[in]   channel        The channel instance.
  * @param[out]  max_timeout    The maximum timeout value (in seconds),
  *                             0 - indicates that timeout is not used by this channel.
@@ -129,7 +138,8 @@ kaa_error_t kaa_tcp_channel_get_max_timeout(kaa_transport_channel_interface_t *s
 
 /**
  * @brief Checks whether a keepalive timeout occurred. If so, sends a
- * keepalive message to the server.
+ * keepalive message to the server. Also sends batched events of the event manager
+ * (if set) once their deadline has passed.
  *
  * Should be called if the multiplexing I/O (like select/poll) time limit expires.
  *
@@ -169,6 +179,42 @@ kaa_error_t kaa_tcp_channel_set_keepalive_timeout(kaa_transport_channel_interfac
                                                 , uint16_t keepalive);
 
 
+/**
+ * @brief Sets the bounds for the adaptive keepalive (PING) interval.
+ *
+ * The channel pings the server only after it sent nothing for the current interval.
+ * The interval is halved when the connection is lost while a PING is pending and
+ * grows slowly after successful PINGs, staying within the given bounds.
+ * By default both bounds are half of the keepalive timeout, i.e. the interval is fixed.
+ * Reset by @link kaa_tcp_channel_set_keepalive_timeout @endlink .
+ *
+ * @param[in]    channel         The channel instance.
+ * @param[in]    min_interval    The minimal interval (in seconds), greater than 0.
+ * @param[in]    max_interval    The maximal interval (in seconds), not greater than the keepalive timeout.
+ *
+ * @return Error code
+ */
+kaa_error_t kaa_tcp_channel_set_keepalive_bounds(kaa_transport_channel_interface_t *self
+                                               , uint16_t min_interval
+                                               , uint16_t max_interval);
+
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+/**
+ * @brief Sets the event manager whose batched events deadline is served by the channel.
+ *
+ * See @link kaa_tcp_channel_get_max_timeout @endlink and @link kaa_tcp_channel_check_keepalive @endlink .
+ *
+ * @param[in]    channel          The channel instance.
+ * @param[in]    event_manager    The event manager, @c NULL to stop serving its deadline.
+ *
+ * @return Error code
+ */
+kaa_error_t kaa_tcp_channel_set_event_manager(kaa_transport_channel_interface_t *self
+                                            , kaa_event_manager_t *event_manager);
+#endif
+
+
 /**
  * @brief Disconnects the current channel.
  *
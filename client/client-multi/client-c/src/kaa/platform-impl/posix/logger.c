@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <time.h>
 #include <stdarg.h>
+#include <sys/time.h>
 #include "../../platform/ext_system_logger.h"
 
 
@@ -39,11 +40,13 @@ int ext_format_sprintf(char * buffer, size_t buffer_size, const char * format,
         const char * log_level_name, const char * truncated_name, int lineno,
         kaa_error_t error_code)
 {
-    time_t t = ext_get_systime();
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    time_t t = tv.tv_sec;
     struct tm* tp = gmtime(&t);
 
     return snprintf(buffer, buffer_size, format, 1900 + tp->tm_year,
-            tp->tm_mon + 1, tp->tm_mday, tp->tm_hour, tp->tm_min, tp->tm_sec,
+            tp->tm_mon + 1, tp->tm_mday, tp->tm_hour, tp->tm_min, tp->tm_sec, (int) (tv.tv_usec / 1000),
             log_level_name, truncated_name, lineno, error_code);
 }
 
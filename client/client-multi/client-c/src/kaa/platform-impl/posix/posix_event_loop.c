@@ -0,0 +1,570 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+#include "posix_event_loop.h"
+#include "../kaa_tcp_channel.h"
+#include "../../kaa_common.h"
+#include "../../platform/time.h"
+#include "../../collections/kaa_list.h"
+#include "../../utilities/kaa_mem.h"
+#include "../../utilities/kaa_log.h"
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+#include "../../kaa_logging.h"
+#endif
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+#include "../../kaa_event.h"
+#endif
+
+
+
+typedef struct {
+    kaa_transport_channel_interface_t  *channel;
+    kaa_fd_t                            fd;                 /**< Registered descriptor, KAA_TCP_SOCKET_NOT_SET if none */
+    bool                                wants_read;         /**< Registered interest */
+    bool                                wants_write;
+    uint64_t                            next_keepalive_check;
+} posix_event_loop_channel_t;
+
+typedef struct {
+    uint32_t                    id;
+    uint32_t                    interval;
+    bool                        repeat;
+    bool                        is_removed;
+    uint64_t                    deadline;
+    posix_event_loop_timer_fn   callback;
+    void                       *context;
+} posix_event_loop_timer_t;
+
+struct posix_event_loop_t {
+    posix_event_loop_channel_t  channels[POSIX_EVENT_LOOP_MAX_CHANNELS];
+    size_t                      channels_count;
+    kaa_list_t                 *timers;             /**< List of @link posix_event_loop_timer_t @endlink */
+    uint32_t                    next_timer_id;
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+    kaa_log_collector_t        *log_collector;
+#endif
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    kaa_event_manager_t        *event_manager;
+#endif
+    volatile bool               is_stopped;
+#ifdef __linux__
+    int                         epoll_fd;
+#endif
+    kaa_logger_t               *logger;
+};
+
+
+
+/*
+ * Monotonic time in milliseconds.
+ */
+static uint64_t posix_event_loop_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+
+
+kaa_error_t posix_event_loop_create(posix_event_loop_t **loop_p, kaa_logger_t *logger)
+{
+    KAA_RETURN_IF_NIL2(loop_p, logger, KAA_ERR_BADPARAM);
+
+    posix_event_loop_t *loop = (posix_event_loop_t *) KAA_MALLOC(sizeof(posix_event_loop_t));
+    KAA_RETURN_IF_NIL(loop, KAA_ERR_NOMEM);
+
+#ifdef __linux__
+    loop->epoll_fd = epoll_create(POSIX_EVENT_LOOP_MAX_CHANNELS);
+    if (loop->epoll_fd < 0) {
+        KAA_LOG_ERROR(logger, KAA_ERR_SOCKET_ERROR, "Failed to create epoll instance (errno %d)", errno);
+        KAA_FREE(loop);
+        return KAA_ERR_SOCKET_ERROR;
+    }
+#endif
+
+    loop->channels_count = 0;
+    loop->timers = NULL;
+    loop->next_timer_id = 1;
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+    loop->log_collector = NULL;
+#endif
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    loop->event_manager = NULL;
+#endif
+    loop->is_stopped = false;
+    loop->logger = logger;
+
+    *loop_p = loop;
+    return KAA_ERR_NONE;
+}
+
+
+
+void posix_event_loop_destroy(posix_event_loop_t *self)
+{
+    KAA_RETURN_IF_NIL(self, );
+#ifdef __linux__
+    close(self->epoll_fd);
+#endif
+    kaa_list_destroy(self->timers, NULL);
+    KAA_FREE(self);
+}
+
+
+
+static posix_event_loop_channel_t *posix_event_loop_find_channel(posix_event_loop_t *self
+                                                                , kaa_transport_channel_interface_t *channel)
+{
+    size_t i;
+    for (i = 0; i < self->channels_count; ++i) {
+        if (self->channels[i].channel == channel)
+            return &self->channels[i];
+    }
+    return NULL;
+}
+
+
+
+#ifdef __linux__
+static posix_event_loop_channel_t *posix_event_loop_find_channel_by_fd(posix_event_loop_t *self, kaa_fd_t fd)
+{
+    size_t i;
+    for (i = 0; i < self->channels_count; ++i) {
+        if (self->channels[i].fd == fd)
+            return &self->channels[i];
+    }
+    return NULL;
+}
+#endif
+
+
+
+kaa_error_t posix_event_loop_add_channel(posix_event_loop_t *self, kaa_transport_channel_interface_t *channel)
+{
+    KAA_RETURN_IF_NIL3(self, channel, channel->context, KAA_ERR_BADPARAM);
+
+    if (posix_event_loop_find_channel(self, channel))
+        return KAA_ERR_ALREADY_EXISTS;
+    if (self->channels_count == POSIX_EVENT_LOOP_MAX_CHANNELS)
+        return KAA_ERR_INSUFFICIENT_BUFFER;
+
+    posix_event_loop_channel_t *entry = &self->channels[self->channels_count++];
+    entry->channel = channel;
+    entry->fd = KAA_TCP_SOCKET_NOT_SET;
+    entry->wants_read = false;
+    entry->wants_write = false;
+    entry->next_keepalive_check = 0;
+
+    return KAA_ERR_NONE;
+}
+
+
+
+static void posix_event_loop_unregister(posix_event_loop_t *self, posix_event_loop_channel_t *entry)
+{
+#ifdef __linux__
+    if (entry->fd != KAA_TCP_SOCKET_NOT_SET) {
+        /* Fails if the socket is closed already, which unregisters it anyway */
+        epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, entry->fd, NULL);
+    }
+#endif
+    entry->fd = KAA_TCP_SOCKET_NOT_SET;
+    entry->wants_read = false;
+    entry->wants_write = false;
+}
+
+
+
+kaa_error_t posix_event_loop_remove_channel(posix_event_loop_t *self, kaa_transport_channel_interface_t *channel)
+{
+    KAA_RETURN_IF_NIL2(self, channel, KAA_ERR_BADPARAM);
+
+    posix_event_loop_channel_t *entry = posix_event_loop_find_channel(self, channel);
+    KAA_RETURN_IF_NIL(entry, KAA_ERR_NOT_FOUND);
+
+    posix_event_loop_unregister(self, entry);
+    *entry = self->channels[--self->channels_count];
+    return KAA_ERR_NONE;
+}
+
+
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+kaa_error_t posix_event_loop_set_log_collector(posix_event_loop_t *self, kaa_log_collector_t *log_collector)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    self->log_collector = log_collector;
+    return KAA_ERR_NONE;
+}
+#endif
+
+
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+kaa_error_t posix_event_loop_set_event_manager(posix_event_loop_t *self, kaa_event_manager_t *event_manager)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    self->event_manager = event_manager;
+    return KAA_ERR_NONE;
+}
+#endif
+
+
+
+kaa_error_t posix_event_loop_add_timer(posix_event_loop_t *self
+                                     , uint32_t interval
+                                     , bool repeat
+                                     , posix_event_loop_timer_fn callback
+                                     , void *context
+                                     , uint32_t *timer_id)
+{
+    KAA_RETURN_IF_NIL3(self, interval, callback, KAA_ERR_BADPARAM);
+
+    posix_event_loop_timer_t *timer = (posix_event_loop_timer_t *) KAA_MALLOC(sizeof(posix_event_loop_timer_t));
+    KAA_RETURN_IF_NIL(timer, KAA_ERR_NOMEM);
+
+    timer->id = self->next_timer_id++;
+    timer->interval = interval;
+    timer->repeat = repeat;
+    timer->is_removed = false;
+    timer->deadline = posix_event_loop_now() + interval;
+    timer->callback = callback;
+    timer->context = context;
+
+    /* Timers added from a callback go to the tail, so the list being processed stays valid */
+    kaa_list_t *it = self->timers ? kaa_list_push_back(self->timers, timer) : (self->timers = kaa_list_create(timer));
+    if (!it) {
+        KAA_FREE(timer);
+        return KAA_ERR_NOMEM;
+    }
+
+    if (timer_id)
+        *timer_id = timer->id;
+    return KAA_ERR_NONE;
+}
+
+
+
+static bool posix_event_loop_find_timer_by_id(void *timer_p, void *timer_id_p)
+{
+    posix_event_loop_timer_t *timer = (posix_event_loop_timer_t *) timer_p;
+    return !timer->is_removed && timer->id == *(uint32_t *) timer_id_p;
+}
+
+
+
+kaa_error_t posix_event_loop_remove_timer(posix_event_loop_t *self, uint32_t timer_id)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    kaa_list_t *it = kaa_list_find_next(self->timers, &posix_event_loop_find_timer_by_id, &timer_id);
+    KAA_RETURN_IF_NIL(it, KAA_ERR_NOT_FOUND);
+
+    /* Only marked here, since the timer list may be being processed */
+    ((posix_event_loop_timer_t *) kaa_list_get_data(it))->is_removed = true;
+    return KAA_ERR_NONE;
+}
+
+
+
+static bool posix_event_loop_is_timer_removed(void *timer_p, void *context)
+{
+    return ((posix_event_loop_timer_t *) timer_p)->is_removed;
+}
+
+
+
+/*
+ * Brings the registered descriptor and interest of the channel in line with its current state.
+ */
+static void posix_event_loop_update_channel(posix_event_loop_t *self, posix_event_loop_channel_t *entry)
+{
+    kaa_fd_t fd = KAA_TCP_SOCKET_NOT_SET;
+    kaa_tcp_channel_get_descriptor(entry->channel, &fd);
+
+    if (fd != entry->fd)
+        posix_event_loop_unregister(self, entry);
+    if (fd == KAA_TCP_SOCKET_NOT_SET)
+        return;
+
+    bool wants_read = kaa_tcp_channel_is_ready(entry->channel, FD_READ);
+    bool wants_write = kaa_tcp_channel_is_ready(entry->channel, FD_WRITE);
+
+#ifdef __linux__
+    if (entry->fd == fd && entry->wants_read == wants_read && entry->wants_write == wants_write)
+        return;
+
+    struct epoll_event event;
+    event.events = (wants_read ? EPOLLIN : 0) | (wants_write ? EPOLLOUT : 0);
+    event.data.fd = fd;
+
+    int op = (entry->fd == fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(self->epoll_fd, op, fd, &event)) {
+        KAA_LOG_ERROR(self->logger, KAA_ERR_SOCKET_ERROR, "Failed to register socket %d (errno %d)", fd, errno);
+        entry->fd = KAA_TCP_SOCKET_NOT_SET;
+        return;
+    }
+#endif
+
+    entry->fd = fd;
+    entry->wants_read = wants_read;
+    entry->wants_write = wants_write;
+}
+
+
+
+static void posix_event_loop_process_channel_event(posix_event_loop_t *self
+                                                 , posix_event_loop_channel_t *entry
+                                                 , bool can_read
+                                                 , bool can_write)
+{
+    kaa_error_t error_code;
+
+    /* The state may change after either event, so readiness is checked right before processing */
+    if (can_read && kaa_tcp_channel_is_ready(entry->channel, FD_READ)) {
+        error_code = kaa_tcp_channel_process_event(entry->channel, FD_READ);
+        if (error_code) {
+            KAA_LOG_WARN(self->logger, error_code, "Failed to process read event on socket %d", entry->fd);
+        }
+    }
+    if (can_write && kaa_tcp_channel_is_ready(entry->channel, FD_WRITE)) {
+        error_code = kaa_tcp_channel_process_event(entry->channel, FD_WRITE);
+        if (error_code) {
+            KAA_LOG_WARN(self->logger, error_code, "Failed to process write event on socket %d", entry->fd);
+        }
+    }
+}
+
+
+
+/*
+ * Returns the number of milliseconds left until the nearest deadline, or -1 if there is no deadline.
+ */
+static int64_t posix_event_loop_get_wait_time(posix_event_loop_t *self, uint64_t now)
+{
+    int64_t wait_time = -1;
+    size_t i;
+
+    for (i = 0; i < self->channels_count; ++i) {
+        uint16_t max_timeout = 0;
+        kaa_tcp_channel_get_max_timeout(self->channels[i].channel, &max_timeout);
+        if (!max_timeout)
+            continue;
+
+        if (!self->channels[i].next_keepalive_check)
+            self->channels[i].next_keepalive_check = now + (uint64_t) max_timeout * 1000;
+
+        int64_t left = (self->channels[i].next_keepalive_check > now)
+                     ? (int64_t) (self->channels[i].next_keepalive_check - now) : 0;
+        if (wait_time < 0 || left < wait_time)
+            wait_time = left;
+    }
+
+    kaa_list_t *it = self->timers;
+    while (it) {
+        posix_event_loop_timer_t *timer = (posix_event_loop_timer_t *) kaa_list_get_data(it);
+        if (!timer->is_removed) {
+            int64_t left = (timer->deadline > now) ? (int64_t) (timer->deadline - now) : 0;
+            if (wait_time < 0 || left < wait_time)
+                wait_time = left;
+        }
+        it = kaa_list_next(it);
+    }
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+    kaa_time_t log_timeout;
+    if (self->log_collector && !kaa_logging_get_next_timeout(self->log_collector, &log_timeout)) {
+        kaa_time_t time_now = KAA_TIME();
+        int64_t left = (log_timeout > time_now) ? (int64_t) (log_timeout - time_now) * 1000 : 0;
+        if (wait_time < 0 || left < wait_time)
+            wait_time = left;
+    }
+#endif
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    kaa_time_t events_timeout;
+    if (self->event_manager && !kaa_event_manager_get_next_timeout(self->event_manager, &events_timeout)) {
+        kaa_time_t time_now = KAA_TIME();
+        int64_t left = (events_timeout > time_now) ? (int64_t) (events_timeout - time_now) * 1000 : 0;
+        if (wait_time < 0 || left < wait_time)
+            wait_time = left;
+    }
+#endif
+
+    return wait_time;
+}
+
+
+
+static void posix_event_loop_process_deadlines(posix_event_loop_t *self)
+{
+    uint64_t now = posix_event_loop_now();
+    size_t i;
+
+    for (i = 0; i < self->channels_count; ++i) {
+        posix_event_loop_channel_t *entry = &self->channels[i];
+        if (!entry->next_keepalive_check || entry->next_keepalive_check > now)
+            continue;
+
+        kaa_error_t error_code = kaa_tcp_channel_check_keepalive(entry->channel);
+        if (error_code) {
+            KAA_LOG_WARN(self->logger, error_code, "Failed to check channel keepalive");
+        }
+
+        uint16_t max_timeout = 0;
+        kaa_tcp_channel_get_max_timeout(entry->channel, &max_timeout);
+        entry->next_keepalive_check = max_timeout ? now + (uint64_t) max_timeout * 1000 : 0;
+    }
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+    kaa_time_t log_timeout;
+    if (self->log_collector && !kaa_logging_get_next_timeout(self->log_collector, &log_timeout)
+            && KAA_TIME() >= log_timeout) {
+        kaa_logging_check_timeouts(self->log_collector);
+    }
+#endif
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+    if (self->event_manager)
+        kaa_event_manager_check_timeouts(self->event_manager);
+#endif
+
+    kaa_list_t *it = self->timers;
+    while (it) {
+        posix_event_loop_timer_t *timer = (posix_event_loop_timer_t *) kaa_list_get_data(it);
+        if (!timer->is_removed && timer->deadline <= now) {
+            if (timer->repeat) {
+                timer->deadline += timer->interval;
+                if (timer->deadline <= now)
+                    timer->deadline = now + timer->interval;
+            } else {
+                timer->is_removed = true;
+            }
+            timer->callback(timer->context);
+        }
+        it = kaa_list_next(it);
+    }
+
+    while (kaa_list_remove_first(&self->timers, &posix_event_loop_is_timer_removed, NULL, NULL) == KAA_ERR_NONE);
+}
+
+
+
+kaa_error_t posix_event_loop_run_once(posix_event_loop_t *self, int32_t max_wait)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    size_t i;
+    for (i = 0; i < self->channels_count; ++i)
+        posix_event_loop_update_channel(self, &self->channels[i]);
+
+    int64_t wait_time = posix_event_loop_get_wait_time(self, posix_event_loop_now());
+    if (max_wait >= 0 && (wait_time < 0 || wait_time > max_wait))
+        wait_time = max_wait;
+    if (wait_time > INT32_MAX)
+        wait_time = INT32_MAX;
+
+#ifdef __linux__
+    struct epoll_event events[POSIX_EVENT_LOOP_MAX_CHANNELS];
+    int events_count = epoll_wait(self->epoll_fd, events, POSIX_EVENT_LOOP_MAX_CHANNELS, (int) wait_time);
+#else
+    struct pollfd fds[POSIX_EVENT_LOOP_MAX_CHANNELS];
+    posix_event_loop_channel_t *fd_entries[POSIX_EVENT_LOOP_MAX_CHANNELS];
+    nfds_t fds_count = 0;
+    for (i = 0; i < self->channels_count; ++i) {
+        posix_event_loop_channel_t *entry = &self->channels[i];
+        if (entry->fd == KAA_TCP_SOCKET_NOT_SET || (!entry->wants_read && !entry->wants_write))
+            continue;
+        fds[fds_count].fd = entry->fd;
+        fds[fds_count].events = (entry->wants_read ? POLLIN : 0) | (entry->wants_write ? POLLOUT : 0);
+        fds[fds_count].revents = 0;
+        fd_entries[fds_count++] = entry;
+    }
+    int events_count = poll(fds, fds_count, (int) wait_time);
+#endif
+
+    if (events_count < 0) {
+        if (errno != EINTR) {
+            KAA_LOG_ERROR(self->logger, KAA_ERR_SOCKET_ERROR, "Failed to wait for socket events (errno %d)", errno);
+            return KAA_ERR_SOCKET_ERROR;
+        }
+        events_count = 0;
+    }
+
+#ifdef __linux__
+    int j;
+    for (j = 0; j < events_count; ++j) {
+        posix_event_loop_channel_t *entry = posix_event_loop_find_channel_by_fd(self, events[j].data.fd);
+        if (!entry)
+            continue;
+        bool is_failed = events[j].events & (EPOLLERR | EPOLLHUP);
+        posix_event_loop_process_channel_event(self, entry
+                                             , is_failed || (events[j].events & EPOLLIN)
+                                             , is_failed || (events[j].events & EPOLLOUT));
+    }
+#else
+    nfds_t j;
+    for (j = 0; j < fds_count; ++j) {
+        if (!fds[j].revents)
+            continue;
+        bool is_failed = fds[j].revents & (POLLERR | POLLHUP | POLLNVAL);
+        posix_event_loop_process_channel_event(self, fd_entries[j]
+                                             , is_failed || (fds[j].revents & POLLIN)
+                                             , is_failed || (fds[j].revents & POLLOUT));
+    }
+#endif
+
+    posix_event_loop_process_deadlines(self);
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t posix_event_loop_run(posix_event_loop_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    self->is_stopped = false;
+    while (!self->is_stopped) {
+        kaa_error_t error_code = posix_event_loop_run_once(self, POSIX_EVENT_LOOP_WAIT_INFINITE);
+        KAA_RETURN_IF_ERR(error_code);
+    }
+    return KAA_ERR_NONE;
+}
+
+
+
+void posix_event_loop_stop(posix_event_loop_t *self)
+{
+    if (self)
+        self->is_stopped = true;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file posix_event_loop.h
+ * @brief Event loop for Kaa TCP channels and application timers.
+ *
+ * Waits for I/O on channel sockets with epoll (poll on non-Linux systems) and wakes up exactly when
+ * a channel keepalive has to be checked, a log delivery times out or an application timer fires,
+ * so there is no need to poll with short timeouts.
+ *
+ * Not thread safe: all functions, including timer callbacks, are expected to run in the loop thread.
+ */
+
+#ifndef POSIX_EVENT_LOOP_H_
+#define POSIX_EVENT_LOOP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../../kaa_error.h"
+#include "../../utilities/kaa_log.h"
+#include "../../platform/ext_transport_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+/** Max number of channels served by a loop */
+#define POSIX_EVENT_LOOP_MAX_CHANNELS   4
+
+/** Use as @c max_wait of @link posix_event_loop_run_once @endlink to wait until the next deadline */
+#define POSIX_EVENT_LOOP_WAIT_INFINITE  (-1)
+
+
+
+typedef struct posix_event_loop_t   posix_event_loop_t;
+
+#ifndef KAA_LOG_COLLECTOR_T
+# define KAA_LOG_COLLECTOR_T
+    typedef struct kaa_log_collector        kaa_log_collector_t;
+#endif
+
+#ifndef KAA_EVENT_MANAGER_T
+# define KAA_EVENT_MANAGER_T
+    typedef struct kaa_event_manager_t      kaa_event_manager_t;
+#endif
+
+/**
+ * @brief Application timer callback.
+ *
+ * @param[in]   context     Context passed to @link posix_event_loop_add_timer @endlink.
+ */
+typedef void (*posix_event_loop_timer_fn)(void *context);
+
+
+
+/**
+ * @brief Creates the event loop.
+ *
+ * @param[out]  loop_p      The pointer to the new loop.
+ * @param[in]   logger      The logger.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_create(posix_event_loop_t **loop_p, kaa_logger_t *logger);
+
+/**
+ * @brief Destroys the event loop. Channels, the log collector and the event manager are not affected.
+ *
+ * @param[in]   self        The loop.
+ */
+void posix_event_loop_destroy(posix_event_loop_t *self);
+
+/**
+ * @brief Makes the loop serve the Kaa TCP channel.
+ *
+ * The socket is (re)registered automatically whenever the channel connects or reconnects.
+ *
+ * @param[in]   self        The loop.
+ * @param[in]   channel     The channel created with @link kaa_tcp_channel_create @endlink.
+ *
+ * @return Error code. @c KAA_ERR_INSUFFICIENT_BUFFER if the loop serves
+ *         @link POSIX_EVENT_LOOP_MAX_CHANNELS @endlink channels already.
+ */
+kaa_error_t posix_event_loop_add_channel(posix_event_loop_t *self, kaa_transport_channel_interface_t *channel);
+
+/**
+ * @brief Stops serving the channel.
+ *
+ * @param[in]   self        The loop.
+ * @param[in]   channel     The channel.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_remove_channel(posix_event_loop_t *self, kaa_transport_channel_interface_t *channel);
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+/**
+ * @brief Makes the loop check log delivery timeouts of the log collector.
+ *
+ * @param[in]   self            The loop.
+ * @param[in]   log_collector   The log collector, @c NULL to stop checking.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_set_log_collector(posix_event_loop_t *self, kaa_log_collector_t *log_collector);
+#endif
+
+#ifndef KAA_DISABLE_FEATURE_EVENTS
+/**
+ * @brief Makes the loop send batched events of the event manager when their deadline passes.
+ *
+ * @param[in]   self            The loop.
+ * @param[in]   event_manager   The event manager, @c NULL to stop checking.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_set_event_manager(posix_event_loop_t *self, kaa_event_manager_t *event_manager);
+#endif
+
+/**
+ * @brief Schedules the application timer.
+ *
+ * @param[in]   self        The loop.
+ * @param[in]   interval    The interval in milliseconds.
+ * @param[in]   repeat      Whether to fire every @c interval or once.
+ * @param[in]   callback    The callback.
+ * @param[in]   context     The callback context.
+ * @param[out]  timer_id    The timer id to remove the timer with. May be @c NULL.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_add_timer(posix_event_loop_t *self
+                                     , uint32_t interval
+                                     , bool repeat
+                                     , posix_event_loop_timer_fn callback
+                                     , void *context
+                                     , uint32_t *timer_id);
+
+/**
+ * @brief Cancels the application timer. May be called from a timer callback.
+ *
+ * @param[in]   self        The loop.
+ * @param[in]   timer_id    The timer id.
+ *
+ * @return Error code. @c KAA_ERR_NOT_FOUND if there is no such timer, e.g. a one-shot timer has fired.
+ */
+kaa_error_t posix_event_loop_remove_timer(posix_event_loop_t *self, uint32_t timer_id);
+
+/**
+ * @brief Waits for the next event or deadline and handles everything that is due.
+ *
+ * @param[in]   self        The loop.
+ * @param[in]   max_wait    The max time to wait in milliseconds or
+ *                          @link POSIX_EVENT_LOOP_WAIT_INFINITE @endlink.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_run_once(posix_event_loop_t *self, int32_t max_wait);
+
+/**
+ * @brief Runs the loop until @link posix_event_loop_stop @endlink is called.
+ *
+ * @param[in]   self        The loop.
+ *
+ * @return Error code.
+ */
+kaa_error_t posix_event_loop_run(posix_event_loop_t *self);
+
+/**
+ * @brief Makes @link posix_event_loop_run @endlink return after the current iteration.
+ *
+ * May be called from a timer callback or a signal handler.
+ *
+ * @param[in]   self        The loop.
+ */
+void posix_event_loop_stop(posix_event_loop_t *self);
+
+#ifdef __cplusplus
+}      /* extern "C" */
+#endif
+#endif /* POSIX_EVENT_LOOP_H_ */
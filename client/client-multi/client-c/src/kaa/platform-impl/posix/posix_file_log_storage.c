@@ -0,0 +1,993 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File-backed log storage.
+ *
+ * Records are appended to segment files "<directory>/kaa_logs_<id>.seg". A segment is
+ * sealed once the next record would exceed the segment size, and a new one is started.
+ * Each record is preceded by a fixed-size header which contains its state, size and CRC32
+ * of the data.
+ *
+ * Bucket assignment is kept in memory only. When a bucket is acknowledged, the state bytes of its
+ * records are overwritten in place and segments without live records are unlinked. When a bucket
+ * upload fails, its records are simply unmarked. After a crash all records which were not
+ * acknowledged are restored as unmarked, so they are delivered at least once. A torn record at
+ * the tail of a segment is truncated away.
+ *
+ * The active segment is synced to disk every KAA_LOG_STORAGE_SYNC_INTERVAL records (after each
+ * record by default), so a power loss costs at most that many records.
+ */
+
+#ifndef KAA_DISABLE_FEATURE_LOGGING
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "../../platform/platform.h"
+
+#include "../../platform/ext_log_storage.h"
+
+#include "../../collections/kaa_list.h"
+#include "../../utilities/kaa_mem.h"
+#include "../../utilities/kaa_log.h"
+
+
+
+#define KAA_LOG_SEGMENT_NAME_PREFIX     "kaa_logs_"
+#define KAA_LOG_SEGMENT_NAME_SUFFIX     ".seg"
+#define KAA_LOG_SEGMENT_NAME_FORMAT     KAA_LOG_SEGMENT_NAME_PREFIX "%08x" KAA_LOG_SEGMENT_NAME_SUFFIX
+#define KAA_LOG_SEGMENT_NAME_LENGTH     (sizeof(KAA_LOG_SEGMENT_NAME_PREFIX) - 1 + 8 + sizeof(KAA_LOG_SEGMENT_NAME_SUFFIX) - 1)
+
+#define KAA_LOG_RECORD_MAGIC_0          0x4B    /* 'K' */
+#define KAA_LOG_RECORD_MAGIC_1          0x4C    /* 'L' */
+#define KAA_LOG_RECORD_STATE_VALID      0x01
+#define KAA_LOG_RECORD_STATE_REMOVED    0x00
+
+#define KAA_LOG_RECORD_STATE_OFFSET     2
+#define KAA_LOG_RECORD_HEADER_SIZE      12
+
+#define KAA_DEFAULT_LOG_SEGMENT_SIZE    (64 * 1024)
+#define KAA_DEFAULT_LOG_SEGMENTS_COUNT  16
+
+#ifndef KAA_LOG_STORAGE_SYNC_INTERVAL
+#define KAA_LOG_STORAGE_SYNC_INTERVAL   1
+#endif
+
+
+
+typedef struct {
+    uint32_t    segment_id; /**< ID of the segment containing the record */
+    uint32_t    offset;     /**< Offset of the record header in the segment */
+    uint32_t    size;       /**< Size of data */
+    uint16_t    bucket_id;  /**< Bucket ID */
+} ext_file_log_record_t;
+
+typedef struct {
+    uint32_t    id;             /**< Segment ID, used in the file name */
+    size_t      size;           /**< Number of bytes written to the segment file */
+    size_t      alive_records;  /**< Number of records which were not removed yet */
+} ext_file_log_segment_t;
+
+typedef struct {
+    char           *directory;             /**< Directory containing segment files */
+    size_t          segment_size;          /**< Max size of a segment file */
+    size_t          max_segments;          /**< Max number of segment files */
+    kaa_list_t     *segments;              /**< List of @link ext_file_log_segment_t @endlink, elder first */
+    kaa_list_t     *last_segment_it;       /**< Point to the segment new records are appended to */
+    kaa_list_t     *logs;                  /**< List of @link ext_file_log_record_t @endlink, elder first */
+    kaa_list_t     *last_log_it;           /**< Point to the last record in the storage */
+    kaa_list_t     *first_unmarked;        /**< Pointer to the first unmarked record position (with zero bucket_id) */
+    size_t          occupied_size;         /**< Currently occupied logs volume */
+    uint32_t        next_segment_id;       /**< ID to assign to the next segment */
+    int             write_fd;              /**< Descriptor of the last segment, -1 if it is sealed */
+    size_t          unsynced_records;      /**< Number of records written to @c write_fd since the last sync */
+    int             read_fd;               /**< Cached descriptor of the last segment records were read from */
+    uint32_t        read_segment_id;       /**< ID of the segment @c read_fd belongs to */
+    kaa_logger_t   *logger;                /**< Logger instance */
+} ext_file_log_storage_t;
+
+
+
+/**
+ * @brief Creates the instance of the file log storage with the default segment settings.
+ *
+ * Restores records left in @c directory by a previous run.
+ *
+ * @param[out]    log_storage_context_p    The pointer to the new storage instance.
+ * @param[in]     logger                   The logger.
+ * @param[in]     directory                The directory to keep segment files in. Created if missing.
+ *
+ * @return    Error code.
+ */
+kaa_error_t ext_file_log_storage_create(void **log_storage_context_p, kaa_logger_t *logger, const char *directory);
+
+
+
+/**
+ * @brief Creates the instance of the file log storage.
+ *
+ * Restores records left in @c directory by a previous run. The storage never keeps more than
+ * @c max_segments segment files: if it is full, the elder segment is removed along with its records.
+ *
+ * @param[out]    log_storage_context_p    The pointer to the new storage instance.
+ * @param[in]     logger                   The logger.
+ * @param[in]     directory                The directory to keep segment files in. Created if missing.
+ * @param[in]     segment_size             The maximum size of a segment file.
+ * @param[in]     max_segments             The maximum number of segment files.
+ *
+ * @return    Error code.
+ */
+kaa_error_t ext_limited_file_log_storage_create(void **log_storage_context_p
+                                              , kaa_logger_t *logger
+                                              , const char *directory
+                                              , size_t segment_size
+                                              , size_t max_segments);
+
+
+
+/**
+ * @brief Destroys the instance of the file log storage. Segment files are kept on disk.
+ *
+ * @param[in]   context The log storage context.
+ * @return    Error code.
+ */
+kaa_error_t ext_log_storage_destroy(void *context);
+
+
+
+static void list_data_destroy(void *data)
+{
+    KAA_FREE(data);
+}
+
+
+
+static uint32_t crc32_calculate(const char *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    size_t i;
+    int bit;
+    for (i = 0; i < size; ++i) {
+        crc ^= (uint8_t) data[i];
+        for (bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (-(int32_t)(crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+
+
+static void record_header_write(char *header, uint32_t size, uint32_t crc)
+{
+    header[0] = KAA_LOG_RECORD_MAGIC_0;
+    header[1] = KAA_LOG_RECORD_MAGIC_1;
+    header[KAA_LOG_RECORD_STATE_OFFSET] = KAA_LOG_RECORD_STATE_VALID;
+    header[3] = 0;
+    int i;
+    for (i = 0; i < 4; ++i) {
+        header[4 + i] = (char) (size >> (8 * i));
+        header[8 + i] = (char) (crc >> (8 * i));
+    }
+}
+
+
+
+static uint32_t record_header_read_uint32(const char *field)
+{
+    return (uint32_t) (uint8_t) field[0]
+         | (uint32_t) (uint8_t) field[1] << 8
+         | (uint32_t) (uint8_t) field[2] << 16
+         | (uint32_t) (uint8_t) field[3] << 24;
+}
+
+
+
+static int write_fully(int fd, const char *buffer, size_t size, off_t offset)
+{
+    while (size) {
+        ssize_t written = pwrite(fd, buffer, size, offset);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buffer += written;
+        size -= written;
+        offset += written;
+    }
+    return 0;
+}
+
+
+
+static ssize_t read_fully(int fd, char *buffer, size_t size, off_t offset)
+{
+    size_t total = 0;
+    while (total < size) {
+        ssize_t was_read = pread(fd, buffer + total, size - total, offset + total);
+        if (was_read < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (!was_read)
+            break;
+        total += was_read;
+    }
+    return total;
+}
+
+
+
+static void segment_file_name(const ext_file_log_storage_t *self, uint32_t segment_id, char *name, size_t name_size)
+{
+    snprintf(name, name_size, "%s/" KAA_LOG_SEGMENT_NAME_FORMAT, self->directory, segment_id);
+}
+
+
+
+static int segment_open(ext_file_log_storage_t *self, uint32_t segment_id, int flags)
+{
+    size_t name_size = strlen(self->directory) + KAA_LOG_SEGMENT_NAME_LENGTH + 2;
+    char *name = (char *) KAA_MALLOC(name_size);
+    KAA_RETURN_IF_NIL(name, -1);
+    segment_file_name(self, segment_id, name, name_size);
+
+    int fd = open(name, flags, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to open log segment '%s' (errno %d)", name, errno);
+    }
+    KAA_FREE(name);
+    return fd;
+}
+
+
+
+static void segment_unlink(ext_file_log_storage_t *self, uint32_t segment_id)
+{
+    size_t name_size = strlen(self->directory) + KAA_LOG_SEGMENT_NAME_LENGTH + 2;
+    char *name = (char *) KAA_MALLOC(name_size);
+    if (!name)
+        return;
+    segment_file_name(self, segment_id, name, name_size);
+
+    if (unlink(name) && errno != ENOENT) {
+        KAA_LOG_WARN(self->logger, KAA_ERR_WRITE_FAILED, "Failed to remove log segment '%s' (errno %d)", name, errno);
+    } else {
+        KAA_LOG_DEBUG(self->logger, KAA_ERR_NONE, "Log segment '%s' removed", name);
+    }
+    KAA_FREE(name);
+}
+
+
+
+static void segment_close_descriptors(ext_file_log_storage_t *self, uint32_t segment_id, bool is_last)
+{
+    if (self->read_fd >= 0 && self->read_segment_id == segment_id) {
+        close(self->read_fd);
+        self->read_fd = -1;
+    }
+    if (is_last && self->write_fd >= 0) {
+        close(self->write_fd);
+        self->write_fd = -1;
+    }
+}
+
+
+
+static bool segments_list_find_by_id(void *segment_p, void *segment_id_p)
+{
+    return ((ext_file_log_segment_t *)segment_p)->id == *((uint32_t *)segment_id_p);
+}
+
+
+
+static kaa_list_t *segment_find(ext_file_log_storage_t *self, uint32_t segment_id)
+{
+    return kaa_list_find_next(self->segments, &segments_list_find_by_id, &segment_id);
+}
+
+
+
+/*
+ * Drops the descriptor of a segment which has no live records and removes its file.
+ */
+static void segment_release(ext_file_log_storage_t *self, kaa_list_t *segment_it)
+{
+    ext_file_log_segment_t *segment = (ext_file_log_segment_t *) kaa_list_get_data(segment_it);
+    uint32_t segment_id = segment->id;
+    bool is_last = (segment_it == self->last_segment_it);
+
+    segment_close_descriptors(self, segment_id, is_last);
+    segment_unlink(self, segment_id);
+
+    kaa_list_remove_at(&self->segments, segment_it, &list_data_destroy);
+    if (is_last) {
+        self->last_segment_it = NULL;
+        kaa_list_t *it = self->segments;
+        while (it) {
+            self->last_segment_it = it;
+            it = kaa_list_next(it);
+        }
+    }
+}
+
+
+
+/*
+ * Marks the record as removed on disk. Failures are not fatal: the record will be delivered again
+ * after the restart.
+ */
+static void record_mark_removed(ext_file_log_storage_t *self, int fd, const ext_file_log_record_t *record)
+{
+    char state = KAA_LOG_RECORD_STATE_REMOVED;
+    if (fd < 0 || write_fully(fd, &state, sizeof(state), record->offset + KAA_LOG_RECORD_STATE_OFFSET)) {
+        KAA_LOG_WARN(self->logger, KAA_ERR_WRITE_FAILED, "Failed to mark log record (segment %u, offset %u) "
+                                        "as removed", record->segment_id, record->offset);
+    }
+}
+
+
+
+/*
+ * Forgets the record and releases its segment if it was the last live record there.
+ */
+static kaa_list_t *record_remove(ext_file_log_storage_t *self, kaa_list_t *record_it)
+{
+    ext_file_log_record_t *record = (ext_file_log_record_t *) kaa_list_get_data(record_it);
+    self->occupied_size -= record->size;
+
+    kaa_list_t *segment_it = segment_find(self, record->segment_id);
+    if (segment_it) {
+        ext_file_log_segment_t *segment = (ext_file_log_segment_t *) kaa_list_get_data(segment_it);
+        if (!--segment->alive_records)
+            segment_release(self, segment_it);
+    }
+
+    if (self->first_unmarked == record_it)
+        self->first_unmarked = NULL;
+
+    bool is_last = (self->last_log_it == record_it);
+    kaa_list_t *next = kaa_list_remove_at(&self->logs, record_it, &list_data_destroy);
+    if (is_last) {
+        self->last_log_it = NULL;
+        kaa_list_t *it = self->logs;
+        while (it) {
+            self->last_log_it = it;
+            it = kaa_list_next(it);
+        }
+    }
+
+    return next;
+}
+
+
+
+/*
+ * Removes the elder segment with all its records, including ones already marked with a bucket id.
+ */
+static void shrink_by_segment(ext_file_log_storage_t *self)
+{
+    KAA_RETURN_IF_NIL(self->segments, );
+    uint32_t segment_id = ((ext_file_log_segment_t *) kaa_list_get_data(self->segments))->id;
+    size_t removed_record_count = 0;
+
+    while (self->logs && ((ext_file_log_record_t *) kaa_list_get_data(self->logs))->segment_id == segment_id) {
+        record_remove(self, self->logs);
+        ++removed_record_count;
+    }
+
+    /* The segment could have no records, e.g. if all of them were torn */
+    kaa_list_t *segment_it = segment_find(self, segment_id);
+    if (segment_it)
+        segment_release(self, segment_it);
+
+    KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "%zu records forcibly removed", removed_record_count);
+}
+
+
+
+static void directory_sync(ext_file_log_storage_t *self)
+{
+    int fd = open(self->directory, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+
+
+static kaa_error_t segment_start(ext_file_log_storage_t *self)
+{
+    if (self->write_fd >= 0) {
+        fdatasync(self->write_fd);
+        close(self->write_fd);
+        self->write_fd = -1;
+    }
+    self->unsynced_records = 0;
+
+    if (self->last_segment_it && !((ext_file_log_segment_t *) kaa_list_get_data(self->last_segment_it))->alive_records)
+        segment_release(self, self->last_segment_it);
+
+    while (self->segments && kaa_list_get_size(self->segments) >= self->max_segments) {
+        KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "Log storage is full (%zu segments). "
+                                "Going to delete elder logs", self->max_segments);
+        shrink_by_segment(self);
+    }
+
+    ext_file_log_segment_t *segment = (ext_file_log_segment_t *) KAA_MALLOC(sizeof(ext_file_log_segment_t));
+    KAA_RETURN_IF_NIL(segment, KAA_ERR_NOMEM);
+    segment->id = self->next_segment_id;
+    segment->size = 0;
+    segment->alive_records = 0;
+
+    int fd = segment_open(self, segment->id, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0) {
+        KAA_FREE(segment);
+        return KAA_ERR_WRITE_FAILED;
+    }
+
+    kaa_list_t *it = self->segments
+            ? kaa_list_insert_after(self->last_segment_it, segment)
+            : (self->segments = kaa_list_create(segment));
+    if (!it) {
+        close(fd);
+        segment_unlink(self, segment->id);
+        KAA_FREE(segment);
+        return KAA_ERR_NOMEM;
+    }
+
+    /* Make the new segment file itself survive a power loss */
+    directory_sync(self);
+
+    ++self->next_segment_id;
+    self->last_segment_it = it;
+    self->write_fd = fd;
+    return KAA_ERR_NONE;
+}
+
+
+
+/*
+ * Reads records of the segment, appending live ones to the storage.
+ * Truncates the segment at the first record which is torn or corrupted.
+ */
+static kaa_error_t segment_recover(ext_file_log_storage_t *self, ext_file_log_segment_t *segment, char *buffer)
+{
+    int fd = segment_open(self, segment->id, O_RDWR);
+    if (fd < 0)
+        return KAA_ERR_READ_FAILED;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat)) {
+        close(fd);
+        return KAA_ERR_READ_FAILED;
+    }
+
+    size_t file_size = file_stat.st_size;
+    size_t offset = 0;
+    char header[KAA_LOG_RECORD_HEADER_SIZE];
+    kaa_error_t error_code = KAA_ERR_NONE;
+
+    while (offset < file_size) {
+        if (read_fully(fd, header, KAA_LOG_RECORD_HEADER_SIZE, offset) != KAA_LOG_RECORD_HEADER_SIZE)
+            break;
+        if (header[0] != KAA_LOG_RECORD_MAGIC_0 || header[1] != KAA_LOG_RECORD_MAGIC_1)
+            break;
+
+        uint32_t size = record_header_read_uint32(header + 4);
+        uint32_t crc = record_header_read_uint32(header + 8);
+        if (!size || size > self->segment_size - KAA_LOG_RECORD_HEADER_SIZE
+                  || offset + KAA_LOG_RECORD_HEADER_SIZE + size > file_size)
+            break;
+
+        if (header[KAA_LOG_RECORD_STATE_OFFSET] == KAA_LOG_RECORD_STATE_VALID) {
+            if (read_fully(fd, buffer, size, offset + KAA_LOG_RECORD_HEADER_SIZE) != size
+                    || crc32_calculate(buffer, size) != crc)
+                break;
+
+            ext_file_log_record_t *record = (ext_file_log_record_t *) KAA_MALLOC(sizeof(ext_file_log_record_t));
+            if (!record) {
+                error_code = KAA_ERR_NOMEM;
+                break;
+            }
+            record->segment_id = segment->id;
+            record->offset = offset;
+            record->size = size;
+            record->bucket_id = 0;
+
+            kaa_list_t *it = self->logs
+                    ? kaa_list_insert_after(self->last_log_it, record)
+                    : (self->logs = kaa_list_create(record));
+            if (!it) {
+                KAA_FREE(record);
+                error_code = KAA_ERR_NOMEM;
+                break;
+            }
+            self->last_log_it = it;
+            self->occupied_size += size;
+            ++segment->alive_records;
+        }
+
+        offset += KAA_LOG_RECORD_HEADER_SIZE + size;
+    }
+
+    if (!error_code && offset < file_size) {
+        KAA_LOG_WARN(self->logger, KAA_ERR_BADDATA, "Log segment %u is damaged at offset %zu, "
+                                "truncating %zu bytes", segment->id, offset, file_size - offset);
+        if (ftruncate(fd, offset)) {
+            KAA_LOG_WARN(self->logger, KAA_ERR_WRITE_FAILED, "Failed to truncate log segment %u", segment->id);
+        }
+    }
+
+    segment->size = offset;
+    close(fd);
+    return error_code;
+}
+
+
+
+static int segment_id_compare(const void *left, const void *right)
+{
+    uint32_t left_id = *(const uint32_t *)left;
+    uint32_t right_id = *(const uint32_t *)right;
+    return (left_id > right_id) - (left_id < right_id);
+}
+
+
+
+static kaa_error_t storage_recover(ext_file_log_storage_t *self)
+{
+    DIR *dir = opendir(self->directory);
+    if (!dir) {
+        KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to open log directory '%s' (errno %d)"
+                                                                        , self->directory, errno);
+        return KAA_ERR_READ_FAILED;
+    }
+
+    uint32_t *ids = NULL;
+    size_t ids_count = 0;
+    size_t ids_capacity = 0;
+    kaa_error_t error_code = KAA_ERR_NONE;
+
+    /* The first pass counts segments, the second one collects their ids */
+    struct dirent *entry;
+    int pass;
+    for (pass = 0; pass < 2 && !error_code; ++pass) {
+        if (pass) {
+            if (!ids_capacity)
+                break;
+            ids = (uint32_t *) KAA_MALLOC(ids_capacity * sizeof(uint32_t));
+            if (!ids) {
+                error_code = KAA_ERR_NOMEM;
+                break;
+            }
+            rewinddir(dir);
+        }
+
+        while ((entry = readdir(dir))) {
+            unsigned int id;
+            char suffix[sizeof(KAA_LOG_SEGMENT_NAME_SUFFIX)];
+            if (strlen(entry->d_name) != KAA_LOG_SEGMENT_NAME_LENGTH
+                    || sscanf(entry->d_name, KAA_LOG_SEGMENT_NAME_PREFIX "%8x%4s", &id, suffix) != 2
+                    || strcmp(suffix, KAA_LOG_SEGMENT_NAME_SUFFIX))
+                continue;
+
+            if (!pass)
+                ++ids_capacity;
+            else if (ids_count < ids_capacity)
+                ids[ids_count++] = id;
+        }
+    }
+    closedir(dir);
+
+    char *buffer = NULL;
+    if (!error_code && ids_count) {
+        buffer = (char *) KAA_MALLOC(self->segment_size);
+        if (!buffer)
+            error_code = KAA_ERR_NOMEM;
+    }
+
+    if (!error_code && ids_count) {
+        qsort(ids, ids_count, sizeof(uint32_t), &segment_id_compare);
+
+        size_t i;
+        for (i = 0; i < ids_count && !error_code; ++i) {
+            ext_file_log_segment_t *segment = (ext_file_log_segment_t *) KAA_MALLOC(sizeof(ext_file_log_segment_t));
+            if (!segment) {
+                error_code = KAA_ERR_NOMEM;
+                break;
+            }
+            segment->id = ids[i];
+            segment->size = 0;
+            segment->alive_records = 0;
+            self->next_segment_id = segment->id + 1;
+
+            error_code = segment_recover(self, segment, buffer);
+            if (error_code == KAA_ERR_READ_FAILED) {
+                /* Records of an unreadable segment are lost anyway, but the file is left for investigation */
+                KAA_FREE(segment);
+                error_code = KAA_ERR_NONE;
+                continue;
+            }
+
+            if (!error_code && !segment->alive_records) {
+                segment_unlink(self, segment->id);
+                KAA_FREE(segment);
+                continue;
+            }
+
+            kaa_list_t *it = self->segments
+                    ? kaa_list_insert_after(self->last_segment_it, segment)
+                    : (self->segments = kaa_list_create(segment));
+            if (!it) {
+                KAA_FREE(segment);
+                error_code = KAA_ERR_NOMEM;
+                break;
+            }
+            self->last_segment_it = it;
+        }
+    }
+
+    KAA_FREE(buffer);
+    KAA_FREE(ids);
+    KAA_RETURN_IF_ERR(error_code);
+
+    while (self->segments && kaa_list_get_size(self->segments) > self->max_segments)
+        shrink_by_segment(self);
+
+    if (self->last_segment_it) {
+        ext_file_log_segment_t *segment = (ext_file_log_segment_t *) kaa_list_get_data(self->last_segment_it);
+        if (segment->size + KAA_LOG_RECORD_HEADER_SIZE < self->segment_size)
+            self->write_fd = segment_open(self, segment->id, O_WRONLY);
+    }
+
+    KAA_LOG_INFO(self->logger, KAA_ERR_NONE, "Restored %zu log records (%zu bytes) from %zu segments"
+            , kaa_list_get_size(self->logs), self->occupied_size, kaa_list_get_size(self->segments));
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_file_log_storage_create(void **log_storage_context_p, kaa_logger_t *logger, const char *directory)
+{
+    return ext_limited_file_log_storage_create(log_storage_context_p, logger, directory
+                                             , KAA_DEFAULT_LOG_SEGMENT_SIZE, KAA_DEFAULT_LOG_SEGMENTS_COUNT);
+}
+
+
+
+kaa_error_t ext_limited_file_log_storage_create(void **log_storage_context_p
+                                              , kaa_logger_t *logger
+                                              , const char *directory
+                                              , size_t segment_size
+                                              , size_t max_segments)
+{
+    KAA_RETURN_IF_NIL5(log_storage_context_p, logger, directory, segment_size, max_segments, KAA_ERR_BADPARAM);
+
+    if (segment_size <= KAA_LOG_RECORD_HEADER_SIZE || segment_size > UINT32_MAX) {
+        KAA_LOG_WARN(logger, KAA_ERR_BADPARAM, "Failed to create log storage: invalid segment size %zu", segment_size);
+        return KAA_ERR_BADPARAM;
+    }
+
+    if (mkdir(directory, S_IRWXU) && errno != EEXIST) {
+        KAA_LOG_ERROR(logger, KAA_ERR_WRITE_FAILED, "Failed to create log directory '%s' (errno %d)", directory, errno);
+        return KAA_ERR_WRITE_FAILED;
+    }
+
+    ext_file_log_storage_t *log_storage = (ext_file_log_storage_t *) KAA_MALLOC(sizeof(ext_file_log_storage_t));
+    KAA_RETURN_IF_NIL(log_storage, KAA_ERR_NOMEM);
+
+    size_t directory_length = strlen(directory);
+    log_storage->directory = (char *) KAA_MALLOC(directory_length + 1);
+    if (!log_storage->directory) {
+        KAA_FREE(log_storage);
+        return KAA_ERR_NOMEM;
+    }
+    memcpy(log_storage->directory, directory, directory_length + 1);
+
+    log_storage->logger           = logger;
+    log_storage->segment_size     = segment_size;
+    log_storage->max_segments     = max_segments;
+    log_storage->segments         = NULL;
+    log_storage->last_segment_it  = NULL;
+    log_storage->logs             = NULL;
+    log_storage->last_log_it      = NULL;
+    log_storage->first_unmarked   = NULL;
+    log_storage->occupied_size    = 0;
+    log_storage->next_segment_id  = 0;
+    log_storage->write_fd         = -1;
+    log_storage->unsynced_records = 0;
+    log_storage->read_fd          = -1;
+    log_storage->read_segment_id  = 0;
+
+    kaa_error_t error_code = storage_recover(log_storage);
+    if (error_code) {
+        ext_log_storage_destroy(log_storage);
+        return error_code;
+    }
+
+    *log_storage_context_p = (void *)log_storage;
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_log_storage_allocate_log_record_buffer(void *context, kaa_log_record_t *record)
+{
+    KAA_RETURN_IF_NIL2(record, record->size, KAA_ERR_BADPARAM);
+
+    record->data = (char *) KAA_MALLOC(record->size * sizeof(char));
+    if (!record->data)
+        return KAA_ERR_NOMEM;
+
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_log_storage_deallocate_log_record_buffer(void *context, kaa_log_record_t *record)
+{
+    KAA_RETURN_IF_NIL2(record, record->data, KAA_ERR_BADPARAM);
+
+    KAA_FREE(record->data);
+    record->data = NULL;
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_log_storage_add_log_record(void *context, kaa_log_record_t *record)
+{
+    KAA_RETURN_IF_NIL3(context, record, record->data, KAA_ERR_BADPARAM);
+    ext_file_log_storage_t *self = (ext_file_log_storage_t *)context;
+
+    size_t full_size = KAA_LOG_RECORD_HEADER_SIZE + record->size;
+    if (!record->size || full_size > self->segment_size) {
+        KAA_LOG_WARN(self->logger, KAA_ERR_BADPARAM, "Log record of %zu bytes doesn't fit "
+                                        "the log segment of %zu bytes", record->size, self->segment_size);
+        return KAA_ERR_BADPARAM;
+    }
+
+    ext_file_log_segment_t *segment = self->last_segment_it
+            ? (ext_file_log_segment_t *) kaa_list_get_data(self->last_segment_it) : NULL;
+    if (!segment || self->write_fd < 0 || segment->size + full_size > self->segment_size) {
+        kaa_error_t error_code = segment_start(self);
+        KAA_RETURN_IF_ERR(error_code);
+        segment = (ext_file_log_segment_t *) kaa_list_get_data(self->last_segment_it);
+    }
+
+    ext_file_log_record_t *new_record = (ext_file_log_record_t *) KAA_MALLOC(sizeof(ext_file_log_record_t));
+    KAA_RETURN_IF_NIL(new_record, KAA_ERR_NOMEM);
+
+    new_record->segment_id = segment->id;
+    new_record->offset = segment->size;
+    new_record->size = record->size;
+    new_record->bucket_id = 0;
+
+    char header[KAA_LOG_RECORD_HEADER_SIZE];
+    record_header_write(header, record->size, crc32_calculate(record->data, record->size));
+
+    if (write_fully(self->write_fd, header, KAA_LOG_RECORD_HEADER_SIZE, segment->size)
+            || write_fully(self->write_fd, record->data, record->size, segment->size + KAA_LOG_RECORD_HEADER_SIZE)) {
+        KAA_LOG_ERROR(self->logger, KAA_ERR_WRITE_FAILED, "Failed to write log record to segment %u (errno %d)"
+                                                                                    , segment->id, errno);
+        /* Cut off the partial record, so that the next one is written at the proper position */
+        if (ftruncate(self->write_fd, segment->size)) {
+            close(self->write_fd);
+            self->write_fd = -1;
+        }
+        KAA_FREE(new_record);
+        return KAA_ERR_WRITE_FAILED;
+    }
+
+    if (++self->unsynced_records >= KAA_LOG_STORAGE_SYNC_INTERVAL) {
+        if (fdatasync(self->write_fd)) {
+            KAA_LOG_WARN(self->logger, KAA_ERR_WRITE_FAILED, "Failed to sync log segment %u (errno %d)"
+                                                                                    , segment->id, errno);
+        }
+        self->unsynced_records = 0;
+    }
+
+    kaa_list_t *it = self->logs
+            ? kaa_list_insert_after(self->last_log_it, new_record)
+            : (self->logs = kaa_list_create(new_record));
+    if (!it) {
+        /* The record is on disk already, so it will be restored after the restart */
+        KAA_FREE(new_record);
+        return KAA_ERR_NOMEM;
+    }
+
+    self->last_log_it = it;
+    self->occupied_size += new_record->size;
+    segment->size += full_size;
+    ++segment->alive_records;
+
+    KAA_FREE(record->data);
+    record->data = NULL;
+    record->size = 0;
+
+    return KAA_ERR_NONE;
+}
+
+
+
+static bool logs_list_find_by_bucket_id(void *log_record_p, void *bucket_id_p)
+{
+    return ((ext_file_log_record_t *)log_record_p)->bucket_id == *((uint16_t *)bucket_id_p);
+}
+
+
+
+kaa_error_t ext_log_storage_write_next_record(void *context
+                                            , char *buffer
+                                            , size_t buffer_len
+                                            , uint16_t bucket_id
+                                            , size_t *record_len)
+{
+    KAA_RETURN_IF_NIL5(context, buffer, buffer_len, bucket_id, record_len, KAA_ERR_BADPARAM);
+    ext_file_log_storage_t *self = (ext_file_log_storage_t *)context;
+
+    uint16_t zero_bucket_id = 0;
+    kaa_list_t *record_position = kaa_list_find_next(self->first_unmarked ? self->first_unmarked : self->logs
+                                                   , &logs_list_find_by_bucket_id
+                                                   , &zero_bucket_id);
+    if (!record_position) {
+        *record_len = 0;
+        return KAA_ERR_NOT_FOUND;
+    }
+
+    ext_file_log_record_t *record = (ext_file_log_record_t *) kaa_list_get_data(record_position);
+    *record_len = record->size;
+    if (*record_len > buffer_len)
+        return KAA_ERR_INSUFFICIENT_BUFFER;
+
+    if (self->read_fd < 0 || self->read_segment_id != record->segment_id) {
+        if (self->read_fd >= 0)
+            close(self->read_fd);
+        self->read_fd = segment_open(self, record->segment_id, O_RDONLY);
+        self->read_segment_id = record->segment_id;
+        if (self->read_fd < 0)
+            return KAA_ERR_READ_FAILED;
+    }
+
+    if (read_fully(self->read_fd, buffer, record->size, record->offset + KAA_LOG_RECORD_HEADER_SIZE) != record->size) {
+        KAA_LOG_ERROR(self->logger, KAA_ERR_READ_FAILED, "Failed to read log record (segment %u, offset %u)"
+                                                                        , record->segment_id, record->offset);
+        return KAA_ERR_READ_FAILED;
+    }
+
+    record->bucket_id = bucket_id;
+    self->first_unmarked = kaa_list_next(record_position);
+
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_log_storage_remove_by_bucket_id(void *context, uint16_t bucket_id)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    ext_file_log_storage_t *self = (ext_file_log_storage_t *)context;
+
+    kaa_list_t *record_position = kaa_list_find_next(self->logs, logs_list_find_by_bucket_id, &bucket_id);
+    if (!record_position)
+        return KAA_ERR_NOT_FOUND;
+
+    int fd = -1;
+    uint32_t fd_segment_id = 0;
+
+    while (record_position) {
+        ext_file_log_record_t *record = (ext_file_log_record_t *) kaa_list_get_data(record_position);
+        kaa_list_t *segment_it = segment_find(self, record->segment_id);
+        ext_file_log_segment_t *segment = segment_it ? (ext_file_log_segment_t *) kaa_list_get_data(segment_it) : NULL;
+
+        /* No need to touch the file which is going to be unlinked */
+        if (segment && segment->alive_records > 1) {
+            if (fd < 0 || fd_segment_id != record->segment_id) {
+                if (fd >= 0)
+                    close(fd);
+                fd = segment_open(self, record->segment_id, O_WRONLY);
+                fd_segment_id = record->segment_id;
+            }
+            record_mark_removed(self, fd, record);
+        } else if (fd >= 0 && fd_segment_id == record->segment_id) {
+            close(fd);
+            fd = -1;
+        }
+
+        record_position = record_remove(self, record_position);
+        record_position = kaa_list_find_next(record_position, &logs_list_find_by_bucket_id, &bucket_id);
+    }
+
+    if (fd >= 0)
+        close(fd);
+
+    if (!bucket_id)
+        self->first_unmarked = NULL;
+
+    return KAA_ERR_NONE;
+}
+
+
+
+kaa_error_t ext_log_storage_unmark_by_bucket_id(void *context, uint16_t bucket_id)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    ext_file_log_storage_t *self = (ext_file_log_storage_t *)context;
+
+    kaa_list_t *record_position = kaa_list_find_next(self->logs, logs_list_find_by_bucket_id, &bucket_id);
+    if (!record_position)
+        return KAA_ERR_NOT_FOUND;
+
+    while (record_position) {
+        ((ext_file_log_record_t *)kaa_list_get_data(record_position))->bucket_id = 0;
+        record_position = kaa_list_find_next(record_position, &logs_list_find_by_bucket_id, &bucket_id);
+    }
+    self->first_unmarked = NULL;
+
+    return KAA_ERR_NONE;
+}
+
+
+
+size_t ext_log_storage_get_total_size(const void *context)
+{
+    KAA_RETURN_IF_NIL(context, 0);
+    return ((ext_file_log_storage_t *)context)->occupied_size;
+}
+
+
+
+size_t ext_log_storage_get_records_count(const void *context)
+{
+    KAA_RETURN_IF_NIL(context, 0);
+    return kaa_list_get_size(((ext_file_log_storage_t *)context)->logs);
+}
+
+
+
+kaa_error_t ext_log_storage_destroy(void *context)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    ext_file_log_storage_t *self = (ext_file_log_storage_t *)context;
+
+    if (self->write_fd >= 0) {
+        fdatasync(self->write_fd);
+        close(self->write_fd);
+    }
+    if (self->read_fd >= 0)
+        close(self->read_fd);
+
+    kaa_list_destroy(self->logs, &list_data_destroy);
+    kaa_list_destroy(self->segments, &list_data_destroy);
+    KAA_FREE(self->directory);
+    KAA_FREE(self);
+    return KAA_ERR_NONE;
+}
+
+#endif
@@ -16,10 +16,15 @@
 
 #include "posix_file_utils.h"
 #include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "../../platform/stdio.h"
 #include "../../utilities/kaa_mem.h"
 #include "../../kaa_common.h"
 
+#define POSIX_TMP_FILE_SUFFIX   ".tmp"
+
 int posix_binary_file_read(const char *file_name, char **buffer, size_t *buffer_size, bool *needs_deallocation)
 {
     KAA_RETURN_IF_NIL4(file_name, buffer, buffer_size, needs_deallocation, -1);
@@ -56,15 +61,56 @@ int posix_binary_file_read(const char *file_name, char **buffer, size_t *buffer_
     return 0;
 }
 
+/* Syncs the directory holding the file, so that a rename in it is persisted. */
+static int posix_sync_parent_directory(const char *file_name)
+{
+    const char *separator = strrchr(file_name, '/');
+    size_t dir_name_length = (separator && separator != file_name) ? (size_t) (separator - file_name) : 1;
+
+    char *dir_name = (char *) KAA_MALLOC(dir_name_length + 1);
+    KAA_RETURN_IF_NIL(dir_name, -1);
+    if (separator)
+        memcpy(dir_name, file_name, dir_name_length);
+    else
+        dir_name[0] = '.';
+    dir_name[dir_name_length] = '\0';
+
+    int dir = open(dir_name, O_RDONLY);
+    KAA_FREE(dir_name);
+    if (dir < 0)
+        return -1;
+
+    int result = fsync(dir);
+    if (close(dir))
+        result = -1;
+    return result ? -1 : 0;
+}
+
 int posix_binary_file_store(const char *file_name, const char *buffer, size_t buffer_size)
 {
     KAA_RETURN_IF_NIL3(file_name, buffer, buffer_size, -1);
 
-    FILE* status_file = fopen(file_name, "wb");
-    if (status_file) {
-        fwrite(buffer, buffer_size, 1, status_file);
-        fclose(status_file);
-        return 0;
+    /* Write a temporary file, rename it over the target and sync the directory
+     * so that a power loss leaves either the old or the new content. */
+    size_t name_length = strlen(file_name);
+    char *tmp_file_name = (char *) KAA_MALLOC(name_length + sizeof(POSIX_TMP_FILE_SUFFIX));
+    KAA_RETURN_IF_NIL(tmp_file_name, -1);
+    memcpy(tmp_file_name, file_name, name_length);
+    memcpy(tmp_file_name + name_length, POSIX_TMP_FILE_SUFFIX, sizeof(POSIX_TMP_FILE_SUFFIX));
+
+    int result = -1;
+    FILE* file = fopen(tmp_file_name, "wb");
+    if (file) {
+        if (fwrite(buffer, buffer_size, 1, file) == 1 && !fflush(file) && !fsync(fileno(file)))
+            result = 0;
+        if (fclose(file))
+            result = -1;
+        if (!result && (rename(tmp_file_name, file_name) || posix_sync_parent_directory(file_name)))
+            result = -1;
+        if (result)
+            remove(tmp_file_name);
     }
-    return -1;
+
+    KAA_FREE(tmp_file_name);
+    return result;
 }
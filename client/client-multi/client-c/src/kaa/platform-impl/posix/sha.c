@@ -14,22 +14,77 @@
  * limitations under the License.
  */
 
-#include <openssl/sha.h>
+#include <openssl/evp.h>
 #include <stdint.h>
 #include "../../kaa_common.h"
 #include "../../platform/ext_sha.h"
 #include <string.h>
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new  EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#endif
+
 
 
 kaa_error_t ext_calculate_sha_hash(const char *data, size_t data_size, kaa_digest digest)
 {
-    KAA_RETURN_IF_NIL(digest, KAA_ERR_BADPARAM);
+    KAA_RETURN_IF_NIL3(data, data_size, digest, KAA_ERR_BADPARAM);
+
+    if (!EVP_Digest(data, data_size, digest, NULL, EVP_sha1(), NULL))
+        return KAA_ERR_BAD_STATE;
+    return KAA_ERR_NONE;
+}
+
+/*
+ * The context keeps a pointer to the OpenSSL digest context, which is allocated
+ * by ext_sha_hash_init() and released by ext_sha_hash_final().
+ */
+typedef char kaa_sha_context_size_check[(sizeof(EVP_MD_CTX *) <= KAA_SHA_CONTEXT_SIZE) ? 1 : -1];
+
+kaa_error_t ext_sha_hash_init(kaa_sha_context_t *context)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+
+    EVP_MD_CTX *md_context = EVP_MD_CTX_new();
+    KAA_RETURN_IF_NIL(md_context, KAA_ERR_NOMEM);
+
+    if (!EVP_DigestInit_ex(md_context, EVP_sha1(), NULL)) {
+        EVP_MD_CTX_free(md_context);
+        return KAA_ERR_BAD_STATE;
+    }
+
+    memcpy(context->state, &md_context, sizeof(md_context));
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t ext_sha_hash_update(kaa_sha_context_t *context, const char *data, size_t data_size)
+{
+    KAA_RETURN_IF_NIL(context, KAA_ERR_BADPARAM);
+    if (!data_size)
+        return KAA_ERR_NONE;
+    KAA_RETURN_IF_NIL(data, KAA_ERR_BADPARAM);
+
+    EVP_MD_CTX *md_context;
+    memcpy(&md_context, context->state, sizeof(md_context));
 
-    SHA1((const unsigned char *)data, data_size, digest);
+    if (!EVP_DigestUpdate(md_context, data, data_size))
+        return KAA_ERR_BAD_STATE;
     return KAA_ERR_NONE;
 }
 
+kaa_error_t ext_sha_hash_final(kaa_sha_context_t *context, kaa_digest digest)
+{
+    KAA_RETURN_IF_NIL2(context, digest, KAA_ERR_BADPARAM);
+
+    EVP_MD_CTX *md_context;
+    memcpy(&md_context, context->state, sizeof(md_context));
+
+    int result = EVP_DigestFinal_ex(md_context, digest, NULL);
+    EVP_MD_CTX_free(md_context);
+    return result ? KAA_ERR_NONE : KAA_ERR_BAD_STATE;
+}
+
 kaa_error_t ext_copy_sha_hash(kaa_digest_p dst, const kaa_digest_p src)
 {
     KAA_RETURN_IF_NIL2(dst, src, KAA_ERR_BADPARAM);
@@ -22,6 +22,8 @@
 #ifndef EXT_SHA_H_
 #define EXT_SHA_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include "../kaa_error.h"
 
 #ifdef __cplusplus
@@ -34,6 +36,20 @@ extern "C" {
 typedef unsigned char kaa_digest[SHA_1_DIGEST_LENGTH];
 typedef unsigned char* kaa_digest_p;
 
+/*
+ * Size reserved for the platform specific state of an incremental SHA1 calculation.
+ */
+#define KAA_SHA_CONTEXT_SIZE 128
+
+/*
+ * @brief Opaque state of an incremental SHA1 calculation.
+ * May be allocated on the stack, its content is owned by the platform implementation.
+ */
+typedef union {
+    uint64_t        alignment;
+    unsigned char   state[KAA_SHA_CONTEXT_SIZE];
+} kaa_sha_context_t;
+
 /*
  * @brief SHA1 hash calculation function.
  * SHA1 hash calculation function.
@@ -45,6 +61,36 @@ typedef unsigned char* kaa_digest_p;
  */
 kaa_error_t ext_calculate_sha_hash(const char *data, size_t data_size, kaa_digest digest);
 
+/*
+ * @brief Starts an incremental SHA1 calculation.
+ * A successfully initialized calculation must be completed with ext_sha_hash_final(),
+ * which releases the resources the platform may have allocated for it.
+ * @param[out]  context     SHA1 calculation state.
+ *
+ * @return kaa_error_t Error code.
+ */
+kaa_error_t ext_sha_hash_init(kaa_sha_context_t *context);
+
+/*
+ * @brief Feeds the next chunk of data into an incremental SHA1 calculation.
+ * @param[in]   context     SHA1 calculation state initialized by ext_sha_hash_init().
+ * @param[in]   data        Next chunk of data.
+ * @param[in]   data_size   Size of the chunk. May be 0.
+ *
+ * @return kaa_error_t Error code.
+ */
+kaa_error_t ext_sha_hash_update(kaa_sha_context_t *context, const char *data, size_t data_size);
+
+/*
+ * @brief Completes an incremental SHA1 calculation.
+ * The context must be initialized again before the next calculation.
+ * @param[in]   context     SHA1 calculation state.
+ * @param[out]  digest      SHA1 calculated digest.
+ *
+ * @return kaa_error_t Error code.
+ */
+kaa_error_t ext_sha_hash_final(kaa_sha_context_t *context, kaa_digest digest);
+
 /*
  * @brief Copy SHA1 digest.
  * Copy SHA1 digest from src to dst.
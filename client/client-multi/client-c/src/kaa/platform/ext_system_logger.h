@@ -44,7 +44,8 @@ time_t ext_get_systime();
 /**
  * @brief Put formated LOG prefix in buffer.
  * LOG prefix format example:
- *      1970/01/01 2:30:36 [TRACE] [kaa_bootstrap.c:38] (0) -
+ *      1970/01/01 2:30:36.042 [TRACE] [kaa_bootstrap.c:38] (0) -
+ * The format expects the date, the time with milliseconds, and then the rest of parameters.
  * @param[in,out]   buffer          Buffer to store formated log prefix.
  * @param[in]       buffer_size     Size of buffer.
  * @param[in]       format          Prefix format string.
@@ -13,6 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <stdbool.h>
+#include <string.h>
+
 #include "../platform/platform.h"
 #include "kaa_log.h"
 #include "../kaa_common.h"
@@ -21,7 +24,7 @@
 
 
 
-#define KAA_LOG_PREFIX_FORMAT   "%04d/%02d/%02d %d:%02d:%02d [%s] [%s:%d] (%d) - "
+#define KAA_LOG_PREFIX_FORMAT   "%04d/%02d/%02d %d:%02d:%02d.%03d [%s] [%s:%d] (%d) - "
 
 // minimal size = sizeof(char) + sizeof('\n')
 #define KAA_MINIMAL_BUFFER_SIZE 2
@@ -41,13 +44,102 @@ static const char* kaa_log_level_name[] =
     , "TRACE"
 };
 
+typedef struct {
+    char            name[KAA_LOG_MAX_MODULE_NAME_LENGTH + 1];
+    kaa_log_level_t log_level;
+} kaa_log_module_filter_t;
+
 struct kaa_logger_t {
-    FILE           *sink;
-    kaa_log_level_t max_log_level;
-    char           *log_buffer;
-    size_t          buffer_size;
+    FILE                           *sink;
+    kaa_log_level_t                 max_log_level;
+    kaa_log_level_t                 max_enabled_log_level;   /**< The most verbose level enabled by any filter */
+    char                           *log_buffer;
+    size_t                          buffer_size;
+    kaa_log_module_filter_t         module_filters[KAA_LOG_MAX_MODULE_FILTERS];
+    size_t                          module_filters_count;
+    kaa_log_batching_settings_t     batching;
+    char                           *batch_buffer;           /**< Pending lines, NULL if batching is off */
+    size_t                          batch_length;
+    kaa_time_t                      batch_start_time;       /**< Time the elder pending line was added */
 };
 
+
+
+static void kaa_log_update_max_enabled_log_level(kaa_logger_t *self)
+{
+    self->max_enabled_log_level = self->max_log_level;
+    size_t i;
+    for (i = 0; i < self->module_filters_count; ++i) {
+        if (self->module_filters[i].log_level > self->max_enabled_log_level)
+            self->max_enabled_log_level = self->module_filters[i].log_level;
+    }
+}
+
+
+
+/*
+ * Compares the source file name against the module name, ignoring the file extension.
+ */
+static bool kaa_log_is_module_file(const char *module, const char *file_name)
+{
+    size_t module_length = strlen(module);
+    return !strncmp(module, file_name, module_length)
+        && (file_name[module_length] == '.' || file_name[module_length] == '\0');
+}
+
+
+
+static kaa_log_level_t kaa_log_get_module_log_level(const kaa_logger_t *self, const char *file_name)
+{
+    size_t i;
+    for (i = 0; i < self->module_filters_count; ++i) {
+        if (kaa_log_is_module_file(self->module_filters[i].name, file_name))
+            return self->module_filters[i].log_level;
+    }
+    return self->max_log_level;
+}
+
+
+
+static void kaa_log_batch_write(kaa_logger_t *self)
+{
+    if (self->batch_length) {
+        ext_write_log(self->sink, self->batch_buffer, self->batch_length + 1);
+        self->batch_length = 0;
+        self->batch_buffer[0] = 0;
+    }
+}
+
+
+
+/*
+ * Appends the line to the pending ones. The line is written straight away if it doesn't fit the batch buffer.
+ */
+static void kaa_log_batch_append(kaa_logger_t *self, kaa_log_level_t log_level, const char *line, size_t line_length)
+{
+    if (self->batch_length + line_length + 1 > self->batching.buffer_size) {
+        kaa_log_batch_write(self);
+        if (line_length + 1 > self->batching.buffer_size) {
+            ext_write_log(self->sink, line, line_length + 1);
+            return;
+        }
+    }
+
+    kaa_time_t now = KAA_TIME();
+    if (!self->batch_length)
+        self->batch_start_time = now;
+
+    memcpy(self->batch_buffer + self->batch_length, line, line_length);
+    self->batch_length += line_length;
+    self->batch_buffer[self->batch_length] = 0;
+
+    if (self->batch_length >= self->batching.flush_size
+            || log_level <= self->batching.flush_log_level
+            || (self->batching.flush_timeout && (now - self->batch_start_time) >= self->batching.flush_timeout)) {
+        kaa_log_batch_write(self);
+    }
+}
+
 kaa_error_t kaa_log_create(kaa_logger_t **logger_p, size_t buffer_size, kaa_log_level_t max_log_level, FILE* sink)
 {
     if (!logger_p || (buffer_size < KAA_MINIMAL_BUFFER_SIZE) || (max_log_level > KAA_MAX_LOG_LEVEL))
@@ -67,6 +159,11 @@ kaa_error_t kaa_log_create(kaa_logger_t **logger_p, size_t buffer_size, kaa_log_
     (*logger_p)->buffer_size = buffer_size;
     (*logger_p)->sink = sink ? sink : stdout;
     (*logger_p)->max_log_level = max_log_level;
+    (*logger_p)->max_enabled_log_level = max_log_level;
+    (*logger_p)->module_filters_count = 0;
+    (*logger_p)->batch_buffer = NULL;
+    (*logger_p)->batch_length = 0;
+    (*logger_p)->batch_start_time = 0;
 #ifdef KAA_TRACE_MEMORY_ALLOCATIONS
     kaa_trace_memory_allocs_set_logger(*logger_p);
 #endif
@@ -79,6 +176,10 @@ kaa_error_t kaa_log_destroy(kaa_logger_t *logger)
 #ifdef KAA_TRACE_MEMORY_ALLOCATIONS
     kaa_trace_memory_allocs_set_logger(NULL);
 #endif
+    if (logger->batch_buffer) {
+        kaa_log_batch_write(logger);
+        KAA_FREE(logger->batch_buffer);
+    }
     KAA_FREE(logger->log_buffer);
     KAA_FREE(logger);
     return KAA_ERR_NONE;
@@ -96,6 +197,84 @@ kaa_error_t kaa_set_max_log_level(kaa_logger_t *self, kaa_log_level_t max_log_le
         return KAA_ERR_BADPARAM;
     }
     self->max_log_level = max_log_level;
+    kaa_log_update_max_enabled_log_level(self);
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t kaa_log_set_module_log_level(kaa_logger_t *self, const char *module, kaa_log_level_t log_level)
+{
+    KAA_RETURN_IF_NIL2(self, module, KAA_ERR_BADPARAM);
+    size_t module_length = strlen(module);
+    if (!module_length || module_length > KAA_LOG_MAX_MODULE_NAME_LENGTH || log_level > KAA_MAX_LOG_LEVEL) {
+        return KAA_ERR_BADPARAM;
+    }
+
+    size_t i;
+    for (i = 0; i < self->module_filters_count; ++i) {
+        if (!strcmp(self->module_filters[i].name, module))
+            break;
+    }
+
+    if (i == self->module_filters_count) {
+        if (self->module_filters_count == KAA_LOG_MAX_MODULE_FILTERS)
+            return KAA_ERR_INSUFFICIENT_BUFFER;
+        memcpy(self->module_filters[i].name, module, module_length + 1);
+        ++self->module_filters_count;
+    }
+
+    self->module_filters[i].log_level = log_level;
+    kaa_log_update_max_enabled_log_level(self);
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t kaa_log_reset_module_log_levels(kaa_logger_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    self->module_filters_count = 0;
+    kaa_log_update_max_enabled_log_level(self);
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t kaa_log_set_batching(kaa_logger_t *self, const kaa_log_batching_settings_t *settings)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+
+    if (!settings) {
+        if (self->batch_buffer) {
+            kaa_log_batch_write(self);
+            KAA_FREE(self->batch_buffer);
+            self->batch_buffer = NULL;
+        }
+        return KAA_ERR_NONE;
+    }
+
+    if (settings->buffer_size < self->buffer_size || settings->flush_size > settings->buffer_size
+            || settings->flush_log_level > KAA_MAX_LOG_LEVEL) {
+        return KAA_ERR_BADPARAM;
+    }
+
+    char *batch_buffer = (char *) KAA_MALLOC(settings->buffer_size * sizeof(char));
+    KAA_RETURN_IF_NIL(batch_buffer, KAA_ERR_NOMEM);
+
+    if (self->batch_buffer) {
+        kaa_log_batch_write(self);
+        KAA_FREE(self->batch_buffer);
+    }
+
+    self->batching = *settings;
+    if (!self->batching.flush_size)
+        self->batching.flush_size = self->batching.buffer_size;
+    self->batch_buffer = batch_buffer;
+    self->batch_buffer[0] = 0;
+    self->batch_length = 0;
+    return KAA_ERR_NONE;
+}
+
+kaa_error_t kaa_log_flush(kaa_logger_t *self)
+{
+    KAA_RETURN_IF_NIL(self, KAA_ERR_BADPARAM);
+    if (self->batch_buffer)
+        kaa_log_batch_write(self);
     return KAA_ERR_NONE;
 }
 
@@ -103,6 +282,8 @@ kaa_error_t kaa_log_set_sink(kaa_logger_t *self, FILE *sink)
 {
     KAA_RETURN_IF_NIL2(self, sink, KAA_ERR_BADPARAM);
 
+    if (self->batch_buffer)
+        kaa_log_batch_write(self);
     self->sink = sink;
 
     return KAA_ERR_NONE;
@@ -111,7 +292,7 @@ kaa_error_t kaa_log_set_sink(kaa_logger_t *self, FILE *sink)
 void kaa_log_write(kaa_logger_t *self, const char* source_file, int lineno, kaa_log_level_t log_level
         , kaa_error_t error_code, const char* format, ...)
 {
-    if (!self || (log_level > self->max_log_level))
+    if (!self || (log_level > self->max_enabled_log_level))
         return;
 
     // Truncate the file name
@@ -119,9 +300,9 @@ void kaa_log_write(kaa_logger_t *self, const char* source_file, int lineno, kaa_
     path_separator_pos = (path_separator_pos ? path_separator_pos : strrchr(source_file, '\\'));
     const char* truncated_name = (path_separator_pos ? path_separator_pos + 1 : source_file);
 
-    // Convert to UTC time
-    // TODO: Need to print milliseconds. For this purpose, timespec() from C11
-    // standard may be used, but GCC 4.6.4 doesn't support this API.
+    if (self->module_filters_count && log_level > kaa_log_get_module_log_level(self, truncated_name))
+        return;
+
     size_t consumed_len = 0;
 
     // Print log message prefix
@@ -156,6 +337,11 @@ void kaa_log_write(kaa_logger_t *self, const char* source_file, int lineno, kaa_
 
     // Terminate buffer with '\n','\0'. Null-termination is used with buffer length specified.
     self->log_buffer[consumed_len++] = '\n';
-    self->log_buffer[consumed_len++] = 0;
-    ext_write_log(self->sink, self->log_buffer, consumed_len);
+    self->log_buffer[consumed_len] = 0;
+
+    if (self->batch_buffer) {
+        kaa_log_batch_append(self, log_level, self->log_buffer, consumed_len);
+    } else {
+        ext_write_log(self->sink, self->log_buffer, consumed_len + 1);
+    }
 }
@@ -18,8 +18,9 @@
  * @file kaa_log.h
  * @brief Simple logger for Kaa C Endpoint.
  *
- * Supports runtime limitation of the maximum log level to be logged.
+ * Supports runtime limitation of the maximum log level to be logged, both globally and per module.
  * Expects externally provided and managed valid @c FILE* reference to log data to.
+ * Optionally batches log lines to write them to a slow sink in bulk.
  * Not thread safe.
  */
 
@@ -28,8 +29,14 @@
 
 #include "../kaa_error.h"
 #include "../platform/stdio.h"
+#include "../platform/time.h"
 #define KAA_MAX_LOG_MESSAGE_LENGTH  512
 
+/** Max number of modules with own log levels */
+#define KAA_LOG_MAX_MODULE_FILTERS      8
+/** Max length of a module name */
+#define KAA_LOG_MAX_MODULE_NAME_LENGTH  31
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -76,6 +83,18 @@ extern "C" {
  */
 typedef uint8_t kaa_log_level_t;
 
+/**
+ * @brief Log batching settings.
+ *
+ * Pending lines are written to the sink in one go once any of the thresholds is reached.
+ */
+typedef struct {
+    size_t          buffer_size;        /**< Size of the batch buffer. Must be not less than the log message buffer size */
+    size_t          flush_size;         /**< Number of pending bytes to flush at. @c 0 means @c buffer_size */
+    kaa_time_t      flush_timeout;      /**< Max age of the elder pending line, in @c KAA_TIME() units. @c 0 disables the check */
+    kaa_log_level_t flush_log_level;    /**< Lines of this or more severe level are flushed at once. Use @link KAA_LOG_LEVEL_NONE @endlink to disable */
+} kaa_log_batching_settings_t;
+
 /**
  * @brief Creates and initializes a logger instance.
  *
@@ -112,6 +131,50 @@ kaa_log_level_t kaa_get_max_log_level(const kaa_logger_t *self);
  */
 kaa_error_t kaa_set_max_log_level(kaa_logger_t *self, kaa_log_level_t max_log_level);
 
+/**
+ * @brief Sets the log level of a module, overriding the maximum log level for it.
+ *
+ * The module name is the name of the source file without extension, e.g. @c kaa_tcp_channel.
+ * Note that messages more verbose than @c KAA_MAX_LOG_LEVEL are compiled out.
+ *
+ * @param[in]   self            Pointer to a logger.
+ * @param[in]   module          Module name.
+ * @param[in]   log_level       Log level to be used for the module.
+ * @return                      Error code. @c KAA_ERR_INSUFFICIENT_BUFFER if there are
+ *                              @link KAA_LOG_MAX_MODULE_FILTERS @endlink modules with own log levels already.
+ */
+kaa_error_t kaa_log_set_module_log_level(kaa_logger_t *self, const char *module, kaa_log_level_t log_level);
+
+/**
+ * @brief Makes all modules use the maximum log level.
+ *
+ * @param[in]   self            Pointer to a logger.
+ * @return                      Error code.
+ */
+kaa_error_t kaa_log_reset_module_log_levels(kaa_logger_t *self);
+
+/**
+ * @brief Enables or disables batching of log lines.
+ *
+ * With batching on, log lines are collected in a buffer and written to the sink when any of the thresholds
+ * from @c settings is reached, or on @link kaa_log_flush @endlink. Since the time threshold is only checked
+ * when a new line is logged, call @link kaa_log_flush @endlink from the application idle loop to not keep
+ * lines pending for long.
+ *
+ * @param[in]   self            Pointer to a logger.
+ * @param[in]   settings        Batching settings. Pass @c NULL to flush pending lines and disable batching.
+ * @return                      Error code.
+ */
+kaa_error_t kaa_log_set_batching(kaa_logger_t *self, const kaa_log_batching_settings_t *settings);
+
+/**
+ * @brief Writes pending log lines to the sink.
+ *
+ * @param[in]   self            Pointer to a logger.
+ * @return                      Error code.
+ */
+kaa_error_t kaa_log_flush(kaa_logger_t *self);
+
 /**
  * @brief Sets user sink for log output.
  *
@@ -125,7 +188,7 @@ kaa_error_t kaa_log_set_sink(kaa_logger_t *self, FILE *sink);
  * @brief Compiles a log message and puts it into the sink.
  *
  * The message format is as follows:
- * @code YYYY/MM/DD HH:MM:SS [LOG LEVEL] [FILE:LINENO] (ERROR_CODE) - MESSAGE @endcode
+ * @code YYYY/MM/DD HH:MM:SS.mmm [LOG LEVEL] [FILE:LINENO] (ERROR_CODE) - MESSAGE @endcode
  *
  * <b>NOTE:</b> Do not use directly. Use one of @link KAA_LOG_FATAL @endlink,
  * @link KAA_LOG_ERROR @endlink, @link KAA_LOG_WARN @endlink,
@@ -133,6 +196,7 @@ kaa_error_t kaa_log_set_sink(kaa_logger_t *self, FILE *sink);
  * @link KAA_LOG_TRACE @endlink macros instead.
  *
  * The log message gets truncated if it is longer than @c buffer_size specified to @link kaa_log_create @endlink.
+ * If batching is enabled, the message is put to the batch buffer instead of the sink.
  *
  * @param[in] self          Pointer to a logger.
  * @param[in] source_file   The source file that the message is logged from.
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file kaa_lzf.c
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../kaa_common.h"
+#include "kaa_lzf.h"
+
+
+
+#define KAA_LZF_MAX_LITERAL_RUN    32
+#define KAA_LZF_MIN_MATCH          3
+#define KAA_LZF_MAX_MATCH          (KAA_LZF_MIN_MATCH - 1 + 7 + 0xFF)
+#define KAA_LZF_MAX_DISTANCE       (1 << 13)
+
+#define KAA_LZF_HASH(p) \
+    ((((uint32_t) (p)[0] << 16 | (uint32_t) (p)[1] << 8 | (uint32_t) (p)[2]) * 2654435761U) >> (32 - KAA_LZF_HASH_LOG))
+
+
+
+kaa_error_t kaa_lzf_compress(const char *in, size_t in_size, char *out, size_t *out_size, void *work_memory)
+{
+    KAA_RETURN_IF_NIL5(in, in_size, out, out_size, work_memory, KAA_ERR_BADPARAM);
+
+    uint32_t *hash_table = (uint32_t *) work_memory;
+    memset(hash_table, 0, KAA_LZF_WORK_MEMORY_SIZE);
+
+    const uint8_t *in_begin = (const uint8_t *) in;
+    const uint8_t *in_end = in_begin + in_size;
+    const uint8_t *ip = in_begin;
+
+    uint8_t *op = (uint8_t *) out;
+    uint8_t *out_end = op + *out_size;
+
+    if (op == out_end)
+        return KAA_ERR_BUFFER_IS_NOT_ENOUGH;
+
+    uint8_t *literal_control = op++;
+    size_t literal_count = 0;
+
+    while (ip < in_end) {
+        if (ip + KAA_LZF_MIN_MATCH <= in_end) {
+            uint32_t hash = KAA_LZF_HASH(ip);
+            const uint8_t *ref = in_begin + hash_table[hash];
+            hash_table[hash] = (uint32_t) (ip - in_begin);
+
+            if (ref < ip && (size_t) (ip - ref) <= KAA_LZF_MAX_DISTANCE
+                    && ref[0] == ip[0] && ref[1] == ip[1] && ref[2] == ip[2]) {
+                size_t max_length = in_end - ip;
+                if (max_length > KAA_LZF_MAX_MATCH)
+                    max_length = KAA_LZF_MAX_MATCH;
+
+                size_t length = KAA_LZF_MIN_MATCH;
+                while (length < max_length && ref[length] == ip[length])
+                    ++length;
+
+                // Back reference takes up to 3 bytes plus the control byte of the next literal run
+                if (literal_count)
+                    *literal_control = (uint8_t) (literal_count - 1);
+                else
+                    --op;
+                if (op + 4 > out_end)
+                    return KAA_ERR_BUFFER_IS_NOT_ENOUGH;
+
+                size_t distance = ip - ref - 1;
+                size_t encoded_length = length - 2;
+                if (encoded_length < 7) {
+                    *op++ = (uint8_t) ((encoded_length << 5) | (distance >> 8));
+                } else {
+                    *op++ = (uint8_t) ((7 << 5) | (distance >> 8));
+                    *op++ = (uint8_t) (encoded_length - 7);
+                }
+                *op++ = (uint8_t) distance;
+
+                const uint8_t *match_end = ip + length;
+                for (++ip; ip < match_end && ip + KAA_LZF_MIN_MATCH <= in_end; ++ip)
+                    hash_table[KAA_LZF_HASH(ip)] = (uint32_t) (ip - in_begin);
+
+                ip = match_end;
+                literal_count = 0;
+                literal_control = op++;
+                continue;
+            }
+        }
+
+        if (op == out_end)
+            return KAA_ERR_BUFFER_IS_NOT_ENOUGH;
+        *op++ = *ip++;
+
+        if (++literal_count == KAA_LZF_MAX_LITERAL_RUN) {
+            *literal_control = KAA_LZF_MAX_LITERAL_RUN - 1;
+            literal_count = 0;
+            if (op == out_end)
+                return KAA_ERR_BUFFER_IS_NOT_ENOUGH;
+            literal_control = op++;
+        }
+    }
+
+    if (literal_count)
+        *literal_control = (uint8_t) (literal_count - 1);
+    else
+        --op;
+
+    *out_size = op - (uint8_t *) out;
+    return KAA_ERR_NONE;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file kaa_lzf.h
+ *
+ * @brief Dependency-free LZF compression
+ *
+ * Produces the LZF stream format (LZ77 family, as used by liblzf):
+ *  - 000LLLLL                      - literal run of L + 1 bytes following the control byte;
+ *  - LLLOOOOO OOOOOOOO             - back reference of L + 2 bytes at distance O + 1;
+ *  - 111OOOOO LLLLLLLL OOOOOOOO    - back reference of L + 9 bytes at distance O + 1.
+ */
+
+#ifndef KAA_LZF_H_
+#define KAA_LZF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../kaa_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef KAA_LZF_HASH_LOG
+/* Log2 of the number of hash table entries. Smaller values save memory at the cost of compression ratio. */
+# define KAA_LZF_HASH_LOG       10
+#endif
+
+/** Size of the work memory needed by @link kaa_lzf_compress @endlink */
+#define KAA_LZF_WORK_MEMORY_SIZE   ((1 << KAA_LZF_HASH_LOG) * sizeof(uint32_t))
+
+/**
+ * @brief Compresses data
+ *
+ * @param[in]       in              Data to compress.
+ * @param[in]       in_size         Size of the data to compress.
+ * @param[out]      out             Output buffer.
+ * @param[in,out]   out_size        Size of the output buffer on [in] and size of compressed data on [out].
+ * @param[in]       work_memory     Memory of @link KAA_LZF_WORK_MEMORY_SIZE @endlink bytes aligned for @c uint32_t.
+ *
+ * @return Error code. @c KAA_ERR_BUFFER_IS_NOT_ENOUGH if the compressed data doesn't fit the output buffer.
+ */
+kaa_error_t kaa_lzf_compress(const char *in, size_t in_size, char *out, size_t *out_size, void *work_memory);
+
+#ifdef __cplusplus
+}      /* extern "C" */
+#endif
+
+#endif /* KAA_LZF_H_ */
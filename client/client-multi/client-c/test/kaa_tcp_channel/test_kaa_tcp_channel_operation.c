@@ -349,6 +349,64 @@ void test_kaa_tcp_channel_io_error_flow()
     KAA_TRACE_OUT(logger);
 }
 
+/**
+ * Test keepalive settings:
+ *  1. Set access point, authorize.
+ *  2. Check the keepalive deadline does not exceed the ping interval and no PING is sent right after CONNECT.
+ *  3. Check ping interval bounds validation and that the deadline follows the new bounds.
+ */
+void test_kaa_tcp_channel_keepalive_flow()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_error_t error_code;
+
+    kaa_transport_channel_interface_t *channel = NULL;
+    channel = KAA_CALLOC(1,sizeof(kaa_transport_channel_interface_t));
+
+    kaa_service_t operation_services[] = {
+            KAA_SERVICE_PROFILE,
+            KAA_SERVICE_USER,
+            KAA_SERVICE_EVENT,
+            KAA_SERVICE_LOGGING};
+
+    error_code = kaa_tcp_channel_create(channel, logger, operation_services, 4);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    test_set_access_point(channel);
+
+    test_check_channel_auth(channel);
+
+    uint16_t max_timeout = 0;
+    error_code = kaa_tcp_channel_get_max_timeout(channel, &max_timeout);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_TRUE(max_timeout > 0 && max_timeout <= KEEPALIVE / 2);
+
+    //CONNECT was just sent, so PING isn't due yet
+    error_code = kaa_tcp_channel_check_keepalive(channel);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    CHECK_SOCKET_RW(channel, true, false);
+
+    ASSERT_EQUAL(kaa_tcp_channel_set_keepalive_bounds(channel, 0, 10), KAA_ERR_BADPARAM);
+    ASSERT_EQUAL(kaa_tcp_channel_set_keepalive_bounds(channel, 20, 10), KAA_ERR_BADPARAM);
+    ASSERT_EQUAL(kaa_tcp_channel_set_keepalive_bounds(channel, 10, KEEPALIVE + 1), KAA_ERR_BADPARAM);
+
+    error_code = kaa_tcp_channel_set_keepalive_bounds(channel, 10, 100);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = kaa_tcp_channel_get_max_timeout(channel, &max_timeout);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_TRUE(max_timeout > 0 && max_timeout <= 100);
+
+    test_send_disconnect(channel);
+
+    channel->destroy(channel->context);
+
+    KAA_FREE(channel);
+
+    KAA_TRACE_OUT(logger);
+}
+
 /**
  * Test authorization sequence according to bug KAA-362
  * 1. Set access point
@@ -934,4 +992,5 @@ KAA_SUITE_MAIN(Log, test_init, test_deinit,
         KAA_TEST_CASE(create_kaa_tcp_channel_sync_flow, test_kaa_tcp_channel_sync_flow)
         KAA_TEST_CASE(create_kaa_tcp_channel_io_error_flow, test_kaa_tcp_channel_io_error_flow)
         KAA_TEST_CASE(create_kaa_tcp_channel_auth_double_sync_flow, test_kaa_tcp_channel_auth_double_sync_flow)
+        KAA_TEST_CASE(create_kaa_tcp_channel_keepalive_flow, test_kaa_tcp_channel_keepalive_flow)
         )
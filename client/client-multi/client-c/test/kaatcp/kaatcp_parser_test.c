@@ -15,6 +15,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 
@@ -103,6 +104,93 @@ void test_kaatcp_parser()
     KAA_TRACE_OUT(logger);
 }
 
+static const char *zero_copy_buffer = NULL;
+
+void kaasync_zero_copy_listener(void *context, kaatcp_kaasync_t *message)
+{
+    ++kaasync_received;
+
+    ASSERT_EQUAL(message->sync_header.message_id, 5);
+    ASSERT_EQUAL(message->sync_request_size, 1);
+    ASSERT_EQUAL((uint8_t)message->sync_request[0], 0xFF);
+
+    if (zero_copy_buffer) {
+        ASSERT_EQUAL(message->sync_request, zero_copy_buffer + 14);
+    }
+}
+
+void test_kaatcp_parser_zero_copy()
+{
+    KAA_TRACE_IN(logger);
+
+    kaatcp_parser_handlers_t handlers = { NULL, &connack_listener, &disconnect_listener, &kaasync_zero_copy_listener, &ping_listener };
+    kaatcp_parser_t parser;
+
+    kaatcp_error_t rval = kaatcp_parser_init(&parser, &handlers);
+    ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+    rval = kaatcp_parser_set_zero_copy(&parser, 1);
+    ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+
+    unsigned char kaa_sync_message[] = { 0xF0, 0x0D, 0x00, 0x06, 'K', 'a', 'a', 't', 'c', 'p', 0x01, 0x00, 0x05, 0x14, 0xFF,
+                                         0xF0, 0x0D, 0x00, 0x06, 'K', 'a', 'a', 't', 'c', 'p', 0x01, 0x00, 0x05, 0x14, 0xFF };
+
+    //Contiguous frame: payload is a slice of the input buffer
+    kaasync_received = 0;
+    zero_copy_buffer = (const char *) kaa_sync_message;
+    rval = kaatcp_parser_process_buffer(&parser, (const char *) kaa_sync_message, 15);
+    ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+    ASSERT_EQUAL(kaasync_received, 1);
+
+    //Frame split between reads: payload is assembled by the parser
+    zero_copy_buffer = NULL;
+    rval = kaatcp_parser_process_buffer(&parser, (const char *) kaa_sync_message, 20);
+    ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+    ASSERT_EQUAL(kaasync_received, 2);
+    rval = kaatcp_parser_process_buffer(&parser, (const char *) kaa_sync_message + 20, 10);
+    ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+    ASSERT_EQUAL(kaasync_received, 3);
+
+    KAA_TRACE_OUT(logger);
+}
+
+void test_kaatcp_parser_zero_copy_short_frames()
+{
+    KAA_TRACE_IN(logger);
+
+    kaatcp_parser_handlers_t handlers = { NULL, &connack_listener, &disconnect_listener, &kaasync_zero_copy_listener, &ping_listener };
+    kaatcp_parser_t parser;
+
+    const unsigned char short_frames[][3] = { { 0x20, 0x00 }, { 0x20, 0x01, 0x00 }, { 0xE0, 0x00 }, { 0xE0, 0x01, 0x00 } };
+    const size_t short_frame_sizes[] = { 2, 3, 2, 3 };
+
+    connack_received = 0;
+    disconnect_received = 0;
+
+    for (size_t i = 0; i < sizeof(short_frame_sizes) / sizeof(short_frame_sizes[0]); ++i) {
+        kaatcp_error_t rval = kaatcp_parser_init(&parser, &handlers);
+        ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+        rval = kaatcp_parser_set_zero_copy(&parser, 1);
+        ASSERT_EQUAL(rval, KAATCP_ERR_NONE);
+
+        /*
+         * The frame ends the buffer, so reading past its payload is caught by memory checkers.
+         */
+        char *buffer = (char *) malloc(short_frame_sizes[i]);
+        ASSERT_NOT_NULL(buffer);
+        memcpy(buffer, short_frames[i], short_frame_sizes[i]);
+
+        rval = kaatcp_parser_process_buffer(&parser, buffer, short_frame_sizes[i]);
+        ASSERT_EQUAL(rval, KAATCP_ERR_INVALID_PROTOCOL);
+
+        free(buffer);
+    }
+
+    ASSERT_EQUAL(connack_received, 0);
+    ASSERT_EQUAL(disconnect_received, 0);
+
+    KAA_TRACE_OUT(logger);
+}
+
 int test_init(void)
 {
     kaa_error_t error = kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
@@ -122,5 +210,7 @@ int test_deinit(void)
 KAA_SUITE_MAIN(Log, test_init, test_deinit
        ,
        KAA_TEST_CASE(kaatcp_parser, test_kaatcp_parser)
+       KAA_TEST_CASE(kaatcp_parser_zero_copy, test_kaatcp_parser_zero_copy)
+       KAA_TEST_CASE(kaatcp_parser_zero_copy_short_frames, test_kaatcp_parser_zero_copy_short_frames)
 )
 
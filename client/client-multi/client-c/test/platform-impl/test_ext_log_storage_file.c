@@ -0,0 +1,390 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "../kaa_test.h"
+
+#include "kaa_common.h"
+#include "utilities/kaa_mem.h"
+#include "utilities/kaa_log.h"
+
+#include "platform/ext_log_storage.h"
+
+
+
+#define TEST_LOG_DIRECTORY      "test_file_log_storage"
+#define TEST_SEGMENT_SIZE       64
+#define TEST_MAX_SEGMENTS       3
+#define TEST_RECORD_FULL_SIZE   16  /* 12-byte header + 4-byte data */
+
+
+
+extern kaa_error_t ext_file_log_storage_create(void **log_storage_context_p, kaa_logger_t *logger, const char *directory);
+extern kaa_error_t ext_limited_file_log_storage_create(void **log_storage_context_p
+                                                     , kaa_logger_t *logger
+                                                     , const char *directory
+                                                     , size_t segment_size
+                                                     , size_t max_segments);
+extern kaa_error_t ext_log_storage_destroy(void *context);
+
+
+
+static kaa_logger_t *logger = NULL;
+
+
+
+static void clean_log_directory()
+{
+    DIR *dir = opendir(TEST_LOG_DIRECTORY);
+    if (!dir)
+        return;
+
+    struct dirent *entry;
+    char path[512];
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.')
+            continue;
+        snprintf(path, sizeof(path), "%s/%s", TEST_LOG_DIRECTORY, entry->d_name);
+        unlink(path);
+    }
+    closedir(dir);
+    rmdir(TEST_LOG_DIRECTORY);
+}
+
+static size_t count_segment_files()
+{
+    DIR *dir = opendir(TEST_LOG_DIRECTORY);
+    KAA_RETURN_IF_NIL(dir, 0);
+
+    size_t count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        if (strstr(entry->d_name, ".seg"))
+            ++count;
+    }
+    closedir(dir);
+    return count;
+}
+
+static char* copy_data(const char* data, size_t data_size)
+{
+    KAA_RETURN_IF_NIL2(data, data_size, NULL);
+    char *new_data = (char *)KAA_MALLOC(data_size);
+    KAA_RETURN_IF_NIL(new_data, NULL);
+    memcpy(new_data, data, data_size);
+    return new_data;
+}
+
+static kaa_error_t add_log_record(void *storage, const char *data, size_t data_size)
+{
+    KAA_RETURN_IF_NIL3(storage, data, data_size, KAA_ERR_BADPARAM);
+    kaa_log_record_t record = { copy_data(data, data_size), data_size };
+    kaa_error_t error_code = ext_log_storage_add_log_record(storage, &record);
+    if (error_code)
+        KAA_FREE(record.data);
+    return error_code;
+}
+
+static void *create_test_storage()
+{
+    void *storage = NULL;
+    kaa_error_t error_code = ext_limited_file_log_storage_create(&storage, logger, TEST_LOG_DIRECTORY
+                                                              , TEST_SEGMENT_SIZE, TEST_MAX_SEGMENTS);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    return storage;
+}
+
+
+
+void test_create_storage()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_error_t error_code;
+    void *storage;
+
+    error_code = ext_file_log_storage_create(NULL, NULL, NULL);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = ext_file_log_storage_create(&storage, logger, NULL);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = ext_limited_file_log_storage_create(&storage, logger, TEST_LOG_DIRECTORY, 0, TEST_MAX_SEGMENTS);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = ext_limited_file_log_storage_create(&storage, logger, TEST_LOG_DIRECTORY, 8, TEST_MAX_SEGMENTS);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = ext_limited_file_log_storage_create(&storage, logger, TEST_LOG_DIRECTORY, TEST_SEGMENT_SIZE, 0);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = ext_file_log_storage_create(&storage, logger, TEST_LOG_DIRECTORY);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 0);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_add_and_write_next_record()
+{
+    KAA_TRACE_IN(logger);
+
+    void *storage = create_test_storage();
+
+    const char *data = "DATA";
+    size_t data_size = strlen("DATA");
+    char big_data[TEST_SEGMENT_SIZE];
+    memset(big_data, 'x', sizeof(big_data));
+
+    ASSERT_EQUAL(add_log_record(storage, big_data, sizeof(big_data)), KAA_ERR_BADPARAM);
+    ASSERT_EQUAL(add_log_record(storage, data, data_size), KAA_ERR_NONE);
+    ASSERT_EQUAL(add_log_record(storage, "ATAD", data_size), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 2);
+    ASSERT_EQUAL(ext_log_storage_get_total_size(storage), 2 * data_size);
+
+    char buffer[2 * data_size];
+    size_t record_len = 0;
+
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, 1, 1, &record_len), KAA_ERR_INSUFFICIENT_BUFFER);
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(record_len, data_size);
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer + data_size, data_size, 1, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NOT_FOUND);
+
+    ASSERT_EQUAL(memcmp(buffer, "DATAATAD", sizeof(buffer)), 0);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_remove_and_unmark_by_bucket_id()
+{
+    KAA_TRACE_IN(logger);
+
+    void *storage = create_test_storage();
+
+    const char *data = "DATA";
+    size_t data_size = strlen("DATA");
+    size_t record_count = 6;
+    size_t i;
+    for (i = 0; i < record_count; ++i)
+        ASSERT_EQUAL(add_log_record(storage, data, data_size), KAA_ERR_NONE);
+
+    /* 4 records per segment */
+    ASSERT_EQUAL(count_segment_files(), 2);
+
+    char buffer[data_size];
+    size_t record_len = 0;
+    for (i = 0; i < 4; ++i)
+        ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NONE);
+    for (i = 0; i < 2; ++i)
+        ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 2, &record_len), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(ext_log_storage_unmark_by_bucket_id(storage, 2), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_unmark_by_bucket_id(storage, 2), KAA_ERR_NOT_FOUND);
+
+    ASSERT_EQUAL(ext_log_storage_remove_by_bucket_id(storage, 1), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 2);
+    ASSERT_EQUAL(ext_log_storage_get_total_size(storage), 2 * data_size);
+    ASSERT_EQUAL(count_segment_files(), 1);
+
+    for (i = 0; i < 2; ++i)
+        ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 3, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_remove_by_bucket_id(storage, 3), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 0);
+    ASSERT_EQUAL(count_segment_files(), 0);
+
+    ASSERT_EQUAL(add_log_record(storage, data, data_size), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 1);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_recover_after_restart()
+{
+    KAA_TRACE_IN(logger);
+
+    void *storage = create_test_storage();
+
+    size_t i;
+    char data[4] = { 'D', 'A', 'T', '0' };
+    for (i = 0; i < 6; ++i) {
+        data[3] = '0' + i;
+        ASSERT_EQUAL(add_log_record(storage, data, sizeof(data)), KAA_ERR_NONE);
+    }
+
+    char buffer[sizeof(data)];
+    size_t record_len = 0;
+
+    /* Acknowledged records mustn't come back, the ones in flight must be unmarked */
+    for (i = 0; i < 2; ++i)
+        ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 2, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_remove_by_bucket_id(storage, 1), KAA_ERR_NONE);
+
+    ext_log_storage_destroy(storage);
+    storage = create_test_storage();
+
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 4);
+    ASSERT_EQUAL(ext_log_storage_get_total_size(storage), 4 * sizeof(data));
+
+    for (i = 2; i < 6; ++i) {
+        ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NONE);
+        ASSERT_EQUAL(buffer[3], (char)('0' + i));
+    }
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NOT_FOUND);
+
+    /* New records are appended after the restored ones */
+    ASSERT_EQUAL(add_log_record(storage, "NEXT", 4), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 2, &record_len), KAA_ERR_NONE);
+    ASSERT_EQUAL(memcmp(buffer, "NEXT", 4), 0);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_truncate_torn_record()
+{
+    KAA_TRACE_IN(logger);
+
+    void *storage = create_test_storage();
+
+    ASSERT_EQUAL(add_log_record(storage, "DAT1", 4), KAA_ERR_NONE);
+    ASSERT_EQUAL(add_log_record(storage, "DAT2", 4), KAA_ERR_NONE);
+    ext_log_storage_destroy(storage);
+
+    /* Simulate the crash in the middle of the second record write */
+    int fd = open(TEST_LOG_DIRECTORY "/kaa_logs_00000000.seg", O_WRONLY);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQUAL(ftruncate(fd, TEST_RECORD_FULL_SIZE + 6), 0);
+    close(fd);
+
+    storage = create_test_storage();
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 1);
+
+    struct stat file_stat;
+    ASSERT_EQUAL(stat(TEST_LOG_DIRECTORY "/kaa_logs_00000000.seg", &file_stat), 0);
+    ASSERT_EQUAL(file_stat.st_size, TEST_RECORD_FULL_SIZE);
+
+    ASSERT_EQUAL(add_log_record(storage, "DAT3", 4), KAA_ERR_NONE);
+    ext_log_storage_destroy(storage);
+
+    /* Corrupt the data of the first record */
+    fd = open(TEST_LOG_DIRECTORY "/kaa_logs_00000000.seg", O_WRONLY);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQUAL(pwrite(fd, "X", 1, TEST_RECORD_FULL_SIZE - 1), 1);
+    close(fd);
+
+    storage = create_test_storage();
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), 0);
+    ASSERT_EQUAL(count_segment_files(), 0);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_remove_elder_segment()
+{
+    KAA_TRACE_IN(logger);
+
+    void *storage = create_test_storage();
+
+    size_t records_per_segment = TEST_SEGMENT_SIZE / TEST_RECORD_FULL_SIZE;
+    size_t i;
+    for (i = 0; i < TEST_MAX_SEGMENTS * records_per_segment; ++i)
+        ASSERT_EQUAL(add_log_record(storage, "DATA", 4), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(count_segment_files(), TEST_MAX_SEGMENTS);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), TEST_MAX_SEGMENTS * records_per_segment);
+
+    char buffer[4];
+    size_t record_len = 0;
+    ASSERT_EQUAL(ext_log_storage_write_next_record(storage, buffer, sizeof(buffer), 1, &record_len), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(add_log_record(storage, "DATA", 4), KAA_ERR_NONE);
+    ASSERT_EQUAL(count_segment_files(), TEST_MAX_SEGMENTS);
+    ASSERT_EQUAL(ext_log_storage_get_records_count(storage), (TEST_MAX_SEGMENTS - 1) * records_per_segment + 1);
+
+    /* The record of the bucket was removed along with its segment */
+    ASSERT_EQUAL(ext_log_storage_remove_by_bucket_id(storage, 1), KAA_ERR_NOT_FOUND);
+
+    ext_log_storage_destroy(storage);
+    clean_log_directory();
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+int test_init()
+{
+    kaa_error_t error = kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
+    if (error || !logger) {
+        return error;
+    }
+
+    clean_log_directory();
+    return 0;
+}
+
+int test_deinit()
+{
+    clean_log_directory();
+    kaa_log_destroy(logger);
+    return 0;
+}
+
+
+
+KAA_SUITE_MAIN(FileLogStorage, test_init, test_deinit,
+        KAA_TEST_CASE(create_storage, test_create_storage)
+        KAA_TEST_CASE(add_and_write_next_record, test_add_and_write_next_record)
+        KAA_TEST_CASE(remove_and_unmark_by_bucket_id, test_remove_and_unmark_by_bucket_id)
+        KAA_TEST_CASE(recover_after_restart, test_recover_after_restart)
+        KAA_TEST_CASE(truncate_torn_record, test_truncate_torn_record)
+        KAA_TEST_CASE(remove_elder_segment, test_remove_elder_segment)
+)
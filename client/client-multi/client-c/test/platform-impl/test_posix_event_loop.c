@@ -0,0 +1,218 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "../kaa_test.h"
+
+#include "kaa_common.h"
+#include "utilities/kaa_mem.h"
+#include "utilities/kaa_log.h"
+#include "platform-impl/kaa_tcp_channel.h"
+#include "platform-impl/posix/posix_event_loop.h"
+
+
+
+#define TEST_TIMER_INTERVAL     20
+
+
+
+static kaa_logger_t *logger = NULL;
+
+
+
+typedef struct {
+    posix_event_loop_t *loop;
+    size_t              fired_count;
+    size_t              stop_after;
+    uint32_t            timer_to_remove;
+} test_timer_context_t;
+
+static void test_timer_callback(void *context)
+{
+    test_timer_context_t *timer_context = (test_timer_context_t *) context;
+    ++timer_context->fired_count;
+
+    if (timer_context->timer_to_remove) {
+        posix_event_loop_remove_timer(timer_context->loop, timer_context->timer_to_remove);
+        timer_context->timer_to_remove = 0;
+    }
+
+    if (timer_context->stop_after && timer_context->fired_count >= timer_context->stop_after)
+        posix_event_loop_stop(timer_context->loop);
+}
+
+static uint64_t test_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+
+
+void test_create_loop()
+{
+    KAA_TRACE_IN(logger);
+
+    posix_event_loop_t *loop = NULL;
+
+    ASSERT_NOT_EQUAL(posix_event_loop_create(NULL, logger), KAA_ERR_NONE);
+    ASSERT_NOT_EQUAL(posix_event_loop_create(&loop, NULL), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(posix_event_loop_create(&loop, logger), KAA_ERR_NONE);
+    ASSERT_NOT_NULL(loop);
+
+    /* Nothing to wait for */
+    ASSERT_EQUAL(posix_event_loop_run_once(loop, 0), KAA_ERR_NONE);
+
+    posix_event_loop_destroy(loop);
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_one_shot_timer()
+{
+    KAA_TRACE_IN(logger);
+
+    posix_event_loop_t *loop = NULL;
+    ASSERT_EQUAL(posix_event_loop_create(&loop, logger), KAA_ERR_NONE);
+
+    test_timer_context_t context = { loop, 0, 0, 0 };
+    uint32_t timer_id = 0;
+
+    kaa_error_t error_code = posix_event_loop_add_timer(loop, 0, false, &test_timer_callback, &context, &timer_id);
+    ASSERT_NOT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_NOT_EQUAL(posix_event_loop_add_timer(loop, TEST_TIMER_INTERVAL, false, NULL, &context, &timer_id), KAA_ERR_NONE);
+
+    error_code = posix_event_loop_add_timer(loop, TEST_TIMER_INTERVAL, false, &test_timer_callback, &context, &timer_id);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    /* The loop sleeps until the timer deadline instead of returning early */
+    uint64_t start = test_now();
+    ASSERT_EQUAL(posix_event_loop_run_once(loop, POSIX_EVENT_LOOP_WAIT_INFINITE), KAA_ERR_NONE);
+    ASSERT_TRUE(test_now() - start >= TEST_TIMER_INTERVAL);
+    ASSERT_EQUAL(context.fired_count, 1);
+
+    ASSERT_EQUAL(posix_event_loop_run_once(loop, 2 * TEST_TIMER_INTERVAL), KAA_ERR_NONE);
+    ASSERT_EQUAL(context.fired_count, 1);
+    ASSERT_EQUAL(posix_event_loop_remove_timer(loop, timer_id), KAA_ERR_NOT_FOUND);
+
+    posix_event_loop_destroy(loop);
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_repeated_timer()
+{
+    KAA_TRACE_IN(logger);
+
+    posix_event_loop_t *loop = NULL;
+    ASSERT_EQUAL(posix_event_loop_create(&loop, logger), KAA_ERR_NONE);
+
+    test_timer_context_t repeated = { loop, 0, 3, 0 };
+    test_timer_context_t removed = { loop, 0, 0, 0 };
+    uint32_t removed_timer_id = 0;
+
+    kaa_error_t error_code = posix_event_loop_add_timer(loop, TEST_TIMER_INTERVAL, true, &test_timer_callback, &repeated, NULL);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    error_code = posix_event_loop_add_timer(loop, 2 * TEST_TIMER_INTERVAL, true, &test_timer_callback, &removed
+                                          , &removed_timer_id);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    /* The first fire of the repeated timer cancels the other one */
+    repeated.timer_to_remove = removed_timer_id;
+
+    ASSERT_EQUAL(posix_event_loop_run(loop), KAA_ERR_NONE);
+    ASSERT_EQUAL(repeated.fired_count, 3);
+    ASSERT_EQUAL(removed.fired_count, 0);
+    ASSERT_EQUAL(posix_event_loop_remove_timer(loop, removed_timer_id), KAA_ERR_NOT_FOUND);
+
+    posix_event_loop_destroy(loop);
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+void test_add_channel()
+{
+    KAA_TRACE_IN(logger);
+
+    posix_event_loop_t *loop = NULL;
+    ASSERT_EQUAL(posix_event_loop_create(&loop, logger), KAA_ERR_NONE);
+
+    kaa_transport_channel_interface_t channels[POSIX_EVENT_LOOP_MAX_CHANNELS + 1];
+    kaa_service_t services[] = { KAA_SERVICE_BOOTSTRAP };
+    size_t i;
+    for (i = 0; i < POSIX_EVENT_LOOP_MAX_CHANNELS + 1; ++i)
+        ASSERT_EQUAL(kaa_tcp_channel_create(&channels[i], logger, services, 1), KAA_ERR_NONE);
+
+    ASSERT_NOT_EQUAL(posix_event_loop_add_channel(loop, NULL), KAA_ERR_NONE);
+
+    for (i = 0; i < POSIX_EVENT_LOOP_MAX_CHANNELS; ++i)
+        ASSERT_EQUAL(posix_event_loop_add_channel(loop, &channels[i]), KAA_ERR_NONE);
+    ASSERT_EQUAL(posix_event_loop_add_channel(loop, &channels[0]), KAA_ERR_ALREADY_EXISTS);
+    ASSERT_EQUAL(posix_event_loop_add_channel(loop, &channels[POSIX_EVENT_LOOP_MAX_CHANNELS])
+               , KAA_ERR_INSUFFICIENT_BUFFER);
+
+    /* Channels without access points have no sockets to wait for */
+    ASSERT_EQUAL(posix_event_loop_run_once(loop, 0), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(posix_event_loop_remove_channel(loop, &channels[0]), KAA_ERR_NONE);
+    ASSERT_EQUAL(posix_event_loop_remove_channel(loop, &channels[0]), KAA_ERR_NOT_FOUND);
+    ASSERT_EQUAL(posix_event_loop_add_channel(loop, &channels[POSIX_EVENT_LOOP_MAX_CHANNELS]), KAA_ERR_NONE);
+
+    posix_event_loop_destroy(loop);
+    for (i = 0; i < POSIX_EVENT_LOOP_MAX_CHANNELS + 1; ++i)
+        channels[i].destroy(channels[i].context);
+
+    KAA_TRACE_OUT(logger);
+}
+
+
+
+int test_init()
+{
+    kaa_error_t error = kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
+    if (error || !logger) {
+        return error;
+    }
+
+    return 0;
+}
+
+int test_deinit()
+{
+    kaa_log_destroy(logger);
+    return 0;
+}
+
+
+
+KAA_SUITE_MAIN(EventLoop, test_init, test_deinit,
+        KAA_TEST_CASE(create_loop, test_create_loop)
+        KAA_TEST_CASE(one_shot_timer, test_one_shot_timer)
+        KAA_TEST_CASE(repeated_timer, test_repeated_timer)
+        KAA_TEST_CASE(add_channel, test_add_channel)
+)
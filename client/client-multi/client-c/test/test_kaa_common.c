@@ -54,6 +54,40 @@ void test_profile_update()
     ASSERT_EQUAL(0, memcmp(buf, pattern, SHA_1_DIGEST_LENGTH * 2));
 }
 
+void test_incremental_hash()
+{
+    KAA_TRACE_IN(logger);
+
+    char body[200];
+    for (size_t i = 0; i < sizeof(body); ++i) {
+        body[i] = (char) (i * 31);
+    }
+
+    kaa_digest expected_hash;
+    ASSERT_EQUAL(ext_calculate_sha_hash(body, sizeof(body), expected_hash), KAA_ERR_NONE);
+
+    kaa_sha_context_t context;
+    ASSERT_NOT_EQUAL(ext_sha_hash_init(NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_sha_hash_init(&context), KAA_ERR_NONE);
+    ASSERT_NOT_EQUAL(ext_sha_hash_update(&context, NULL, 5), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_sha_hash_update(&context, NULL, 0), KAA_ERR_NONE);
+
+    size_t offset = 0;
+    size_t chunk_size = 1;
+    while (offset < sizeof(body)) {
+        if (chunk_size > sizeof(body) - offset)
+            chunk_size = sizeof(body) - offset;
+        ASSERT_EQUAL(ext_sha_hash_update(&context, body + offset, chunk_size), KAA_ERR_NONE);
+        offset += chunk_size;
+        chunk_size += 7;
+    }
+
+    kaa_digest calculated_hash;
+    ASSERT_NOT_EQUAL(ext_sha_hash_final(&context, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(ext_sha_hash_final(&context, calculated_hash), KAA_ERR_NONE);
+    ASSERT_EQUAL(memcmp(expected_hash, calculated_hash, SHA_1_DIGEST_LENGTH), 0);
+}
+
 int test_init(void)
 {
     kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
@@ -68,4 +102,5 @@ int test_deinit(void)
 
 KAA_SUITE_MAIN(Common, test_init, test_deinit
         , KAA_TEST_CASE(calculate_hash, test_profile_update)
+        KAA_TEST_CASE(incremental_hash, test_incremental_hash)
 )
@@ -132,6 +132,96 @@ void test_response()
     kaa_platform_message_reader_destroy(reader);
 }
 
+void test_truncated_response()
+{
+    KAA_TRACE_IN(logger);
+    const size_t response_size = sizeof(uint32_t) + sizeof(uint32_t) + KAA_ALIGNMENT;
+    char response[response_size];
+    char *response_cursor = response;
+
+    *((uint32_t *) response_cursor) = KAA_HTONL(CONFIG_NEW_SEQ_N + 1);
+    response_cursor += sizeof(uint32_t);
+
+    *((uint32_t *) response_cursor) = KAA_HTONL(KAA_CONFIGURATION_DATA_LENGTH);
+    response_cursor += sizeof(uint32_t);
+
+    memcpy(response_cursor, KAA_CONFIGURATION_DATA, KAA_ALIGNMENT);
+
+    kaa_platform_message_reader_t *reader = NULL;
+    ASSERT_EQUAL(kaa_platform_message_reader_create(&reader, response, response_size), KAA_ERR_NONE);
+
+    const kaa_root_configuration_t *root_config = kaa_configuration_manager_get_configuration(config_manager);
+    ASSERT_EQUAL(kaa_configuration_manager_handle_server_sync(config_manager, reader, CONFIG_RESPONSE_FLAGS, response_size), KAA_ERR_READ_FAILED);
+    ASSERT_EQUAL(kaa_configuration_manager_get_configuration(config_manager), root_config);
+
+    kaa_platform_message_reader_destroy(reader);
+}
+
+#ifdef KAA_CONFIGURATION_DECODE_ON_DEMAND
+static kaa_error_t on_configuration_decoded(void *context, const kaa_root_configuration_t *configuration)
+{
+    *((const kaa_root_configuration_t **) context) = configuration;
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t handle_configuration_response(kaa_configuration_manager_t *manager, uint32_t seq_n)
+{
+    const size_t response_size = kaa_aligned_size_get(KAA_CONFIGURATION_DATA_LENGTH) + sizeof(uint32_t) + sizeof(uint32_t);
+    char response[response_size];
+    char *response_cursor = response;
+
+    *((uint32_t *) response_cursor) = KAA_HTONL(seq_n);
+    response_cursor += sizeof(uint32_t);
+
+    *((uint32_t *) response_cursor) = KAA_HTONL(KAA_CONFIGURATION_DATA_LENGTH);
+    response_cursor += sizeof(uint32_t);
+
+    memcpy(response_cursor, KAA_CONFIGURATION_DATA, KAA_CONFIGURATION_DATA_LENGTH);
+
+    kaa_platform_message_reader_t *reader = NULL;
+    kaa_error_t error_code = kaa_platform_message_reader_create(&reader, response, response_size);
+    if (error_code)
+        return error_code;
+
+    error_code = kaa_configuration_manager_handle_server_sync(manager, reader, CONFIG_RESPONSE_FLAGS, response_size);
+    kaa_platform_message_reader_destroy(reader);
+    return error_code;
+}
+
+void test_decode_on_demand()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_configuration_manager_t *manager = NULL;
+    ASSERT_EQUAL(kaa_configuration_manager_create(&manager, status, logger), KAA_ERR_NONE);
+    ASSERT_NOT_NULL(manager);
+
+    // The stored configuration is decoded by the first request and cached for the next ones
+    const kaa_root_configuration_t *root_config = kaa_configuration_manager_get_configuration(manager);
+    ASSERT_NOT_NULL(root_config);
+    ASSERT_EQUAL(strcmp(root_config->data->data, CONFIG_DATA_FIELD), 0);
+    ASSERT_EQUAL(kaa_configuration_manager_get_configuration(manager), root_config);
+
+    // Without a receiver an update is only stored and the cached root is released
+    ASSERT_EQUAL(handle_configuration_response(manager, CONFIG_NEW_SEQ_N), KAA_ERR_NONE);
+    root_config = kaa_configuration_manager_get_configuration(manager);
+    ASSERT_NOT_NULL(root_config);
+    ASSERT_EQUAL(strcmp(root_config->data->data, CONFIG_DATA_FIELD), 0);
+    ASSERT_EQUAL(kaa_configuration_manager_get_configuration(manager), root_config);
+
+    // With a receiver an update is decoded at once and the passed root becomes the cached one
+    const kaa_root_configuration_t *updated_config = NULL;
+    kaa_configuration_root_receiver_t receiver = { &updated_config, &on_configuration_decoded };
+    ASSERT_EQUAL(kaa_configuration_manager_set_root_receiver(manager, &receiver), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(handle_configuration_response(manager, CONFIG_NEW_SEQ_N + 1), KAA_ERR_NONE);
+    ASSERT_NOT_NULL(updated_config);
+    ASSERT_EQUAL(strcmp(updated_config->data->data, CONFIG_DATA_FIELD), 0);
+    ASSERT_EQUAL(kaa_configuration_manager_get_configuration(manager), updated_config);
+
+    kaa_configuration_manager_destroy(manager);
+}
+#endif
 
 #endif
 
@@ -177,5 +267,9 @@ KAA_SUITE_MAIN(Log, test_init, test_deinit
        ,
        KAA_TEST_CASE(create_request, test_create_request)
        KAA_TEST_CASE(process_response, test_response)
+       KAA_TEST_CASE(process_truncated_response, test_truncated_response)
+#ifdef KAA_CONFIGURATION_DECODE_ON_DEMAND
+       KAA_TEST_CASE(decode_on_demand, test_decode_on_demand)
+#endif
 #endif
         )
@@ -31,6 +31,7 @@
 #include "kaa_status.h"
 #include "kaa_channel_manager.h"
 #include "kaa_platform_utils.h"
+#include "platform-impl/kaa_tcp_channel.h"
 
 
 extern kaa_error_t kaa_status_create(kaa_status_t **kaa_status_p);
@@ -628,6 +629,139 @@ void test_kaa_server_sync_with_event_callbacks()
 
 
 
+static size_t event_sync_count = 0;
+static kaa_service_t event_channel_services[] = { KAA_SERVICE_EVENT };
+
+static kaa_error_t event_channel_init(void *context, kaa_transport_context_t *transport_context)
+{
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t event_channel_set_access_point(void *context, kaa_access_point_t *access_point)
+{
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t event_channel_get_protocol_id(void *context, kaa_transport_protocol_id_t *protocol_info)
+{
+    KAA_RETURN_IF_NIL(protocol_info, KAA_ERR_BADPARAM);
+    *protocol_info = (kaa_transport_protocol_id_t) { 0x1, 1 };
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t event_channel_get_supported_services(void *context, kaa_service_t **supported_services, size_t *service_count)
+{
+    KAA_RETURN_IF_NIL2(supported_services, service_count, KAA_ERR_BADPARAM);
+    *supported_services = event_channel_services;
+    *service_count = sizeof(event_channel_services) / sizeof(kaa_service_t);
+    return KAA_ERR_NONE;
+}
+
+static kaa_error_t event_channel_sync_handler(void *context, const kaa_service_t services[], size_t service_count)
+{
+    ++event_sync_count;
+    return KAA_ERR_NONE;
+}
+
+void test_event_batching()
+{
+    KAA_TRACE_IN(logger);
+
+    test_deinit();
+    test_init();
+
+    kaa_transport_channel_interface_t channel = { .context = &event_sync_count
+                                                , .destroy = NULL
+                                                , .sync_handler = &event_channel_sync_handler
+                                                , .get_protocol_id = &event_channel_get_protocol_id
+                                                , .get_supported_services = &event_channel_get_supported_services
+                                                , .init = &event_channel_init
+                                                , .set_access_point = &event_channel_set_access_point };
+    uint32_t channel_id = 0;
+    ASSERT_EQUAL(kaa_channel_manager_add_transport_channel(channel_manager, &channel, &channel_id), KAA_ERR_NONE);
+
+    kaa_time_t timeout = 0;
+    ASSERT_EQUAL(kaa_event_manager_get_next_timeout(event_manager, &timeout), KAA_ERR_NOT_FOUND);
+
+    kaa_event_batching_settings_t settings = { 3, 0, 1000 };
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, &settings), KAA_ERR_NONE);
+
+    event_sync_count = 0;
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn1", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn2", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 0);
+
+    ASSERT_EQUAL(kaa_event_manager_get_next_timeout(event_manager, &timeout), KAA_ERR_NONE);
+    ASSERT_TRUE(timeout >= KAA_TIME() + 999);
+
+    ASSERT_EQUAL(kaa_event_manager_check_timeouts(event_manager), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 0);
+
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn3", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 1);
+    ASSERT_EQUAL(kaa_event_manager_get_next_timeout(event_manager, &timeout), KAA_ERR_NOT_FOUND);
+
+    settings = (kaa_event_batching_settings_t) { 2, 0, 0 };    // the zero delay limit is not checked
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, &settings), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn4", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 1);
+    ASSERT_EQUAL(kaa_event_manager_get_next_timeout(event_manager, &timeout), KAA_ERR_NOT_FOUND);
+    ASSERT_EQUAL(kaa_event_manager_check_timeouts(event_manager), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 1);
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn4", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 2);
+    event_sync_count = 1;
+
+    settings = (kaa_event_batching_settings_t) { 0, 0, -1 };   // the deadline passes immediately
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, &settings), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn4", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 1);
+    ASSERT_EQUAL(kaa_event_manager_check_timeouts(event_manager), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 2);
+
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn5", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 2);
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 3);
+
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn6", NULL, 0, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(event_sync_count, 4);
+
+    ASSERT_EQUAL(kaa_channel_manager_remove_transport_channel(channel_manager, channel_id), KAA_ERR_NONE);
+}
+
+void test_event_batching_tcp_timeout()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_service_t services[] = { KAA_SERVICE_EVENT };
+    kaa_transport_channel_interface_t tcp_channel = { 0 };
+    ASSERT_EQUAL(kaa_tcp_channel_create(&tcp_channel, logger, services, 1), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_tcp_channel_set_keepalive_timeout(&tcp_channel, 100), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_tcp_channel_set_event_manager(&tcp_channel, event_manager), KAA_ERR_NONE);
+
+    uint16_t keepalive_timeout = 0;
+    ASSERT_EQUAL(kaa_tcp_channel_get_max_timeout(&tcp_channel, &keepalive_timeout), KAA_ERR_NONE);
+    ASSERT_TRUE(keepalive_timeout > 7);
+
+    uint16_t max_timeout = 0;
+
+    kaa_event_batching_settings_t settings = { 0, 0, 7 };
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, &settings), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_event_manager_send_event(event_manager, "test.fqn", NULL, 0, NULL), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(kaa_tcp_channel_get_max_timeout(&tcp_channel, &max_timeout), KAA_ERR_NONE);
+    ASSERT_TRUE(max_timeout > 0 && max_timeout <= 7);
+
+    ASSERT_EQUAL(kaa_event_manager_set_batching(event_manager, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_tcp_channel_get_max_timeout(&tcp_channel, &max_timeout), KAA_ERR_NONE);
+    ASSERT_EQUAL(max_timeout, keepalive_timeout);
+
+    tcp_channel.destroy(tcp_channel.context);
+}
+
+
+
 static int test_init(void)
 {
     kaa_error_t error = kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
@@ -681,5 +815,7 @@ KAA_SUITE_MAIN(Event, test_init, test_deinit
           KAA_TEST_CASE(event_listeners_serialize_request, test_kaa_event_listeners_serialize_request)
           KAA_TEST_CASE(event_listeners_handle_sync, test_kaa_event_listeners_handle_sync)
           KAA_TEST_CASE(event_test_blocks, test_event_blocks)
+          KAA_TEST_CASE(event_batching, test_event_batching)
+          KAA_TEST_CASE(event_batching_tcp_timeout, test_event_batching_tcp_timeout)
 #endif
         )
@@ -411,6 +411,74 @@ void test_timeout()
     KAA_TRACE_OUT(logger);
 }
 
+void test_check_timeouts()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_error_t error_code;
+
+    size_t TEST_TIMEOUT = 2;
+
+    kaa_log_collector_t *log_collector = NULL;
+    error_code = kaa_log_collector_create(&log_collector, status, channel_manager, logger);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    kaa_user_log_record_t *test_log_record = kaa_test_log_record_create();
+    test_log_record->data = kaa_string_copy_create(TEST_LOG_BUFFER);
+    size_t test_log_record_size = test_log_record->get_size(test_log_record);
+
+    mock_strategy_context_t strategy;
+    memset(&strategy, 0, sizeof(mock_strategy_context_t));
+    strategy.timeout = TEST_TIMEOUT;
+    strategy.batch_size = 2 * test_log_record_size;
+
+    mock_storage_context_t storage;
+    memset(&storage, 0, sizeof(mock_storage_context_t));
+
+    error_code = kaa_logging_init(log_collector, &storage, &strategy);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = kaa_logging_add_record(log_collector, test_log_record);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    kaa_time_t timeout = 0;
+    error_code = kaa_logging_get_next_timeout(log_collector, &timeout);
+    ASSERT_EQUAL(error_code, KAA_ERR_NOT_FOUND);
+
+    size_t request_buffer_size = 256;
+    char request_buffer[request_buffer_size];
+    kaa_platform_message_writer_t *writer = NULL;
+    error_code = kaa_platform_message_writer_create(&writer, request_buffer, request_buffer_size);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    kaa_time_t request_time = KAA_TIME();
+    error_code = kaa_logging_request_serialize(log_collector, writer);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = kaa_logging_get_next_timeout(log_collector, &timeout);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_TRUE(timeout >= request_time + (kaa_time_t)TEST_TIMEOUT);
+
+    error_code = kaa_logging_check_timeouts(log_collector);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_NULL(strategy.on_timeout_count);
+
+    sleep(TEST_TIMEOUT + 1);
+
+    error_code = kaa_logging_check_timeouts(log_collector);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    ASSERT_NOT_NULL(strategy.on_timeout_count);
+
+    error_code = kaa_logging_get_next_timeout(log_collector, &timeout);
+    ASSERT_EQUAL(error_code, KAA_ERR_NOT_FOUND);
+
+    test_log_record->destroy(test_log_record);
+    kaa_platform_message_writer_destroy(writer);
+    kaa_log_collector_destroy(log_collector);
+
+    KAA_TRACE_OUT(logger);
+}
+
 void test_decline_timeout()
 {
     KAA_TRACE_IN(logger);
@@ -493,6 +561,150 @@ void test_decline_timeout()
     KAA_TRACE_OUT(logger);
 }
 
+
+
+/*
+ * Server side LZF decoder stub.
+ */
+static size_t lzf_decompress(const uint8_t *in, size_t in_size, uint8_t *out, size_t out_size)
+{
+    const uint8_t *in_end = in + in_size;
+    size_t out_len = 0;
+
+    while (in < in_end && out_len < out_size) {
+        uint8_t ctrl = *in++;
+        if (ctrl < 32) {
+            size_t len = ctrl + 1;
+            if (out_len + len > out_size || in + len > in_end)
+                return 0;
+            memcpy(out + out_len, in, len);
+            in += len;
+            out_len += len;
+        } else {
+            size_t len = ctrl >> 5;
+            if (len == 7)
+                len += *in++;
+            len += 2;
+            size_t distance = (((ctrl & 0x1F) << 8) | *in++) + 1;
+            if (distance > out_len || out_len + len > out_size)
+                return 0;
+            while (len--) {
+                out[out_len] = out[out_len - distance];
+                ++out_len;
+            }
+        }
+    }
+
+    return out_len;
+}
+
+void test_compressed_request()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_error_t error_code;
+
+    kaa_user_log_record_t *test_log_record = kaa_test_log_record_create();
+    test_log_record->data = kaa_string_copy_create(TEST_LOG_BUFFER);
+    size_t test_log_record_size = test_log_record->get_size(test_log_record);
+    size_t records_count = 10;
+
+    kaa_log_collector_t *log_collector = NULL;
+    error_code = kaa_log_collector_create(&log_collector, status, channel_manager, logger);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    mock_strategy_context_t strategy;
+    memset(&strategy, 0, sizeof(mock_strategy_context_t));
+    strategy.batch_size = records_count * (sizeof(uint32_t) + kaa_aligned_size_get(test_log_record_size));
+
+    mock_storage_context_t storage;
+    memset(&storage, 0, sizeof(mock_storage_context_t));
+
+    error_code = kaa_logging_init(log_collector, &storage, &strategy);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    error_code = kaa_logging_set_compression(log_collector, true);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    for (size_t i = 0; i < records_count; ++i) {
+        error_code = kaa_logging_add_record(log_collector, test_log_record);
+        ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    }
+
+    size_t expected_size = 0;
+    error_code = kaa_logging_request_get_size(log_collector, &expected_size);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+
+    char buffer[expected_size];
+    kaa_platform_message_writer_t *writer = NULL;
+
+    /* Compression isn't used until the server accepts it */
+    error_code = kaa_platform_message_writer_create(&writer, buffer, expected_size);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    error_code = kaa_logging_request_serialize(log_collector, writer);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    kaa_platform_message_writer_destroy(writer);
+
+    char options[] = { 0x00, 0x00, 0x03 };
+    ASSERT_EQUAL(memcmp(buffer + 1, options, 3), 0);
+
+    uint32_t delivery_status_count = 0;
+    kaa_platform_message_reader_t *reader = NULL;
+    error_code = kaa_platform_message_reader_create(&reader, (const char *) &delivery_status_count, sizeof(uint32_t));
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    error_code = kaa_logging_handle_server_sync(log_collector, reader, 0x02, sizeof(uint32_t));
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    kaa_platform_message_reader_destroy(reader);
+
+    error_code = kaa_platform_message_writer_create(&writer, buffer, expected_size);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    error_code = kaa_logging_request_serialize(log_collector, writer);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    kaa_platform_message_writer_destroy(writer);
+
+    char *buf_cursor = buffer;
+    ASSERT_EQUAL(KAA_LOGGING_EXTENSION_TYPE, *buf_cursor);
+    ++buf_cursor;
+
+    char compressed_options[] = { 0x00, 0x00, 0x07 };
+    ASSERT_EQUAL(memcmp(buf_cursor, compressed_options, 3), 0);
+    buf_cursor += 3;
+
+    size_t payload_size = KAA_NTOHL(*(uint32_t *) buf_cursor);
+    buf_cursor += sizeof(uint32_t);
+
+    ASSERT_EQUAL(KAA_NTOHS(*(uint16_t *) (buf_cursor + sizeof(uint16_t))), records_count);
+    buf_cursor += 2 * sizeof(uint16_t);
+
+    size_t raw_size = KAA_NTOHL(*(uint32_t *) buf_cursor);
+    buf_cursor += sizeof(uint32_t);
+    ASSERT_EQUAL(raw_size, strategy.batch_size);
+    ASSERT_TRUE(payload_size < raw_size);
+
+    char record_buf[test_log_record_size];
+    avro_writer_t avro_writer = avro_writer_memory(record_buf, test_log_record_size);
+    test_log_record->serialize(avro_writer, test_log_record);
+    avro_writer_free(avro_writer);
+
+    uint8_t raw_records[raw_size];
+    size_t compressed_size = payload_size - 3 * sizeof(uint32_t);
+    size_t decompressed_size = lzf_decompress((const uint8_t *) buf_cursor, compressed_size, raw_records, raw_size);
+    ASSERT_EQUAL(decompressed_size, raw_size);
+
+    uint8_t *raw_cursor = raw_records;
+    for (size_t i = 0; i < records_count; ++i) {
+        ASSERT_EQUAL(*(uint32_t *) raw_cursor, KAA_HTONL(test_log_record_size));
+        raw_cursor += sizeof(uint32_t);
+        ASSERT_EQUAL(memcmp(raw_cursor, record_buf, test_log_record_size), 0);
+        raw_cursor += kaa_aligned_size_get(test_log_record_size);
+    }
+
+    kaa_log_collector_destroy(log_collector);
+    test_log_record->destroy(test_log_record);
+
+    KAA_TRACE_OUT(logger);
+}
+
 #endif
 
 
@@ -539,5 +751,7 @@ KAA_SUITE_MAIN(Log, test_init, test_deinit
        KAA_TEST_CASE(process_response, test_response)
        KAA_TEST_CASE(process_timeout, test_timeout)
        KAA_TEST_CASE(decline_timeout, test_decline_timeout)
+       KAA_TEST_CASE(check_timeouts, test_check_timeouts)
+       KAA_TEST_CASE(create_compressed_request, test_compressed_request)
 #endif
         )
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kaa_test.h"
+
+#include "kaa_error.h"
+#include "utilities/kaa_log.h"
+
+
+
+#define TEST_LOG_BUFFER_SIZE    4096
+
+
+
+static FILE *sink = NULL;
+static char sink_content[TEST_LOG_BUFFER_SIZE];
+
+
+
+/*
+ * Returns the number of log lines written to the sink so far.
+ */
+static size_t read_sink()
+{
+    fflush(sink);
+    long size = ftell(sink);
+    rewind(sink);
+    size_t was_read = fread(sink_content, 1, size, sink);
+    sink_content[was_read] = 0;
+    fseek(sink, 0, SEEK_END);
+
+    size_t lines = 0;
+    size_t i;
+    for (i = 0; i < was_read; ++i) {
+        if (sink_content[i] == '\n')
+            ++lines;
+    }
+    return lines;
+}
+
+static kaa_logger_t *create_test_logger()
+{
+    sink = tmpfile();
+    ASSERT_NOT_NULL(sink);
+
+    kaa_logger_t *logger = NULL;
+    kaa_error_t error_code = kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_LOG_LEVEL_INFO, sink);
+    ASSERT_EQUAL(error_code, KAA_ERR_NONE);
+    return logger;
+}
+
+static void destroy_test_logger(kaa_logger_t *logger)
+{
+    kaa_log_destroy(logger);
+    fclose(sink);
+    sink = NULL;
+}
+
+
+
+void test_millisecond_timestamp()
+{
+    kaa_logger_t *logger = create_test_logger();
+
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "message");
+    ASSERT_EQUAL(read_sink(), 1);
+
+    /* YYYY/MM/DD H:MM:SS.mmm [INFO] */
+    char *level = strstr(sink_content, " [INFO]");
+    ASSERT_NOT_NULL(level);
+    ASSERT_TRUE(level - sink_content >= 4);
+    ASSERT_EQUAL(*(level - 4), '.');
+
+    destroy_test_logger(logger);
+}
+
+
+
+void test_module_log_level()
+{
+    kaa_logger_t *logger = create_test_logger();
+
+    ASSERT_NOT_EQUAL(kaa_log_set_module_log_level(NULL, "test_kaa_logger", KAA_LOG_LEVEL_DEBUG), KAA_ERR_NONE);
+    ASSERT_NOT_EQUAL(kaa_log_set_module_log_level(logger, NULL, KAA_LOG_LEVEL_DEBUG), KAA_ERR_NONE);
+    ASSERT_NOT_EQUAL(kaa_log_set_module_log_level(logger, "", KAA_LOG_LEVEL_DEBUG), KAA_ERR_NONE);
+
+    KAA_LOG_DEBUG(logger, KAA_ERR_NONE, "filtered out");
+    ASSERT_EQUAL(read_sink(), 0);
+
+    ASSERT_EQUAL(kaa_log_set_module_log_level(logger, "test_kaa_logger", KAA_LOG_LEVEL_DEBUG), KAA_ERR_NONE);
+    KAA_LOG_DEBUG(logger, KAA_ERR_NONE, "passed");
+    ASSERT_EQUAL(read_sink(), 1);
+
+    ASSERT_EQUAL(kaa_log_set_module_log_level(logger, "test_kaa_logger", KAA_LOG_LEVEL_ERROR), KAA_ERR_NONE);
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "filtered out");
+    ASSERT_EQUAL(read_sink(), 1);
+
+    /* Prefix of the module name must not match */
+    ASSERT_EQUAL(kaa_log_reset_module_log_levels(logger), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_log_set_module_log_level(logger, "test_kaa", KAA_LOG_LEVEL_ERROR), KAA_ERR_NONE);
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "passed");
+    ASSERT_EQUAL(read_sink(), 2);
+
+    ASSERT_EQUAL(kaa_log_reset_module_log_levels(logger), KAA_ERR_NONE);
+    char module[] = "module_0";
+    size_t i;
+    for (i = 0; i < KAA_LOG_MAX_MODULE_FILTERS; ++i) {
+        module[sizeof(module) - 2] = '0' + i;
+        ASSERT_EQUAL(kaa_log_set_module_log_level(logger, module, KAA_LOG_LEVEL_WARN), KAA_ERR_NONE);
+    }
+    ASSERT_EQUAL(kaa_log_set_module_log_level(logger, "one_more", KAA_LOG_LEVEL_WARN), KAA_ERR_INSUFFICIENT_BUFFER);
+    ASSERT_EQUAL(kaa_log_set_module_log_level(logger, "module_0", KAA_LOG_LEVEL_ERROR), KAA_ERR_NONE);
+
+    destroy_test_logger(logger);
+}
+
+
+
+void test_batching()
+{
+    kaa_logger_t *logger = create_test_logger();
+
+    kaa_log_batching_settings_t settings = { KAA_MAX_LOG_MESSAGE_LENGTH * 4, 0, 0, KAA_LOG_LEVEL_ERROR };
+
+    kaa_log_batching_settings_t bad_settings = settings;
+    bad_settings.buffer_size = KAA_MAX_LOG_MESSAGE_LENGTH / 2;
+    ASSERT_NOT_EQUAL(kaa_log_set_batching(logger, &bad_settings), KAA_ERR_NONE);
+    bad_settings = settings;
+    bad_settings.flush_size = settings.buffer_size + 1;
+    ASSERT_NOT_EQUAL(kaa_log_set_batching(logger, &bad_settings), KAA_ERR_NONE);
+
+    ASSERT_EQUAL(kaa_log_set_batching(logger, &settings), KAA_ERR_NONE);
+
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "first");
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "second");
+    ASSERT_EQUAL(read_sink(), 0);
+
+    /* Severity threshold */
+    KAA_LOG_ERROR(logger, KAA_ERR_NONE, "third");
+    ASSERT_EQUAL(read_sink(), 3);
+    ASSERT_TRUE(strstr(sink_content, "first") < strstr(sink_content, "second"));
+    ASSERT_TRUE(strstr(sink_content, "second") < strstr(sink_content, "third"));
+
+    /* Explicit flush */
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "fourth");
+    ASSERT_EQUAL(read_sink(), 3);
+    ASSERT_EQUAL(kaa_log_flush(logger), KAA_ERR_NONE);
+    ASSERT_EQUAL(read_sink(), 4);
+
+    /* Size threshold: the buffer fits a few lines only */
+    size_t lines = 4;
+    while (read_sink() == 4) {
+        KAA_LOG_INFO(logger, KAA_ERR_NONE, "%0200d", 0);
+        ++lines;
+        ASSERT_TRUE(lines < 4 + 2 * settings.buffer_size / 200);
+    }
+    ASSERT_TRUE(read_sink() < lines);
+
+    /* Pending lines are written when batching is disabled */
+    ASSERT_EQUAL(kaa_log_set_batching(logger, NULL), KAA_ERR_NONE);
+    ASSERT_EQUAL(read_sink(), lines);
+
+    KAA_LOG_INFO(logger, KAA_ERR_NONE, "unbatched");
+    ASSERT_EQUAL(read_sink(), lines + 1);
+
+    destroy_test_logger(logger);
+}
+
+
+
+void test_batching_flush_on_destroy()
+{
+    kaa_logger_t *logger = create_test_logger();
+    FILE *test_sink = sink;
+
+    kaa_log_batching_settings_t settings = { KAA_MAX_LOG_MESSAGE_LENGTH * 2, 0, 0, KAA_LOG_LEVEL_NONE };
+    ASSERT_EQUAL(kaa_log_set_batching(logger, &settings), KAA_ERR_NONE);
+
+    KAA_LOG_ERROR(logger, KAA_ERR_NONE, "pending");
+    ASSERT_EQUAL(read_sink(), 0);
+
+    kaa_log_destroy(logger);
+    ASSERT_EQUAL(read_sink(), 1);
+
+    fclose(test_sink);
+    sink = NULL;
+}
+
+
+
+int test_init()
+{
+    return 0;
+}
+
+int test_deinit()
+{
+    return 0;
+}
+
+
+
+KAA_SUITE_MAIN(Logger, test_init, test_deinit,
+        KAA_TEST_CASE(millisecond_timestamp, test_millisecond_timestamp)
+        KAA_TEST_CASE(module_log_level, test_module_log_level)
+        KAA_TEST_CASE(batching, test_batching)
+        KAA_TEST_CASE(batching_flush_on_destroy, test_batching_flush_on_destroy)
+)
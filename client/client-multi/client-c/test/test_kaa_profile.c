@@ -124,6 +124,47 @@ void test_profile_update()
     profile2->destroy(profile2);
 }
 
+void test_profile_update_revision()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_profile_t *profile = kaa_profile_basic_endpoint_profile_test_create();
+    profile->profile_body = kaa_string_copy_create("revision_dummy");
+    kaa_error_t error = kaa_profile_manager_update_profile_revision(profile_manager, profile, 1);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+
+    bool need_resync = false;
+    error = kaa_profile_need_profile_resync(profile_manager, &need_resync);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+    ASSERT_TRUE(need_resync);
+
+    kaa_digest applied_hash;
+    ext_copy_sha_hash(applied_hash, status->profile_hash);
+
+    profile->destroy(profile);
+    profile = kaa_profile_basic_endpoint_profile_test_create();
+    profile->profile_body = kaa_string_copy_create("new_revision_dummy");
+
+    /* Same revision: the profile isn't serialized, so the change is not noticed */
+    error = kaa_profile_manager_update_profile_revision(profile_manager, profile, 1);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+
+    error = kaa_profile_need_profile_resync(profile_manager, &need_resync);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+    ASSERT_FALSE(need_resync);
+    ASSERT_EQUAL(memcmp(applied_hash, status->profile_hash, SHA_1_DIGEST_LENGTH), 0);
+
+    error = kaa_profile_manager_update_profile_revision(profile_manager, profile, 2);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+
+    error = kaa_profile_need_profile_resync(profile_manager, &need_resync);
+    ASSERT_EQUAL(error, KAA_ERR_NONE);
+    ASSERT_TRUE(need_resync);
+    ASSERT_NOT_EQUAL(memcmp(applied_hash, status->profile_hash, SHA_1_DIGEST_LENGTH), 0);
+
+    profile->destroy(profile);
+}
+
 void test_profile_sync_get_size()
 {
     KAA_TRACE_IN(logger);
@@ -392,6 +433,7 @@ int test_deinit(void)
 
 KAA_SUITE_MAIN(Profile, test_init, test_deinit,
         KAA_TEST_CASE(profile_update, test_profile_update)
+        KAA_TEST_CASE(profile_update_revision, test_profile_update_revision)
         KAA_TEST_CASE(profile_request, test_profile_sync_get_size)
         KAA_TEST_CASE(profile_sync_serialize, test_profile_sync_serialize)
         KAA_TEST_CASE(profile_handle_sync, test_profile_handle_sync)
@@ -36,6 +36,7 @@ extern kaa_error_t kaa_status_save(kaa_status_t *self);
 extern kaa_error_t kaa_status_set_endpoint_access_token(kaa_status_t *self, const char *token);
 
 static kaa_logger_t *logger = NULL;
+static size_t store_count = 0;
 
 void ext_status_read(char **buffer, size_t *buffer_size, bool *needs_deallocation)
 {
@@ -74,6 +75,7 @@ void ext_status_store(const char *buffer, size_t buffer_size)
         return;
     }
 
+    ++store_count;
     FILE* status_file = fopen(KAA_STATUS_STORAGE, "wb");
 
     if (status_file) {
@@ -93,7 +95,7 @@ void test_create_status()
 {
     KAA_TRACE_IN(logger);
 
-    kaa_status_t *status;
+    kaa_status_t *status = NULL;
     kaa_error_t err_code = kaa_status_create(&status);
 
     ASSERT_EQUAL(err_code, KAA_ERR_NONE);
@@ -106,8 +108,10 @@ void test_status_persistense()
 {
     KAA_TRACE_IN(logger);
 
-    kaa_status_t *status;
+    kaa_status_t *status = NULL;
     kaa_error_t err_code = kaa_status_create(&status);
+    ASSERT_EQUAL(err_code, KAA_ERR_NONE);
+    ASSERT_NOT_NULL(status);
 
     ASSERT_NULL(status->endpoint_access_token);
     ASSERT_EQUAL(status->event_seq_n, 0);
@@ -129,6 +133,8 @@ void test_status_persistense()
 
 
     err_code = kaa_status_create(&status);
+    ASSERT_EQUAL(err_code, KAA_ERR_NONE);
+    ASSERT_NOT_NULL(status);
 
     ASSERT_NOT_NULL(status->endpoint_access_token);
     ASSERT_EQUAL(strcmp("my_token", status->endpoint_access_token), 0);
@@ -143,6 +149,71 @@ void test_status_persistense()
     kaa_status_destroy(status);
 }
 
+void test_status_save_unchanged()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_status_t *status = NULL;
+    ASSERT_EQUAL(kaa_status_create(&status), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_status_get_changed_fields(status), 0);
+
+    store_count = 0;
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 0);
+
+    status->is_attached = !status->is_attached;
+    ASSERT_EQUAL(kaa_status_get_changed_fields(status), KAA_STATUS_FIELD_ATTACHED);
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 1);
+    ASSERT_EQUAL(kaa_status_get_changed_fields(status), 0);
+
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 1);
+
+    ASSERT_EQUAL(kaa_status_set_endpoint_access_token(status, "other_token"), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_status_get_changed_fields(status), KAA_STATUS_FIELD_ACCESS_TOKEN);
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 2);
+
+    kaa_status_destroy(status);
+}
+
+void test_status_save_interval()
+{
+    KAA_TRACE_IN(logger);
+
+    kaa_status_t *status = NULL;
+    ASSERT_EQUAL(kaa_status_create(&status), KAA_ERR_NONE);
+    ASSERT_EQUAL(kaa_status_set_save_interval(status, 3600), KAA_ERR_NONE);
+
+    store_count = 0;
+    status->event_seq_n++;
+    status->config_seq_n++;
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 0);
+    ASSERT_EQUAL(kaa_status_get_changed_fields(status), (KAA_STATUS_FIELD_EVENT_SEQ_N | KAA_STATUS_FIELD_CONFIG_SEQ_N));
+
+    status->is_registered = !status->is_registered;
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 1);
+
+    status->log_bucket_id++;
+    ASSERT_EQUAL(kaa_status_save(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 1);
+
+    ASSERT_EQUAL(kaa_status_flush(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 2);
+    ASSERT_EQUAL(kaa_status_flush(status), KAA_ERR_NONE);
+    ASSERT_EQUAL(store_count, 2);
+
+    uint16_t log_bucket_id = status->log_bucket_id;
+    kaa_status_destroy(status);
+
+    ASSERT_EQUAL(kaa_status_create(&status), KAA_ERR_NONE);
+    ASSERT_EQUAL(status->log_bucket_id, log_bucket_id);
+    kaa_status_destroy(status);
+}
+
 int status_test_init(void)
 {
     kaa_log_create(&logger, KAA_MAX_LOG_MESSAGE_LENGTH, KAA_MAX_LOG_LEVEL, NULL);
@@ -159,4 +230,6 @@ int test_deinit(void)
 KAA_SUITE_MAIN(Status, status_test_init, test_deinit,
         KAA_TEST_CASE(create, test_create_status)
         KAA_TEST_CASE(persistence, test_status_persistense)
+        KAA_TEST_CASE(save_unchanged, test_status_save_unchanged)
+        KAA_TEST_CASE(save_interval, test_status_save_interval)
 )
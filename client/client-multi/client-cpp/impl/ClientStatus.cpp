@@ -36,7 +36,8 @@ enum class ClientParameterT {
     EP_ATTACH_STATUS,
     EP_KEY_HASH,
     PROPERTIES_HASH,
-    CONFIGURATION_VERSION
+    CONFIGURATION_VERSION,
+    ACCEPTED_UNICAST_IDS
 };
 
 class IPersistentParameter {
@@ -61,6 +62,7 @@ static bimap create_bimap()
     bi.left.insert(bimap::left_value_type(ClientParameterT::EP_KEY_HASH,           "ep_key_hash"));
     bi.left.insert(bimap::left_value_type(ClientParameterT::PROPERTIES_HASH,       "properties_hash"));
     bi.left.insert(bimap::left_value_type(ClientParameterT::CONFIGURATION_VERSION, "configuration_version"));
+    bi.left.insert(bimap::left_value_type(ClientParameterT::ACCEPTED_UNICAST_IDS,  "accepted_unicast_ids"));
     return bi;
 }
 
@@ -70,6 +72,7 @@ const bool                  ClientStatus::isRegisteredDefault_ = false;
 const HashDigest            ClientStatus::endpointHashDefault_;
 const DetailedTopicStates   ClientStatus::topicStatesDefault_;
 const AttachedEndpoints     ClientStatus::attachedEndpoints_;
+const AcceptedUnicastNotificationIds ClientStatus::acceptedUnicastNotificationIdsDefault_;
 const bool                  ClientStatus::endpointDefaultAttachStatus_ = false;
 const std::string           ClientStatus::endpointKeyHashDefault_;
 
@@ -178,6 +181,22 @@ void ClientParameter<AttachedEndpoints>::save(std::ostream &os)
     }
 }
 
+template<>
+void ClientParameter<AcceptedUnicastNotificationIds>::save(std::ostream &os)
+{
+    if (!value_.empty()) {
+        os << attributeName_ << "=";
+        for (auto it = value_.begin(); it != value_.end(); ++it) {
+            if (it != value_.begin()) {
+                os << ",";
+            }
+
+            os << "[" << convertToByteArrayString(*it) << "]";
+        }
+        os << std::endl;
+    }
+}
+
 template<>
 void ClientParameter<HashDigest>::save(std::ostream &os)
 {
@@ -316,6 +335,29 @@ void ClientParameter<AttachedEndpoints>::read(const std::string &strValue)
     }
 }
 
+template<>
+void ClientParameter<AcceptedUnicastNotificationIds>::read(const std::string &strValue)
+{
+    value_.clear();
+
+    std::size_t begin_pos = 0;
+    while (begin_pos < strValue.length()) {
+        std::size_t open_brace_pos = strValue.find_first_of('[', begin_pos);
+        if (open_brace_pos == std::string::npos) {
+            break;
+        }
+
+        std::size_t close_brace_pos = strValue.find_first_of(']', open_brace_pos);
+        if (close_brace_pos == std::string::npos) {
+            break;
+        }
+
+        value_.push_back(convertFromByteArrayString(
+                strValue.substr(open_brace_pos + 1, close_brace_pos - open_brace_pos - 1)));
+        begin_pos = close_brace_pos + 1;
+    }
+}
+
 template<>
 void ClientParameter<HashDigest>::read(const std::string &strValue)
 {
@@ -391,6 +433,13 @@ ClientStatus::ClientStatus(const std::string& filename) : filename_(filename), i
         parameters_.insert(std::make_pair(ClientParameterT::CONFIGURATION_VERSION, configVersion));
     }
 
+    auto acceptedunicastids = parameterToToken_.left.find(ClientParameterT::ACCEPTED_UNICAST_IDS);
+    if (acceptedunicastids != parameterToToken_.left.end()) {
+        std::shared_ptr<IPersistentParameter> acceptedUnicastIds(new ClientParameter<AcceptedUnicastNotificationIds>(
+                acceptedunicastids->second, acceptedUnicastNotificationIdsDefault_));
+        parameters_.insert(std::make_pair(ClientParameterT::ACCEPTED_UNICAST_IDS, acceptedUnicastIds));
+    }
+
     this->read();
 
     checkSDKPropertiesForUpdates();
@@ -525,6 +574,23 @@ void ClientStatus::setAttachedEndpoints(const AttachedEndpoints& endpoints)
     }
 }
 
+AcceptedUnicastNotificationIds ClientStatus::getAcceptedUnicastNotificationIds() const
+{
+    auto parameter_it = parameters_.find(ClientParameterT::ACCEPTED_UNICAST_IDS);
+    if (parameter_it != parameters_.end()) {
+        return boost::any_cast<AcceptedUnicastNotificationIds>(parameter_it->second->getValue());
+    }
+    return acceptedUnicastNotificationIdsDefault_;
+}
+
+void ClientStatus::setAcceptedUnicastNotificationIds(const AcceptedUnicastNotificationIds& ids)
+{
+    auto parameter_it = parameters_.find(ClientParameterT::ACCEPTED_UNICAST_IDS);
+    if (parameter_it != parameters_.end()) {
+        parameter_it->second->setValue(ids);
+    }
+}
+
 HashDigest ClientStatus::getProfileHash() const
 {
     auto parameter_it = parameters_.find(ClientParameterT::PROFILEHASH);
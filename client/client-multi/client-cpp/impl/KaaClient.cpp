@@ -45,6 +45,18 @@ KaaClient::KaaClient()
 
 }
 
+KaaClient::~KaaClient()
+{
+    /*
+     * The log upload scheduler uses the transports, so it's stopped before any member is destroyed.
+     */
+#ifdef KAA_USE_LOGGING
+    if (logCollector_) {
+        logCollector_->shutdown();
+    }
+#endif
+}
+
 void KaaClient::init(int options /*= KAA_DEFAULT_OPTIONS*/)
 {
     options_ = options;
@@ -59,7 +71,8 @@ void KaaClient::init(int options /*= KAA_DEFAULT_OPTIONS*/)
 #endif
 
     bootstrapManager_.reset(new BootstrapManager);
-    channelManager_.reset(new KaaChannelManager(*bootstrapManager_, getBootstrapServers()));
+    KaaChannelManager *channelManager = new KaaChannelManager(*bootstrapManager_, getBootstrapServers());
+    channelManager_.reset(channelManager);
 #ifdef KAA_USE_EVENTS
     registrationManager_.reset(new EndpointRegistrationManager(status_));
     eventManager_.reset(new EventManager(status_));
@@ -73,6 +86,8 @@ void KaaClient::init(int options /*= KAA_DEFAULT_OPTIONS*/)
 
 #ifdef KAA_USE_LOGGING
     logCollector_.reset(new LogCollector(channelManager_.get()));
+    logCollector_->setMetricsRegistry(metrics_);
+    channelManager->registerConnectivityChangeReceiver([this] () { logCollector_->onConnectivityChanged(); });
 #endif
 
     initKaaConfiguration();
@@ -94,6 +109,9 @@ void KaaClient::start()
 
 void KaaClient::stop()
 {
+#ifdef KAA_USE_LOGGING
+    logCollector_->shutdown();
+#endif
     channelManager_->shutdown();
 }
 
@@ -183,6 +201,7 @@ void KaaClient::initKaaTransport()
 #endif
             , redirectionTransport
             , status_));
+    syncProcessor_->setMetricsRegistry(metrics_);
 
 #ifdef KAA_USE_EVENTS
     eventManager_->setTransport(std::dynamic_pointer_cast<EventTransport, IEventTransport>(eventTransport).get());
@@ -226,6 +245,7 @@ void KaaClient::initKaaTransport()
         opsTcpChannel_.reset(new DefaultOperationTcpChannel(channelManager_.get(), *clientKeys_));
         opsTcpChannel_->setDemultiplexer(syncProcessor_.get());
         opsTcpChannel_->setMultiplexer(syncProcessor_.get());
+        opsTcpChannel_->setMetricsRegistry(metrics_);
         KAA_LOG_INFO(boost::format("Going to set default operations Kaa TCP channel: %1%") % opsTcpChannel_.get());
         channelManager_->addChannel(opsTcpChannel_.get());
     }
@@ -466,6 +486,24 @@ std::int32_t KaaClient::findEventListeners(const std::list<std::string>& eventFQ
     throw KaaException("Failed to find event listeners. Event subsystem is disabled");
 #endif
 }
+
+void KaaClient::setPendingEventsLimits(std::size_t maxCount, std::size_t maxSize, EventQueueOverflowPolicy policy)
+{
+#ifdef KAA_USE_EVENTS
+    eventManager_->setPendingEventsLimits(maxCount, maxSize, policy);
+#else
+    throw KaaException("Failed to set pending events limits. Event subsystem is disabled");
+#endif
+}
+
+void KaaClient::setEventQueueListener(IEventQueueListener* listener)
+{
+#ifdef KAA_USE_EVENTS
+    eventManager_->setEventQueueListener(listener);
+#else
+    throw KaaException("Failed to set event queue listener. Event subsystem is disabled");
+#endif
+}
 IKaaChannelManager& KaaClient::getChannelManager()
 {
     return *channelManager_;
@@ -483,6 +521,13 @@ void KaaClient::addLogRecord(const KaaUserLogRecord& record) {
     throw KaaException("Failed to add log record. Logging subsystem is disabled");
 #endif
 }
+void KaaClient::addLogRecord(const KaaUserLogRecord& record, LogPriority priority) {
+#ifdef KAA_USE_LOGGING
+    return logCollector_->addLogRecord(record, priority);
+#else
+    throw KaaException("Failed to add log record. Logging subsystem is disabled");
+#endif
+}
 void KaaClient::setLogStorage(ILogStoragePtr storage) {
 #ifdef KAA_USE_LOGGING
     return logCollector_->setStorage(storage);
@@ -498,6 +543,13 @@ void KaaClient::setLogUploadStrategy(ILogUploadStrategyPtr strategy) {
         throw KaaException("Failed to set strategy. Logging subsystem is disabled");
 #endif
 }
+void KaaClient::setMaxLogBatchingDelay(std::size_t delay) {
+#ifdef KAA_USE_LOGGING
+        return logCollector_->setMaxBatchingDelay(delay);
+#else
+        throw KaaException("Failed to set log batching delay. Logging subsystem is disabled");
+#endif
+}
 IKaaDataMultiplexer& KaaClient::getOperationMultiplexer()
 {
     return *syncProcessor_;
@@ -518,4 +570,9 @@ IKaaDataDemultiplexer& KaaClient::getBootstrapDemultiplexer()
     return *syncProcessor_;
 }
 
+MetricsRegistry& KaaClient::getMetricsRegistry()
+{
+    return metrics_;
+}
+
 }
@@ -70,17 +70,23 @@ void KaaChannelManager::onTransportConnectionInfoUpdated(ITransportConnectionInf
         lastOpsServers_[protocolId] = connectionInfo;
     }
 
-    KAA_MUTEX_LOCKING("channelGuard_");
-    KAA_MUTEX_UNIQUE_DECLARE(channelLock, channelGuard_);
-    KAA_MUTEX_LOCKED("channelGuard_");
-
-    for (auto& channel : channels_) {
-        if (channel->getServerType() == connectionInfo->getServerType() && channel->getTransportProtocolId() == protocolId) {
-            KAA_LOG_DEBUG(boost::format("Setting a new connection data for channel \"%1%\" %2%")
-                        % channel->getId() % LoggingUtils::TransportProtocolIdToString(protocolId));
-            channel->setServer(connectionInfo);
+    {
+        KAA_MUTEX_LOCKING("channelGuard_");
+        KAA_MUTEX_UNIQUE_DECLARE(channelLock, channelGuard_);
+        KAA_MUTEX_LOCKED("channelGuard_");
+
+        for (auto& channel : channels_) {
+            if (channel->getServerType() == connectionInfo->getServerType() && channel->getTransportProtocolId() == protocolId) {
+                KAA_LOG_DEBUG(boost::format("Setting a new connection data for channel \"%1%\" %2%")
+                            % channel->getId() % LoggingUtils::TransportProtocolIdToString(protocolId));
+                channel->setServer(connectionInfo);
+            }
         }
     }
+
+    if (connectionInfo->getServerType() == ServerType::OPERATIONS && onConnectivityChange_) {
+        onConnectivityChange_();
+    }
 }
 
 bool KaaChannelManager::addChannelToList(IDataChannelPtr channel)
@@ -418,12 +424,18 @@ void KaaChannelManager::resume()
     if (isPaused_) {
         isPaused_ = false;
 
-        KAA_MUTEX_LOCKING("mappedChannelGuard_");
-        KAA_R_MUTEX_UNIQUE_DECLARE(mappedChannelLock, mappedChannelGuard_);
-        KAA_MUTEX_LOCKED("mappedChannelGuard_");
+        {
+            KAA_MUTEX_LOCKING("mappedChannelGuard_");
+            KAA_R_MUTEX_UNIQUE_DECLARE(mappedChannelLock, mappedChannelGuard_);
+            KAA_MUTEX_LOCKED("mappedChannelGuard_");
 
-        for (auto& channel : mappedChannels_) {
-            channel.second->resume();
+            for (auto& channel : mappedChannels_) {
+                channel.second->resume();
+            }
+        }
+
+        if (onConnectivityChange_) {
+            onConnectivityChange_();
         }
     }
 }
@@ -17,6 +17,7 @@
 #include "kaa/logging/Log.hpp"
 #include "kaa/logging/LoggingUtils.hpp"
 #include "kaa/channel/SyncDataProcessor.hpp"
+#include "kaa/metrics/MetricsRegistry.hpp"
 
 namespace kaa {
 
@@ -42,12 +43,25 @@ SyncDataProcessor::SyncDataProcessor(
         , redirectionTransport_(redirectionTransport)
         , clientStatus_(clientStatus)
         , requestId(0)
+        , requestsCompiled_(nullptr), requestBytes_(nullptr), responsesProcessed_(nullptr), responseBytes_(nullptr)
+        , compileLatency_(nullptr), processLatency_(nullptr)
 {
 
 }
 
+void SyncDataProcessor::setMetricsRegistry(MetricsRegistry& registry)
+{
+    requestsCompiled_ = &registry.getCounter("sync.requests");
+    requestBytes_ = &registry.getCounter("sync.request_bytes");
+    responsesProcessed_ = &registry.getCounter("sync.responses");
+    responseBytes_ = &registry.getCounter("sync.response_bytes");
+    compileLatency_ = &registry.getHistogram("sync.compile_us");
+    processLatency_ = &registry.getHistogram("sync.process_us");
+}
+
 std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<TransportType, ChannelDirection>& transportTypes)
 {
+    ScopedLatency latency(compileLatency_);
     SyncRequest request;
 
     request.requestId = ++requestId;
@@ -82,7 +96,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Bootstrap transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled BootstrapSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled BootstrapSyncRequest: %1%")
                     % LoggingUtils::BootstrapSyncRequestToString(request.bootstrapSyncRequest));
             break;
             case TransportType::PROFILE :
@@ -98,7 +112,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Profile transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled ProfileSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled ProfileSyncRequest: %1%")
                     % LoggingUtils::ProfileSyncRequestToString(request.profileSyncRequest));
                 break;
             case TransportType::CONFIGURATION:
@@ -112,7 +126,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Configuration transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled ConfigurationSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled ConfigurationSyncRequest: %1%")
                    % LoggingUtils::ConfigurationSyncRequestToString(request.configurationSyncRequest));
                 break;
             case TransportType::NOTIFICATION:
@@ -130,7 +144,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Notification transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled NotificationSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled NotificationSyncRequest: %1%")
                    % LoggingUtils::NotificationSyncRequestToString(request.notificationSyncRequest));
                 break;
             case TransportType::USER:
@@ -150,7 +164,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("User transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled UserSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled UserSyncRequest: %1%")
                     % LoggingUtils::UserSyncRequestToString(request.userSyncRequest));
                 break;
             case TransportType::EVENT:
@@ -169,7 +183,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Event transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled EventSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled EventSyncRequest: %1%")
                     % LoggingUtils::EventSyncRequestToString(request.eventSyncRequest));
                 break;
             case TransportType::LOGGING:
@@ -188,7 +202,7 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
                 } else {
                     KAA_LOG_WARN("Log upload transport was not specified.");
                 }
-                KAA_LOG_DEBUG(boost::format("Compiled LogSyncRequest: %1%")
+                KAA_LOG_TRACE(boost::format("Compiled LogSyncRequest: %1%")
                     % LoggingUtils::LogSyncRequestToString(request.logSyncRequest));
                 break;
             default:
@@ -196,21 +210,35 @@ std::vector<std::uint8_t> SyncDataProcessor::compileRequest(const std::map<Trans
         }
     }
 
+    KAA_LOG_DEBUG(boost::format("Compiled SyncRequest: %1%") % LoggingUtils::SyncRequestSummaryToString(request));
+
     std::vector<std::uint8_t> encodedData;
     requestConverter_.toByteArray(request, encodedData);
 
+    if (requestsCompiled_) {
+        requestsCompiled_->increment();
+        requestBytes_->increment(encodedData.size());
+    }
+
     return encodedData;
 }
 
 void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &response)
 {
+    ScopedLatency latency(processLatency_);
+    if (responsesProcessed_) {
+        responsesProcessed_->increment();
+        responseBytes_->increment(response.size());
+    }
+
     SyncResponse syncResponse = responseConverter_.fromByteArray(response.data(), response.size());
     std::int32_t requestId = syncResponse.requestId;
     KAA_LOG_INFO(boost::format("Got SyncResponse: requestId: %1%, result: %2%")
         % requestId % LoggingUtils::SyncResponseResultTypeToString(syncResponse.status));
+    KAA_LOG_DEBUG(boost::format("SyncResponse summary: %1%") % LoggingUtils::SyncResponseSummaryToString(syncResponse));
 
     if (!syncResponse.bootstrapSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got BootstrapSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got BootstrapSyncResponse: %1%")
             % LoggingUtils::BootstrapSyncResponseToString(syncResponse.bootstrapSyncResponse));
         if (bootstrapTransport_) {
             bootstrapTransport_->onBootstrapResponse(syncResponse.bootstrapSyncResponse.get_BootstrapSyncResponse());
@@ -220,7 +248,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.profileSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got ProfileSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got ProfileSyncResponse: %1%")
             % LoggingUtils::ProfileSyncResponseToString(syncResponse.profileSyncResponse));
         if (profileTransport_) {
             profileTransport_->onProfileResponse(syncResponse.profileSyncResponse.get_ProfileSyncResponse());
@@ -236,7 +264,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.configurationSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got ConfigurationSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got ConfigurationSyncResponse: %1%")
                 % LoggingUtils::ConfigurationSyncResponseToString(syncResponse.configurationSyncResponse));
         if (configurationTransport_) {
             configurationTransport_->onConfigurationResponse(syncResponse.configurationSyncResponse.get_ConfigurationSyncResponse());
@@ -248,7 +276,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     if (eventTransport_) {
         eventTransport_->onSyncResponseId(requestId);
         if (!syncResponse.eventSyncResponse.is_null()) {
-            KAA_LOG_DEBUG(boost::format("Got EventSyncResponse: %1%")
+            KAA_LOG_TRACE(boost::format("Got EventSyncResponse: %1%")
                     % LoggingUtils::EventSyncResponseToString(syncResponse.eventSyncResponse));
                 eventTransport_->onEventResponse(syncResponse.eventSyncResponse.get_EventSyncResponse());
         }
@@ -257,7 +285,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.notificationSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got NotificationSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got NotificationSyncResponse: %1%")
                 % LoggingUtils::NotificationSyncResponseToString(syncResponse.notificationSyncResponse));
         if (notificationTransport_) {
             notificationTransport_->onNotificationResponse(syncResponse.notificationSyncResponse.get_NotificationSyncResponse());
@@ -267,7 +295,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.userSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got UserSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got UserSyncResponse: %1%")
                 % LoggingUtils::UserSyncResponseToString(syncResponse.userSyncResponse));
         if (userTransport_) {
             userTransport_->onUserResponse(syncResponse.userSyncResponse.get_UserSyncResponse());
@@ -277,7 +305,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.logSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got LogSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got LogSyncResponse: %1%")
                 % LoggingUtils::LogSyncResponseToString(syncResponse.logSyncResponse));
         if (loggingTransport_) {
             loggingTransport_->onLogSyncResponse(syncResponse.logSyncResponse.get_LogSyncResponse());
@@ -287,7 +315,7 @@ void SyncDataProcessor::processResponse(const std::vector<std::uint8_t> &respons
     }
 
     if (!syncResponse.redirectSyncResponse.is_null()) {
-        KAA_LOG_DEBUG(boost::format("Got RedirectSyncResponse: %1%")
+        KAA_LOG_TRACE(boost::format("Got RedirectSyncResponse: %1%")
                 % LoggingUtils::RedirectSyncResponseToString(syncResponse.redirectSyncResponse));
         if (redirectionTransport_) {
             redirectionTransport_->onRedirectionResponse(syncResponse.redirectSyncResponse.get_RedirectSyncResponse());
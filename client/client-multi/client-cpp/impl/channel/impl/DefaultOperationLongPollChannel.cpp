@@ -39,6 +39,7 @@ const std::map<TransportType, ChannelDirection> DefaultOperationLongPollChannel:
 
 DefaultOperationLongPollChannel::DefaultOperationLongPollChannel(IKaaChannelManager *channelManager, const KeyPair& clientKeys)
     : clientKeys_(clientKeys), work_(io_), pollThread_()
+    , syncWork_(syncIo_), syncThread_(), syncTaskPosted_(false)
     , stopped_(true), isShutdown_(false), isPaused_(false), connectionInProgress_(false), taskPosted_(false), firstStart_(true)
     , multiplexer_(nullptr), demultiplexer_(nullptr), channelManager_(channelManager) {}
 
@@ -66,17 +67,15 @@ void DefaultOperationLongPollChannel::startPoll()
     }
 }
 
-void DefaultOperationLongPollChannel::stopPoll()
+void DefaultOperationLongPollChannel::stopPoll(KAA_MUTEX_UNIQUE& channelLock)
 {
     KAA_LOG_INFO("Stopping poll future..");
     if (!stopped_) {
         stopped_ = true;
         if (connectionInProgress_) {
             httpClient_.closeConnection();
-            KAA_MUTEX_LOCKING("conditionMutex_");
-            KAA_MUTEX_UNIQUE_DECLARE(conditionLock, conditionMutex_);
-            KAA_MUTEX_LOCKED("conditionMutex_");
-            KAA_CONDITION_WAIT_PRED(waitCondition_, conditionLock, [this](){ return !this->connectionInProgress_; });
+            // The aborted poll task takes channelGuard_ to finish, so it is released while waiting
+            KAA_CONDITION_WAIT_PRED(waitCondition_, channelLock, [this](){ return !this->connectionInProgress_; });
         }
     }
 }
@@ -122,9 +121,6 @@ void DefaultOperationLongPollChannel::executeTask()
                 std::vector<std::uint8_t>(reinterpret_cast<const std::uint8_t *>(processedResponse.data()),
                                             reinterpret_cast<const std::uint8_t *>(processedResponse.data() + processedResponse.size())));
 
-        KAA_MUTEX_LOCKING("conditionMutex_");
-        KAA_MUTEX_UNIQUE_DECLARE(conditionLock, conditionMutex_);
-        KAA_MUTEX_LOCKED("conditionMutex_");
         KAA_CONDITION_NOTIFY_ALL(waitCondition_);
     } catch (std::exception& e) {
         KAA_MUTEX_LOCKING("channelGuard_");
@@ -145,9 +141,6 @@ void DefaultOperationLongPollChannel::executeTask()
         KAA_UNLOCK(lockException);
         KAA_MUTEX_UNLOCKED("channelGuard_");
 
-        KAA_MUTEX_LOCKING("conditionMutex_");
-        KAA_MUTEX_UNIQUE_DECLARE(conditionLock, conditionMutex_);
-        KAA_MUTEX_LOCKED("conditionMutex_");
         KAA_CONDITION_NOTIFY_ALL(waitCondition_);
         if (isServerFailed) {
             channelManager_->onServerFailed(std::dynamic_pointer_cast<ITransportConnectionInfo, IPTransportInfo>(currentServer_));
@@ -163,6 +156,103 @@ void DefaultOperationLongPollChannel::executeTask()
     }
 }
 
+void DefaultOperationLongPollChannel::postSyncTask(const std::map<TransportType, ChannelDirection>& types)
+{
+    for (const auto& type : types) {
+        if (type.second == ChannelDirection::UP || type.second == ChannelDirection::BIDIRECTIONAL) {
+            pendingSyncTypes_.insert(type);
+        }
+    }
+
+    if (pendingSyncTypes_.empty() || syncTaskPosted_) {
+        return;
+    }
+
+    if (!syncThread_.joinable()) {
+        KAA_LOG_INFO(boost::format("Creating a sync thread for channel %1%...") % getId());
+        syncThread_ = std::thread([this](){ this->syncIo_.run(); });
+    }
+
+    syncIo_.post([this](){ this->executeSyncTask(); });
+    syncTaskPosted_ = true;
+}
+
+void DefaultOperationLongPollChannel::executeSyncTask()
+{
+    KAA_MUTEX_LOCKING("channelGuard_");
+    KAA_MUTEX_UNIQUE_DECLARE(lock, channelGuard_);
+    KAA_MUTEX_LOCKED("channelGuard_");
+    syncTaskPosted_ = false;
+
+    // Pending types are kept until the channel is resumed or given a server
+    if (isShutdown_ || isPaused_ || !currentServer_ || pendingSyncTypes_.empty()) {
+        return;
+    }
+
+    std::map<TransportType, ChannelDirection> types;
+    types.swap(pendingSyncTypes_);
+
+    auto server = currentServer_;
+    const auto& bodyRaw = multiplexer_->compileRequest(types);
+    // Creating HTTP request using the given data
+    std::shared_ptr<IHttpRequest> postRequest = httpDataProcessor_.createOperationRequest(
+                                        server->getURL() + getSyncURLSuffix(), bodyRaw);
+
+    KAA_MUTEX_UNLOCKING("channelGuard_");
+    KAA_UNLOCK(lock);
+    KAA_MUTEX_UNLOCKED("channelGuard_");
+    try {
+        // Sending http request over the separate connection, the long poll stays parked
+        auto response = syncClient_.sendRequest(*postRequest);
+        if (response->getStatusCode() != 200) {
+            throw TransportException(boost::format("Invalid response code %1%") % response->getStatusCode());
+        }
+
+        KAA_MUTEX_LOCKING("channelGuard_");
+        KAA_MUTEX_UNIQUE_DECLARE(lockInternal, channelGuard_);
+        KAA_MUTEX_LOCKED("channelGuard_");
+        // Retrieving the avro data from the HTTP response
+        const std::string& processedResponse = httpDataProcessor_.retrieveOperationResponse(*response);
+        KAA_MUTEX_UNLOCKING("channelGuard_");
+        KAA_UNLOCK(lockInternal);
+        KAA_MUTEX_UNLOCKED("channelGuard_");
+
+        if (!processedResponse.empty()) {
+            demultiplexer_->processResponse(
+                    std::vector<std::uint8_t>(reinterpret_cast<const std::uint8_t *>(processedResponse.data()),
+                                                reinterpret_cast<const std::uint8_t *>(processedResponse.data() + processedResponse.size())));
+        }
+    } catch (std::exception& e) {
+        KAA_MUTEX_LOCKING("channelGuard_");
+        KAA_MUTEX_UNIQUE_DECLARE(lockException, channelGuard_);
+        KAA_MUTEX_LOCKED("channelGuard_");
+
+        // Retried on the next server or on resume, unless the channel is down
+        if (!isShutdown_) {
+            pendingSyncTypes_.insert(types.begin(), types.end());
+        }
+
+        bool isServerFailed = !isShutdown_ && !isPaused_ && server == currentServer_;
+        if (isServerFailed) {
+            KAA_LOG_ERROR(boost::format("Sync request failed, server %1%:%2%: %3%")
+                    % server->getHost() % server->getPort() % e.what());
+        } else {
+            KAA_LOG_INFO(boost::format("Sync request for channel %1% was aborted") % getId());
+            if (!isShutdown_ && !isPaused_) {
+                postSyncTask({});
+            }
+        }
+
+        KAA_MUTEX_UNLOCKING("channelGuard_");
+        KAA_UNLOCK(lockException);
+        KAA_MUTEX_UNLOCKED("channelGuard_");
+
+        if (isServerFailed) {
+            channelManager_->onServerFailed(std::dynamic_pointer_cast<ITransportConnectionInfo, IPTransportInfo>(server));
+        }
+    }
+}
+
 void DefaultOperationLongPollChannel::sync(TransportType type)
 {
     KAA_MUTEX_LOCKING("channelGuard_");
@@ -180,8 +270,10 @@ void DefaultOperationLongPollChannel::sync(TransportType type)
     auto it = types.find(type);
     if (it != types.end() && (it->second == ChannelDirection::UP || it->second == ChannelDirection::BIDIRECTIONAL)) {
         if (currentServer_) {
-            stopPoll();
-            startPoll();
+            postSyncTask({ { type, it->second } });
+            if (stopped_) {
+                startPoll();
+            }
         } else {
             KAA_LOG_WARN(boost::format("Can't sync channel %1%. Server is null") % getId());
         }
@@ -204,8 +296,10 @@ void DefaultOperationLongPollChannel::syncAll()
         return;
     }
     if (currentServer_) {
-        stopPoll();
-        startPoll();
+        postSyncTask(getSupportedTransportTypes());
+        if (stopped_) {
+            startPoll();
+        }
     } else {
         KAA_LOG_WARN(boost::format("Can't sync channel %1%. Server is null") % getId());
     }
@@ -238,7 +332,7 @@ void DefaultOperationLongPollChannel::setServer(ITransportConnectionInfoPtr serv
     }
     if (server->getTransportId() == TransportProtocolIdConstants::HTTP_TRANSPORT_ID) {
         if (!isPaused_) {
-            stopPoll();
+            stopPoll(lock);
         }
 
         currentServer_.reset(new IPTransportInfo(server));
@@ -250,6 +344,7 @@ void DefaultOperationLongPollChannel::setServer(ITransportConnectionInfoPtr serv
 
         if (!isPaused_) {
             startPoll();
+            postSyncTask({});
         }
     } else {
         KAA_LOG_ERROR(boost::format("Invalid server info for channel %1%") % getId());
@@ -266,10 +361,25 @@ void DefaultOperationLongPollChannel::doShutdown()
     KAA_MUTEX_LOCKING("channelGuard_");
     KAA_MUTEX_UNIQUE_DECLARE(lock, channelGuard_);
     KAA_MUTEX_LOCKED("channelGuard_");
-    if (!isShutdown_) {
-        isShutdown_ = true;
-        stopPoll();
-        io_.stop();
+    if (isShutdown_) {
+        return;
+    }
+
+    isShutdown_ = true;
+    stopPoll(lock);
+    io_.stop();
+    syncIo_.stop();
+
+    KAA_MUTEX_UNLOCKING("channelGuard_");
+    KAA_UNLOCK(lock);
+    KAA_MUTEX_UNLOCKED("channelGuard_");
+
+    // An in-flight sync request may wait for channelGuard_, so it is aborted with the lock released
+    syncClient_.closeConnection();
+    if (syncThread_.joinable()) {
+        syncThread_.join();
+    }
+    if (pollThread_.joinable()) {
         pollThread_.join();
     }
 }
@@ -290,7 +400,7 @@ void DefaultOperationLongPollChannel::pause()
     }
     if (!isPaused_) {
         isPaused_ = true;
-        stopPoll();
+        stopPoll(lock);
     }
 }
 
@@ -306,6 +416,7 @@ void DefaultOperationLongPollChannel::resume()
     if (isPaused_) {
         isPaused_ = false;
         startPoll();
+        postSyncTask({});
     }
 }
 
@@ -33,6 +33,7 @@
 #include "kaa/kaatcp/PingRequest.hpp"
 #include "kaa/kaatcp/DisconnectMessage.hpp"
 #include "kaa/http/HttpUtils.hpp"
+#include "kaa/metrics/MetricsRegistry.hpp"
 
 namespace kaa {
 
@@ -57,6 +58,8 @@ DefaultOperationTcpChannel::DefaultOperationTcpChannel(IKaaChannelManager *chann
     : clientKeys_(clientKeys), work_(io_), sock_(io_), pingTimer_(io_), reconnectTimer_(io_)
     , firstStart_(true), isConnected_(false), isFirstResponseReceived_(false), isPendingSyncRequest_(false)
     , isShutdown_(false), isPaused_(false), multiplexer_(nullptr), demultiplexer_(nullptr), channelManager_(channelManager)
+    , metrics_(nullptr), bytesSent_(nullptr), bytesReceived_(nullptr), connections_(nullptr), serverFailures_(nullptr)
+    , syncRoundTrip_(nullptr), isSyncInProgress_(false)
 {
     responsePorcessor.registerConnackReceiver(std::bind(&DefaultOperationTcpChannel::onConnack, this, std::placeholders::_1));
     responsePorcessor.registerKaaSyncReceiver(std::bind(&DefaultOperationTcpChannel::onKaaSync, this, std::placeholders::_1));
@@ -99,6 +102,13 @@ void DefaultOperationTcpChannel::onKaaSync(const KaaSyncResponse& message)
     KAA_MUTEX_LOCKING("channelGuard_");
     KAA_MUTEX_UNIQUE_DECLARE(lock, channelGuard_);
     KAA_MUTEX_LOCKED("channelGuard_");
+    if (isSyncInProgress_) {
+        isSyncInProgress_ = false;
+        if (syncRoundTrip_) {
+            syncRoundTrip_->record(std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - syncSentTime_).count());
+        }
+    }
     const auto& decodedResposne = encDec_->decodeData(encodedResponse.data(), encodedResponse.size());
     KAA_MUTEX_LOCKING("channelGuard_");
     KAA_UNLOCK(lock);
@@ -167,6 +177,9 @@ void DefaultOperationTcpChannel::openConnection()
     KAA_LOCK(channelGuard_);
     KAA_MUTEX_LOCKED("channelGuard_");
     isConnected_ = true;
+    if (connections_) {
+        connections_->increment();
+    }
     KAA_MUTEX_UNLOCKING("channelGuard_");
     KAA_UNLOCK(channelGuard_);
     KAA_MUTEX_UNLOCKED("channelGuard_");
@@ -184,6 +197,7 @@ void DefaultOperationTcpChannel::closeConnection()
     isFirstResponseReceived_ = false;
     isConnected_ = false;
     isPendingSyncRequest_ = false;
+    isSyncInProgress_ = false;
     KAA_MUTEX_UNLOCKING("channelGuard_");
     KAA_UNLOCK(lock);
     KAA_MUTEX_UNLOCKED("channelGuard_");
@@ -198,6 +212,10 @@ void DefaultOperationTcpChannel::closeConnection()
 
 void DefaultOperationTcpChannel::onServerFailed()
 {
+    if (serverFailures_) {
+        serverFailures_->increment();
+    }
+
     closeConnection();
 
     if (connectivityChecker_ && !connectivityChecker_->checkConnectivity()) {
@@ -216,6 +234,9 @@ boost::system::error_code DefaultOperationTcpChannel::sendData(const IKaaTcpRequ
     const auto& data = request.getRawMessage();
     KAA_LOG_TRACE(boost::format("Channel \"%1%\". Sending message size=%2%") % getId() % data.size());
     boost::asio::write(sock_, boost::asio::buffer(reinterpret_cast<const char *>(data.data()), data.size()), errorCode);
+    if (!errorCode && bytesSent_) {
+        bytesSent_->increment(data.size());
+    }
     return errorCode;
 }
 
@@ -227,6 +248,7 @@ boost::system::error_code DefaultOperationTcpChannel::sendKaaSync(const std::map
     KAA_LOG_DEBUG(boost::format("Channel \"%1%\". Sending KAASYNC message") % getId());
     const auto& requestBody = multiplexer_->compileRequest(transportTypes);
     const auto& requestEncoded = encDec_->encodeData(requestBody.data(), requestBody.size());
+    markSyncSent();
     return sendData(KaaSyncRequest(false, true, 0, requestEncoded, KaaSyncMessageType::SYNC));
 }
 
@@ -240,6 +262,7 @@ boost::system::error_code DefaultOperationTcpChannel::sendConnect()
     const auto& requestEncoded = encDec_->encodeData(requestBody.data(), requestBody.size());
     const auto& sessionKey = encDec_->getEncodedSessionKey();
     const auto& signature = encDec_->signData(sessionKey.begin(), sessionKey.size());
+    markSyncSent();
     return sendData(ConnectMessage(PING_TIMEOUT, KAA_PLATFORM_PROTOCOL_AVRO_ID, signature, sessionKey, requestEncoded));
 }
 
@@ -255,6 +278,14 @@ boost::system::error_code DefaultOperationTcpChannel::sendPingRequest()
     return sendData(PingRequest());
 }
 
+void DefaultOperationTcpChannel::markSyncSent()
+{
+    if (!isSyncInProgress_) {
+        isSyncInProgress_ = true;
+        syncSentTime_ = std::chrono::steady_clock::now();
+    }
+}
+
 void DefaultOperationTcpChannel::readFromSocket()
 {
     boost::asio::async_read(sock_, responseBuffer_,
@@ -282,6 +313,9 @@ void DefaultOperationTcpChannel::onReadEvent(const boost::system::error_code& er
         std::ostringstream responseStream;
         responseStream << &responseBuffer_;
         const auto& responseStr = responseStream.str();
+        if (bytesReceived_) {
+            bytesReceived_->increment(responseStr.size());
+        }
         responsePorcessor.processResponseBuffer(responseStr.data(), responseStr.size());
     } else if (err != boost::asio::error::eof) {
         KAA_MUTEX_LOCKING("channelGuard_");
@@ -353,6 +387,19 @@ void DefaultOperationTcpChannel::setDemultiplexer(IKaaDataDemultiplexer *demulti
     demultiplexer_ = demultiplexer;
 }
 
+void DefaultOperationTcpChannel::setMetricsRegistry(MetricsRegistry& registry)
+{
+    KAA_MUTEX_LOCKING("channelGuard_");
+    KAA_MUTEX_UNIQUE_DECLARE(channelLock, channelGuard_);
+    KAA_MUTEX_LOCKED("channelGuard_");
+    metrics_ = &registry;
+    bytesSent_ = &registry.getCounter("tcp.bytes_sent");
+    bytesReceived_ = &registry.getCounter("tcp.bytes_received");
+    connections_ = &registry.getCounter("tcp.connections");
+    serverFailures_ = &registry.getCounter("tcp.server_failures");
+    syncRoundTrip_ = &registry.getHistogram("tcp.sync_round_trip_us");
+}
+
 void DefaultOperationTcpChannel::setServer(ITransportConnectionInfoPtr server)
 {
     KAA_MUTEX_LOCKING("channelGuard_");
@@ -370,7 +417,7 @@ void DefaultOperationTcpChannel::setServer(ITransportConnectionInfoPtr server)
         }
 
         currentServer_.reset(new IPTransportInfo(server));
-        encDec_.reset(new RsaEncoderDecoder(clientKeys_.getPublicKey(), clientKeys_.getPrivateKey(), currentServer_->getPublicKey()));
+        encDec_.reset(new RsaEncoderDecoder(clientKeys_.getPublicKey(), clientKeys_.getPrivateKey(), currentServer_->getPublicKey(), metrics_));
 
         if (!isPaused_) {
             KAA_MUTEX_UNLOCKING("channelGuard_");
@@ -26,6 +26,13 @@ EndpointObjectHash::EndpointObjectHash(const std::uint8_t *data, const std::uint
     calculateHash(data, dataSize);
 }
 
+EndpointObjectHash EndpointObjectHash::fromDigest(const HashDigest& digest)
+{
+    EndpointObjectHash hash;
+    hash.hashDigest_ = digest;
+    return hash;
+}
+
 EndpointObjectHash::EndpointObjectHash(const std::string& str)
 {
     calculateHash(reinterpret_cast<const std::uint8_t *>(str.c_str()), str.size());
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaa/common/LzfCodec.hpp"
+
+#include <algorithm>
+
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+/*
+ * Stream format:
+ *  000LLLLL                      - literal run of L + 1 bytes following the control byte;
+ *  LLLOOOOO OOOOOOOO             - back reference of L + 2 bytes at distance O + 1;
+ *  111OOOOO LLLLLLLL OOOOOOOO    - back reference of L + 9 bytes at distance O + 1.
+ */
+static const std::size_t HASH_LOG = 13;
+static const std::size_t MAX_LITERAL_RUN = 32;
+static const std::size_t MIN_MATCH = 3;
+static const std::size_t MAX_MATCH = MIN_MATCH - 1 + 7 + 0xFF;
+static const std::size_t MAX_DISTANCE = 1 << 13;
+
+static inline std::uint32_t hash(const std::uint8_t *p)
+{
+    return ((static_cast<std::uint32_t>(p[0]) << 16 | static_cast<std::uint32_t>(p[1]) << 8 | p[2])
+                    * 2654435761U) >> (32 - HASH_LOG);
+}
+
+void LzfCodec::compress(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t>& out)
+{
+    std::vector<std::uint32_t> hashTable(1 << HASH_LOG, 0);
+
+    out.reserve(out.size() + size + size / MAX_LITERAL_RUN + 1);
+
+    std::size_t literalControl = out.size();
+    std::size_t literalCount = 0;
+    out.push_back(0);
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        if (pos + MIN_MATCH <= size) {
+            std::uint32_t& slot = hashTable[hash(data + pos)];
+            std::size_t ref = slot;
+            slot = pos;
+
+            if (ref < pos && pos - ref <= MAX_DISTANCE
+                    && data[ref] == data[pos] && data[ref + 1] == data[pos + 1] && data[ref + 2] == data[pos + 2]) {
+                std::size_t maxLength = std::min(size - pos, MAX_MATCH);
+                std::size_t length = MIN_MATCH;
+                while (length < maxLength && data[ref + length] == data[pos + length]) {
+                    ++length;
+                }
+
+                if (literalCount) {
+                    out[literalControl] = literalCount - 1;
+                } else {
+                    out.pop_back();
+                }
+
+                std::size_t distance = pos - ref - 1;
+                std::size_t encodedLength = length - 2;
+                if (encodedLength < 7) {
+                    out.push_back((encodedLength << 5) | (distance >> 8));
+                } else {
+                    out.push_back((7 << 5) | (distance >> 8));
+                    out.push_back(encodedLength - 7);
+                }
+                out.push_back(distance & 0xFF);
+
+                std::size_t matchEnd = pos + length;
+                for (++pos; pos < matchEnd && pos + MIN_MATCH <= size; ++pos) {
+                    hashTable[hash(data + pos)] = pos;
+                }
+                pos = matchEnd;
+
+                literalControl = out.size();
+                literalCount = 0;
+                out.push_back(0);
+                continue;
+            }
+        }
+
+        out.push_back(data[pos++]);
+        if (++literalCount == MAX_LITERAL_RUN) {
+            out[literalControl] = MAX_LITERAL_RUN - 1;
+            literalControl = out.size();
+            literalCount = 0;
+            out.push_back(0);
+        }
+    }
+
+    if (literalCount) {
+        out[literalControl] = literalCount - 1;
+    } else {
+        out.pop_back();
+    }
+}
+
+std::vector<std::uint8_t> LzfCodec::decompress(const std::uint8_t *data, std::size_t size, std::size_t rawSize)
+{
+    std::vector<std::uint8_t> out;
+    out.reserve(rawSize);
+
+    const std::uint8_t *end = data + size;
+    while (data < end) {
+        std::size_t control = *data++;
+        if (control < MAX_LITERAL_RUN) {
+            std::size_t length = control + 1;
+            if (static_cast<std::size_t>(end - data) < length || out.size() + length > rawSize) {
+                throw KaaException("Corrupted LZF stream: literal run is out of bounds");
+            }
+            out.insert(out.end(), data, data + length);
+            data += length;
+        } else {
+            std::size_t length = control >> 5;
+            if (length == 7) {
+                if (data == end) {
+                    throw KaaException("Corrupted LZF stream: unexpected end");
+                }
+                length += *data++;
+            }
+            length += 2;
+
+            if (data == end) {
+                throw KaaException("Corrupted LZF stream: unexpected end");
+            }
+            std::size_t distance = (((control & 0x1F) << 8) | *data++) + 1;
+            if (distance > out.size() || out.size() + length > rawSize) {
+                throw KaaException("Corrupted LZF stream: back reference is out of bounds");
+            }
+
+            std::size_t from = out.size() - distance;
+            for (std::size_t i = 0; i < length; ++i) {
+                out.push_back(out[from + i]);
+            }
+        }
+    }
+
+    if (out.size() != rawSize) {
+        throw KaaException("Corrupted LZF stream: unexpected size");
+    }
+
+    return out;
+}
+
+}  // namespace kaa
@@ -54,6 +54,7 @@ void ConfigurationPersistenceManager::onConfigurationUpdated(const KaaRootConfig
 
     AvroByteArrayConverter<KaaRootConfiguration> converter;
     SharedDataBuffer buffer = converter.toByteArray(configuration);
+    EndpointObjectHash updatedHash(buffer);
 
     KAA_LOG_INFO(boost::format("Going to store configuration using configuration storage %1%") % storage_);
 
@@ -62,14 +63,15 @@ void ConfigurationPersistenceManager::onConfigurationUpdated(const KaaRootConfig
     KAA_MUTEX_LOCKED("confPersistenceGuard_");
 
     if (storage_) {
-        storage_->saveConfiguration(std::vector<std::uint8_t>(buffer.first.get(), buffer.first.get() + buffer.second));
+        storage_->saveConfiguration(std::vector<std::uint8_t>(buffer.first.get(), buffer.first.get() + buffer.second),
+                                    updatedHash.getHashDigest());
     }
 
     KAA_MUTEX_UNLOCKING("confPersistenceGuard_");
     KAA_UNLOCK(storage_lock);
     KAA_MUTEX_UNLOCKED("confPersistenceGuard_");
 
-    configurationHash_ = EndpointObjectHash(buffer);
+    configurationHash_ = updatedHash;
 
     KAA_LOG_INFO(boost::format("Calculated configuration hash: %1%") % LoggingUtils::ByteArrayToString(configurationHash_.getHashDigest()));
 }
@@ -98,7 +100,12 @@ void ConfigurationPersistenceManager::readStoredConfiguration()
                 processor_->processConfigurationData(bytes.data(), bytes.size(), true);
             }
 
-            configurationHash_ = EndpointObjectHash(bytes.data(), bytes.size());
+            HashDigest storedHash = storage_->getConfigurationHash();
+            if (!storedHash.empty()) {
+                configurationHash_ = EndpointObjectHash::fromDigest(storedHash);
+            } else {
+                configurationHash_ = EndpointObjectHash(bytes.data(), bytes.size());
+            }
             KAA_LOG_INFO(boost::format("Calculated configuration hash: %1%") % LoggingUtils::ByteArrayToString(configurationHash_.getHashDigest()));
         }
     }
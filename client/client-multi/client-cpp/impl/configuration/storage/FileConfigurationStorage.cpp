@@ -16,18 +16,148 @@
 
 #include "kaa/configuration/storage/FileConfigurationStorage.hpp"
 
+#include <cctype>
+#include <cstdio>
 #include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include "kaa/logging/Log.hpp"
 
 namespace kaa {
 
+#ifndef _WIN32
+static void syncParentDirectory(const std::string& filename)
+{
+    std::size_t separatorPos = filename.find_last_of('/');
+    std::string directory = (separatorPos == std::string::npos) ? "." : filename.substr(0, separatorPos + 1);
+
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+#endif
+
+/**
+ * Writes data to a temporary file and renames it over the target one,
+ * so the target file contains either the old or the new data.
+ */
+static bool writeFileAtomically(const std::string& filename, const std::uint8_t *data, std::size_t size)
+{
+    const std::string tmpFilename = filename + ".tmp";
+
+#ifndef _WIN32
+    int fd = ::open(tmpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::size_t written = 0;
+    while (written < size) {
+        ssize_t result = ::write(fd, data + written, size - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        written += result;
+    }
+
+    bool isSynced = (written == size) && (::fsync(fd) == 0);
+    ::close(fd);
+#else
+    std::ofstream outFile(tmpFilename, std::ofstream::binary);
+    outFile.write(reinterpret_cast<const char *>(data), size);
+    outFile.close();
+
+    bool isSynced = outFile.good();
+#endif
+
+#ifndef _WIN32
+    bool isRenamed = isSynced && std::rename(tmpFilename.c_str(), filename.c_str()) == 0;
+#else
+    // rename() does not replace existing files on Windows
+    bool isRenamed = isSynced && ::MoveFileExA(tmpFilename.c_str(), filename.c_str(),
+                                               MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#endif
+
+    if (!isRenamed) {
+        std::remove(tmpFilename.c_str());
+        return false;
+    }
+
+#ifndef _WIN32
+    syncParentDirectory(filename);
+#endif
+    return true;
+}
+
+/**
+ * Size and modification time of the file, used to detect that the data file was changed
+ * after its hash had been stored.
+ */
+static bool getFileStamp(const std::string& filename, std::size_t& size, std::int64_t& modificationTime)
+{
+    struct stat fileStat;
+    if (::stat(filename.c_str(), &fileStat) != 0) {
+        return false;
+    }
+
+    size = fileStat.st_size;
+    modificationTime = fileStat.st_mtime;
+    return true;
+}
 
 void FileConfigurationStorage::saveConfiguration(std::vector<std::uint8_t>&& bytes)
 {
-    std::ofstream outFile(filename_, std::ofstream::binary);
-    if (outFile.good()) {
-        outFile.write(reinterpret_cast<char *>(bytes.data()), bytes.size());
-        outFile.close();
+    HashDigest hash;
+    if (!bytes.empty()) {
+        hash = EndpointObjectHash(bytes.data(), bytes.size()).getHashDigest();
+    }
+
+    saveConfiguration(std::move(bytes), hash);
+}
+
+void FileConfigurationStorage::saveConfiguration(std::vector<std::uint8_t>&& bytes, const HashDigest& hash)
+{
+    HashDigest newHash;
+    if (!bytes.empty()) {
+        newHash = hash;
+        if (newHash == getConfigurationHash()) {
+            KAA_LOG_DEBUG("Configuration is byte-identical to the stored one, skipping write");
+            return;
+        }
+    }
+
+    /*
+     * Drop the hash before replacing the data, so it can't be taken for the hash of the new data
+     * if a crash happens in between.
+     */
+    std::remove(getHashFilename().c_str());
+    hash_.clear();
+
+    if (!writeFileAtomically(filename_, bytes.data(), bytes.size())) {
+        KAA_LOG_ERROR(boost::format("Failed to save configuration to '%1%'") % filename_);
+        return;
+    }
+
+    hash_ = std::move(newHash);
+    if (!hash_.empty()) {
+        saveHash();
     }
 }
 
@@ -47,5 +177,71 @@ std::vector<std::uint8_t> FileConfigurationStorage::loadConfiguration()
     return std::vector<std::uint8_t>();
 }
 
+HashDigest FileConfigurationStorage::getConfigurationHash()
+{
+    if (hash_.empty()) {
+        readStoredHash();
+    }
+    return hash_;
+}
+
+void FileConfigurationStorage::readStoredHash()
+{
+    std::size_t dataSize = 0;
+    std::int64_t dataModificationTime = 0;
+    if (!getFileStamp(filename_, dataSize, dataModificationTime)) {
+        return;
+    }
+
+    std::ifstream hashFile(getHashFilename());
+
+    std::size_t storedSize = 0;
+    std::int64_t storedModificationTime = 0;
+    std::string hexHash;
+    if (!(hashFile >> storedSize >> storedModificationTime >> hexHash)
+            || storedSize != dataSize || storedModificationTime != dataModificationTime) {
+        KAA_LOG_DEBUG(boost::format("Ignoring stale or missing configuration hash '%1%'") % getHashFilename());
+        return;
+    }
+
+    if (hexHash.empty() || hexHash.length() % 2) {
+        KAA_LOG_WARN(boost::format("Ignoring malformed configuration hash '%1%'") % getHashFilename());
+        return;
+    }
+
+    HashDigest hash;
+    hash.reserve(hexHash.length() / 2);
+    for (std::size_t i = 0; i < hexHash.length(); i += 2) {
+        if (!std::isxdigit(static_cast<unsigned char>(hexHash[i])) || !std::isxdigit(static_cast<unsigned char>(hexHash[i + 1]))) {
+            KAA_LOG_WARN(boost::format("Ignoring malformed configuration hash '%1%'") % getHashFilename());
+            return;
+        }
+        hash.push_back(std::stoi(hexHash.substr(i, 2), nullptr, 16));
+    }
+
+    hash_ = std::move(hash);
+}
+
+void FileConfigurationStorage::saveHash()
+{
+    std::size_t dataSize = 0;
+    std::int64_t dataModificationTime = 0;
+    if (!getFileStamp(filename_, dataSize, dataModificationTime)) {
+        KAA_LOG_WARN(boost::format("Failed to stat configuration file '%1%'") % filename_);
+        return;
+    }
+
+    std::ostringstream ss;
+    ss << dataSize << " " << dataModificationTime << " ";
+    for (auto byte : hash_) {
+        ss << std::setw(2) << std::setfill('0') << std::hex << (int)byte;
+    }
+    ss << std::endl;
+
+    const std::string content = ss.str();
+    if (!writeFileAtomically(getHashFilename(), reinterpret_cast<const std::uint8_t *>(content.data()), content.size())) {
+        KAA_LOG_WARN(boost::format("Failed to save configuration hash to '%1%'") % getHashFilename());
+    }
 }
 
+}
@@ -44,6 +44,12 @@ void EventManager::registerEventFamily(IEventFamily* eventFamily)
 
 void EventManager::produceEvent(const std::string& fqn, const std::vector<std::uint8_t>& data,
                                 const std::string& target, TransactionIdPtr trxId)
+{
+    produceEvent(fqn, std::vector<std::uint8_t>(data), target, trxId);
+}
+
+void EventManager::produceEvent(const std::string& fqn, std::vector<std::uint8_t>&& data,
+                                const std::string& target, TransactionIdPtr trxId)
 {
     if (fqn.empty() || data.empty()) {
         KAA_LOG_WARN("Failed to process outgoing event: bad input data");
@@ -55,7 +61,7 @@ void EventManager::produceEvent(const std::string& fqn, const std::vector<std::u
 
     Event event;
     event.eventClassFQN = fqn;
-    event.eventData.assign(data.begin(), data.end());
+    event.eventData = std::move(data);
 
     if (target.empty()) {
         event.target.set_null();
@@ -64,14 +70,24 @@ void EventManager::produceEvent(const std::string& fqn, const std::vector<std::u
     }
 
     if (trxId) {
-        getContainerByTrxId(trxId).push_back(event);
+        addToTransaction(trxId, std::move(event));
         return;
     }
     KAA_LOG_TRACE(boost::format("New event %1% is produced for %2%") % fqn % target);
 
-    {
-        KAA_MUTEX_UNIQUE_DECLARE(internalLock, pendingEventsGuard_);
-        pendingEvents_.insert(std::make_pair(currentEventIndex_++, event));
+    KAA_MUTEX_UNIQUE_DECLARE(internalLock, pendingEventsGuard_);
+    std::size_t droppedBefore = droppedEventsCount_;
+    bool isEnqueued = enqueuePendingEvent(std::move(event));
+    std::size_t droppedEventsCount = droppedEventsCount_;
+    IEventQueueListener *listener = eventQueueListener_;
+    KAA_UNLOCK(internalLock);
+
+    if (droppedEventsCount != droppedBefore) {
+        onEventsDropped(droppedEventsCount, listener);
+    }
+
+    if (!isEnqueued) {
+        return;
     }
 
     if (eventTransport_) {
@@ -81,15 +97,118 @@ void EventManager::produceEvent(const std::string& fqn, const std::vector<std::u
     }
 }
 
+std::size_t EventManager::getEventSize(const Event& event)
+{
+    return event.eventData.size() + event.eventClassFQN.size()
+            + (event.target.is_null() ? 0 : event.target.get_string().size());
+}
+
+bool EventManager::isEventQueueFull(std::size_t eventSize) const
+{
+    return (pendingEvents_.size() + inFlightEventsCount_ >= maxPendingEventsCount_)
+            || (pendingEventsSize_ + inFlightEventsSize_ + eventSize > maxPendingEventsSize_);
+}
+
+bool EventManager::enqueuePendingEvent(Event&& event)
+{
+    std::size_t eventSize = getEventSize(event);
+
+    bool isFull = isEventQueueFull(eventSize);
+
+    if (isFull) {
+        isEventQueueFull_ = true;
+
+        if (overflowPolicy_ == EventQueueOverflowPolicy::REJECT_NEW || eventSize > maxPendingEventsSize_) {
+            ++droppedEventsCount_;
+            KAA_LOG_WARN(boost::format("Event '%1%' rejected: pending events queue is full") % event.eventClassFQN);
+            return false;
+        }
+
+        while (!pendingEvents_.empty() && isEventQueueFull(eventSize)) {
+            auto oldest = pendingEvents_.begin();
+            KAA_LOG_WARN(boost::format("Event '%1%' dropped: pending events queue is full")
+                                                                    % oldest->second.eventClassFQN);
+            pendingEventsSize_ -= getEventSize(oldest->second);
+            pendingEvents_.erase(oldest);
+            ++droppedEventsCount_;
+        }
+
+        if (isEventQueueFull(eventSize)) {
+            ++droppedEventsCount_;
+            KAA_LOG_WARN(boost::format("Event '%1%' rejected: events queue is full of events being sent")
+                                                                    % event.eventClassFQN);
+            return false;
+        }
+    }
+
+    pendingEventsSize_ += eventSize;
+    pendingEvents_.insert(std::make_pair(currentEventIndex_++, std::move(event)));
+    return true;
+}
+
+void EventManager::onEventsDropped(std::size_t droppedEventsCount, IEventQueueListener *listener)
+{
+    if (listener) {
+        listener->onEventQueueFull(droppedEventsCount);
+    }
+}
+
+void EventManager::setPendingEventsLimits(std::size_t maxCount, std::size_t maxSize, EventQueueOverflowPolicy policy)
+{
+    if (!maxCount || !maxSize) {
+        throw KaaException("Pending events limits should be greater than zero");
+    }
+
+    KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
+    maxPendingEventsCount_ = maxCount;
+    maxPendingEventsSize_ = maxSize;
+    overflowPolicy_ = policy;
+}
+
+void EventManager::setEventQueueListener(IEventQueueListener *listener)
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
+    eventQueueListener_ = listener;
+}
+
+std::size_t EventManager::getDroppedEventsCount() const
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
+    return droppedEventsCount_;
+}
+
 std::map<std::int32_t, Event> EventManager::releasePendingEvents()
 {
     KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
     std::map<std::int32_t, Event> result(std::move(pendingEvents_));
     pendingEvents_ = std::map<std::int32_t, Event>();
+    inFlightEventsCount_ += result.size();
+    inFlightEventsSize_ += pendingEventsSize_;
+    pendingEventsSize_ = 0;
     currentEventIndex_ = 0;
     return result;
 }
 
+void EventManager::onEventsDelivered(const std::list<Event>& events)
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
+    for (const auto& event : events) {
+        inFlightEventsSize_ -= std::min(inFlightEventsSize_, getEventSize(event));
+    }
+    inFlightEventsCount_ -= std::min(inFlightEventsCount_, events.size());
+
+    bool isAvailable = isEventQueueFull_ && !isEventQueueFull(0);
+    if (isAvailable) {
+        isEventQueueFull_ = false;
+    }
+    IEventQueueListener *listener = eventQueueListener_;
+    KAA_UNLOCK(lock);
+
+    if (isAvailable && listener) {
+        listener->onEventQueueAvailable();
+    }
+}
+
 bool EventManager::hasPendingEvents() const
 {
     KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
@@ -236,16 +355,23 @@ void EventManager::setTransport(EventTransport *transport)
 
 void EventManager::commit(TransactionIdPtr trxId)
 {
-    auto it = transactions_.find(trxId);
-    if (it != transactions_.end()) {
+    std::list<Event> events;
+    if (releaseTransaction(trxId, events)) {
         KAA_MUTEX_UNIQUE_DECLARE(lock, pendingEventsGuard_);
-        std::list<Event> & events = it->second;
+        std::size_t droppedBefore = droppedEventsCount_;
+        bool isEnqueued = false;
         for (Event &e : events) {
-            pendingEvents_.insert(std::make_pair(currentEventIndex_++, std::move(e)));
+            isEnqueued = enqueuePendingEvent(std::move(e)) || isEnqueued;
         }
-        transactions_.erase(it);
+        std::size_t droppedEventsCount = droppedEventsCount_;
+        IEventQueueListener *listener = eventQueueListener_;
         KAA_UNLOCK(lock);
-        if (eventTransport_) {
+
+        if (droppedEventsCount != droppedBefore) {
+            onEventsDropped(droppedEventsCount, listener);
+        }
+
+        if (isEnqueued && eventTransport_) {
             eventTransport_->sync();
         }
     }
@@ -114,7 +114,16 @@ void EventTransport::onEventResponse(const EventSyncResponse& response)
 void EventTransport::onSyncResponseId(std::int32_t requestId)
 {
     KAA_MUTEX_UNIQUE_DECLARE(lock, eventsGuard_);
-    events_.erase(requestId);
+    auto it = events_.find(requestId);
+    if (it == events_.end()) {
+        return;
+    }
+
+    std::list<Event> deliveredEvents(std::move(it->second));
+    events_.erase(it);
+    KAA_UNLOCK(lock);
+
+    eventDataProcessor_.onEventsDelivered(deliveredEvents);
 }
 
 void EventTransport::sync()
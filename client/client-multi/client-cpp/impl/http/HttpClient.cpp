@@ -55,16 +55,20 @@ std::shared_ptr<IHttpResponse> HttpClient::sendRequest(const IHttpRequest& reque
     checkError(errorCode);
     boost::asio::write(sock_, boost::asio::buffer(data.data(), data.size()), errorCode);
     checkError(errorCode);
-    std::ostringstream responseStream;
-    boost::asio::streambuf responseBuf;
-    while (boost::asio::read(sock_, responseBuf, boost::asio::transfer_at_least(1), errorCode)) {
-        responseStream << &responseBuf;
+    std::shared_ptr<HttpResponse> response(new HttpResponse);
+    char responseBuf[RESPONSE_BUFFER_SIZE];
+    while (!response->isComplete()) {
+        std::size_t bytesRead = sock_.read_some(boost::asio::buffer(responseBuf), errorCode);
+        if (errorCode == boost::asio::error::eof) {
+            response->finish();
+            break;
+        }
+        checkError(errorCode);
+        response->feed(responseBuf, bytesRead);
     }
-    checkError(errorCode);
-    const std::string& responseStr = responseStream.str();
     KAA_LOG_INFO(boost::format("Response from server %1%:%2% successfully received") % request.getHost() % request.getPort());
     doSocketClose();
-    return std::shared_ptr<IHttpResponse>(new HttpResponse(responseStr));
+    return response;
 }
 
 void HttpClient::closeConnection()
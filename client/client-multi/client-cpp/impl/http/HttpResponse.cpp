@@ -20,33 +20,80 @@
     defined(KAA_DEFAULT_OPERATION_HTTP_CHANNEL) || \
     defined(KAA_DEFAULT_LONG_POLL_CHANNEL)
 
+#include <cerrno>
+#include <cctype>
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdint>
+
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "kaa/common/exception/KaaException.hpp"
 
 namespace kaa {
 
-HttpResponse::HttpResponse(const char *data, std::size_t len) : statusCode_(0)
+/*
+ * Parses a non-negative number which may only be followed by @c terminators.
+ */
+static bool parseSize(const std::string& value, int base, const char *terminators, unsigned long long& size)
+{
+    if (value.empty() || !std::isxdigit(static_cast<unsigned char>(value[0]))) {
+        return false;
+    }
+
+    char *parsedEnd = nullptr;
+    errno = 0;
+    size = std::strtoull(value.c_str(), &parsedEnd, base);
+    if (errno == ERANGE || parsedEnd == value.c_str()) {
+        return false;
+    }
+
+    return (*parsedEnd == '\0' || std::strchr(terminators, *parsedEnd));
+}
+
+HttpResponse::HttpResponse()
+    : bodyCapacity_(0), bytesToRead_(0), lineCompleted_(false), state_(ParserState::STATUS_LINE), statusCode_(0)
 {
+    body_.second = 0;
+}
+
+HttpResponse::HttpResponse(const char *data, std::size_t len)
+    : bodyCapacity_(0), bytesToRead_(0), lineCompleted_(false), state_(ParserState::STATUS_LINE), statusCode_(0)
+{
+    body_.second = 0;
     if (data == nullptr || len < HTTP_VERSION_OFFSET + 5) {
         throw KaaException("Empty response was given");
     }
-    parseResponse(data, len);
+    feed(data, len);
+    finish();
 }
 
-HttpResponse::HttpResponse(const std::string& data) : statusCode_(0)
+HttpResponse::HttpResponse(const std::string& data)
+    : bodyCapacity_(0), bytesToRead_(0), lineCompleted_(false), state_(ParserState::STATUS_LINE), statusCode_(0)
 {
+    body_.second = 0;
     if (data.length() < HTTP_VERSION_OFFSET + 5) {
         throw KaaException("Empty response was given");
     }
-    parseResponse(data.c_str(), data.length());
+    feed(data.data(), data.length());
+    finish();
 }
 
 std::string HttpResponse::getHeaderField(const std::string& name) const
 {
     auto it = header_.find(name);
-    return it != header_.end() ? it->second : std::string();
+    if (it != header_.end()) {
+        return it->second;
+    }
+
+    // Header field names are case-insensitive
+    for (const auto& field : header_) {
+        if (boost::iequals(field.first, name)) {
+            return field.second;
+        }
+    }
+    return std::string();
 }
 
 SharedBody HttpResponse::getBody() const
@@ -59,36 +106,213 @@ int HttpResponse::getStatusCode() const
     return statusCode_;
 }
 
-void HttpResponse::parseResponse(const char *data, std::size_t len)
+std::size_t HttpResponse::feed(const char *data, std::size_t len)
 {
     const char *cursor = data;
-    cursor += HTTP_VERSION_OFFSET;
-    std::string code(cursor, 3);
-    statusCode_ = static_cast<int>(std::strtol(code.c_str(), nullptr, 10));
-    cursor = strstr(data, "\r\n") + 2;
-
-    bool headerProcessed = false;
-    while (!headerProcessed) {
-        auto sep = strchr(cursor, ':');
-        std::string name(cursor, sep - cursor);
-        cursor = sep + 2;
-        auto end = strstr(cursor, "\r\n");
-        std::string value(cursor, end - cursor);
-        cursor = end + 2;
-        header_.insert(std::make_pair(name, value));
-        if (strstr(cursor, "\r\n") == cursor) {
-            cursor += 2;
-            headerProcessed = true;
+    const char *end = data + len;
+
+    while (cursor < end && state_ != ParserState::COMPLETE) {
+        switch (state_) {
+        case ParserState::STATUS_LINE:
+            if (readLine(cursor, end)) {
+                processStatusLine();
+                state_ = ParserState::HEADERS;
+            }
+            break;
+        case ParserState::HEADERS:
+            if (readLine(cursor, end)) {
+                if (line_.empty()) {
+                    processHeadersEnd();
+                } else {
+                    processHeaderLine();
+                }
+            }
+            break;
+        case ParserState::BODY:
+        case ParserState::CHUNK_DATA: {
+            std::size_t portion = std::min<std::size_t>(bytesToRead_, end - cursor);
+            appendBody(cursor, portion);
+            cursor += portion;
+            bytesToRead_ -= portion;
+            if (!bytesToRead_) {
+                state_ = (state_ == ParserState::BODY ? ParserState::COMPLETE : ParserState::CHUNK_DATA_END);
+            }
+            break;
+        }
+        case ParserState::BODY_UNTIL_CLOSE:
+            if (static_cast<std::size_t>(end - cursor) > MAX_BODY_SIZE - body_.second) {
+                throw KaaException("HTTP response body is too large");
+            }
+            reserveBody(body_.second + (end - cursor));
+            appendBody(cursor, end - cursor);
+            cursor = end;
+            break;
+        case ParserState::CHUNK_DATA_END:
+            if (readLine(cursor, end)) {
+                if (!line_.empty()) {
+                    throw KaaException("Chunk data isn't followed by CRLF");
+                }
+                state_ = ParserState::CHUNK_SIZE;
+            }
+            break;
+        case ParserState::CHUNK_SIZE:
+            if (readLine(cursor, end)) {
+                processChunkSizeLine();
+            }
+            break;
+        case ParserState::CHUNK_TRAILER:
+            if (readLine(cursor, end) && line_.empty()) {
+                state_ = ParserState::COMPLETE;
+            }
+            break;
+        case ParserState::COMPLETE:
+            break;
         }
     }
-    auto it = header_.find("Content-Length");
-    if (it != header_.end()) {
-        auto len = std::strtol(it->second.c_str(), nullptr, 10);
-        if (len > 0) {
-            body_.first.reset(new std::uint8_t[len]);
-            body_.second = len;
-            memcpy(body_.first.get(), cursor, len);
+
+    return cursor - data;
+}
+
+void HttpResponse::finish()
+{
+    if (state_ == ParserState::BODY_UNTIL_CLOSE) {
+        state_ = ParserState::COMPLETE;
+    } else if (state_ == ParserState::STATUS_LINE && line_.empty()) {
+        throw KaaException("Empty response was given");
+    } else if (state_ != ParserState::COMPLETE) {
+        throw KaaException("Connection was closed before the response was completed");
+    }
+}
+
+bool HttpResponse::readLine(const char *&cursor, const char *end)
+{
+    if (lineCompleted_) {
+        line_.clear();
+        lineCompleted_ = false;
+    }
+
+    const char *eol = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+    const char *lineEnd = (eol ? eol : end);
+
+    if (line_.size() + (lineEnd - cursor) > MAX_LINE_LENGTH) {
+        throw KaaException("HTTP response line is too long");
+    }
+
+    line_.append(cursor, lineEnd);
+    cursor = (eol ? eol + 1 : end);
+
+    if (eol) {
+        if (!line_.empty() && line_.back() == '\r') {
+            line_.pop_back();
         }
+        lineCompleted_ = true;
+    }
+    return lineCompleted_;
+}
+
+void HttpResponse::processStatusLine()
+{
+    if (line_.size() < HTTP_VERSION_OFFSET + 3 || line_.compare(0, 5, "HTTP/") != 0) {
+        throw KaaException("Invalid HTTP status line");
+    }
+
+    std::string code(line_, HTTP_VERSION_OFFSET, 3);
+    statusCode_ = static_cast<int>(std::strtol(code.c_str(), nullptr, 10));
+}
+
+void HttpResponse::processHeaderLine()
+{
+    auto sep = line_.find(':');
+    if (sep == std::string::npos) {
+        throw KaaException("Invalid HTTP header field");
+    }
+
+    auto valueBegin = line_.find_first_not_of(" \t", sep + 1);
+    auto valueEnd = line_.find_last_not_of(" \t");
+    std::string value;
+    if (valueBegin != std::string::npos && valueEnd >= valueBegin) {
+        value.assign(line_, valueBegin, valueEnd - valueBegin + 1);
+    }
+    header_.insert(std::make_pair(line_.substr(0, sep), value));
+}
+
+void HttpResponse::processHeadersEnd()
+{
+    if (statusCode_ == 204 || statusCode_ == 304) {
+        state_ = ParserState::COMPLETE;
+        return;
+    }
+
+    const std::string& transferEncoding = getHeaderField("Transfer-Encoding");
+    if (boost::icontains(transferEncoding, "chunked")) {
+        state_ = ParserState::CHUNK_SIZE;
+        return;
+    }
+
+    const std::string& contentLength = getHeaderField("Content-Length");
+    if (contentLength.empty()) {
+        state_ = ParserState::BODY_UNTIL_CLOSE;
+        return;
+    }
+
+    unsigned long long len = 0;
+    if (!parseSize(contentLength, 10, "", len)) {
+        throw KaaException(boost::format("Invalid Content-Length: %1%") % contentLength);
+    }
+
+    if (len > MAX_BODY_SIZE) {
+        throw KaaException(boost::format("Content-Length is too large: %1%") % contentLength);
+    }
+
+    if (len > 0) {
+        reserveBody(len);
+        bytesToRead_ = len;
+        state_ = ParserState::BODY;
+    } else {
+        state_ = ParserState::COMPLETE;
+    }
+}
+
+void HttpResponse::processChunkSizeLine()
+{
+    unsigned long long chunkSize = 0;
+    if (!parseSize(line_, 16, ";", chunkSize)) {
+        throw KaaException(boost::format("Invalid chunk size: %1%") % line_);
+    }
+
+    if (chunkSize > MAX_BODY_SIZE - body_.second) {
+        throw KaaException(boost::format("Chunk size is too large: %1%") % line_);
+    }
+
+    if (chunkSize > 0) {
+        reserveBody(body_.second + chunkSize);
+        bytesToRead_ = chunkSize;
+        state_ = ParserState::CHUNK_DATA;
+    } else {
+        state_ = ParserState::CHUNK_TRAILER;
+    }
+}
+
+void HttpResponse::reserveBody(std::size_t size)
+{
+    if (size <= bodyCapacity_) {
+        return;
+    }
+
+    std::size_t capacity = std::max(size, bodyCapacity_ * 2);
+    boost::shared_array<std::uint8_t> buffer(new std::uint8_t[capacity]);
+    if (body_.second) {
+        std::memcpy(buffer.get(), body_.first.get(), body_.second);
+    }
+    body_.first = buffer;
+    bodyCapacity_ = capacity;
+}
+
+void HttpResponse::appendBody(const char *data, std::size_t len)
+{
+    if (len) {
+        std::memcpy(body_.first.get() + body_.second, data, len);
+        body_.second += len;
     }
 }
 
@@ -28,6 +28,7 @@ const std::size_t DefaultLogUploadStrategy::DEFAULT_RETRY_PERIOD;
 
 const std::size_t DefaultLogUploadStrategy::DEFAULT_UPLOAD_VOLUME_THRESHOLD;
 const std::size_t DefaultLogUploadStrategy::DEFAULT_UPLOAD_COUNT_THRESHOLD;
+const std::size_t DefaultLogUploadStrategy::DEFAULT_CRITICAL_UPLOAD_COUNT_THRESHOLD;
 
 DefaultLogUploadStrategy::DefaultLogUploadStrategy(IKaaChannelManagerPtr manager)
 {
@@ -43,13 +44,19 @@ LogUploadStrategyDecision DefaultLogUploadStrategy::isUploadNeeded(ILogStorageSt
 {
     LogUploadStrategyDecision decision = LogUploadStrategyDecision::NOOP;
 
-    if (nextUploadAttemptTS_.time_since_epoch().count()) {
-        if (Clock::now() >= nextUploadAttemptTS_) {
-            KAA_LOG_INFO("Retry log upload after failure");
-            nextUploadAttemptTS_ = std::chrono::time_point<Clock>();
-            decision = LogUploadStrategyDecision::UPLOAD;
+    {
+        KAA_MUTEX_LOCKING(nextUploadAttemptGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, nextUploadAttemptGuard_);
+        KAA_MUTEX_LOCKED(nextUploadAttemptGuard_);
+
+        if (nextUploadAttemptTS_.time_since_epoch().count()) {
+            if (Clock::now() >= nextUploadAttemptTS_) {
+                KAA_LOG_INFO("Retry log upload after failure");
+                nextUploadAttemptTS_ = std::chrono::time_point<Clock>();
+                decision = LogUploadStrategyDecision::UPLOAD;
+            }
+            return decision;
         }
-        return decision;
     }
 
     if (status.getConsumedVolume() >= uploadVolumeThreshold_) {
@@ -60,11 +67,34 @@ LogUploadStrategyDecision DefaultLogUploadStrategy::isUploadNeeded(ILogStorageSt
         KAA_LOG_INFO(boost::format("Need to upload logs - current record count: %1%, max: %2%")
                                         % status.getRecordsCount() % uploadCountThreshold_);
         decision = LogUploadStrategyDecision::UPLOAD;
+    } else {
+        decision = checkPriorityThresholds(status);
     }
 
     return decision;
 }
 
+LogUploadStrategyDecision DefaultLogUploadStrategy::checkPriorityThresholds(ILogStorageStatus& status)
+{
+    for (std::size_t i = LOG_PRIORITY_COUNT; i-- > 0;) {
+        LogPriority priority = static_cast<LogPriority>(i);
+
+        if (priorityVolumeThresholds_[i] && status.getConsumedVolume(priority) >= priorityVolumeThresholds_[i]) {
+            KAA_LOG_INFO(boost::format("Need to upload logs - current size of priority %1% logs: %2%, max: %3%")
+                                        % i % status.getConsumedVolume(priority) % priorityVolumeThresholds_[i]);
+            return LogUploadStrategyDecision::UPLOAD;
+        }
+
+        if (priorityCountThresholds_[i] && status.getRecordsCount(priority) >= priorityCountThresholds_[i]) {
+            KAA_LOG_INFO(boost::format("Need to upload logs - current count of priority %1% logs: %2%, max: %3%")
+                                        % i % status.getRecordsCount(priority) % priorityCountThresholds_[i]);
+            return LogUploadStrategyDecision::UPLOAD;
+        }
+    }
+
+    return LogUploadStrategyDecision::NOOP;
+}
+
 void DefaultLogUploadStrategy::onTimeout()
 {
     KAA_LOG_WARN("Log upload timeout occurred. Try to switch to another Operations server");
@@ -83,11 +113,17 @@ void DefaultLogUploadStrategy::onFailure(LogDeliveryErrorCode code)
         case LogDeliveryErrorCode::NO_APPENDERS_CONFIGURED:
         case LogDeliveryErrorCode::APPENDER_INTERNAL_ERROR:
         case LogDeliveryErrorCode::REMOTE_CONNECTION_ERROR:
-        case LogDeliveryErrorCode::REMOTE_INTERNAL_ERROR:
+        case LogDeliveryErrorCode::REMOTE_INTERNAL_ERROR: {
             KAA_LOG_WARN(boost::format("Log upload failed with error code %1%. Retry upload after %2% seconds")
                                                                                            % code % retryReriod_);
+
+            KAA_MUTEX_LOCKING(nextUploadAttemptGuard_);
+            KAA_MUTEX_UNIQUE_DECLARE(lock, nextUploadAttemptGuard_);
+            KAA_MUTEX_LOCKED(nextUploadAttemptGuard_);
+
             nextUploadAttemptTS_ = std::chrono::system_clock::now() + std::chrono::seconds(retryReriod_);
             break;
+        }
         default:
             break;
     }
@@ -16,6 +16,9 @@
 
 #include "kaa/log/LogCollector.hpp"
 
+#include <algorithm>
+#include <functional>
+
 #include "kaa/gen/EndpointGen.hpp"
 #include "kaa/common/UuidGenerator.hpp"
 #include "kaa/logging/Log.hpp"
@@ -24,19 +27,54 @@
 #include "kaa/log/DefaultLogUploadStrategy.hpp"
 #include "kaa/common/exception/TransportNotFoundException.hpp"
 #include "kaa/log/LogRecord.hpp"
+#include "kaa/metrics/MetricsRegistry.hpp"
 
 namespace kaa {
 
+const std::size_t LogCollector::UPLOAD_CHECK_PERIOD;
+
 LogCollector::LogCollector(IKaaChannelManagerPtr manager)
     : requestId_(0), transport_(nullptr)
+    , recordsAdded_(nullptr), uploadRequests_(nullptr), uploadFailures_(nullptr), uploadTimeouts_(nullptr)
+    , storageRecords_(nullptr), storageVolume_(nullptr)
+    , maxBatchingDelay_(0), work_(io_), uploadCheckTimer_(io_)
 {
     storage_.reset(new MemoryLogStorage());
     uploadStrategy_.reset(new DefaultLogUploadStrategy(manager));
+
+    scheduleUploadCheck();
+    schedulerThread_ = std::thread([this](){ io_.run(); });
+}
+
+LogCollector::~LogCollector()
+{
+    shutdown();
+}
+
+void LogCollector::shutdown()
+{
+    std::call_once(shutdownFlag_, [this] ()
+        {
+            KAA_LOG_DEBUG("Stopping log upload scheduler");
+            io_.stop();
+
+            if (schedulerThread_.get_id() == std::this_thread::get_id()) {
+                schedulerThread_.detach();
+            } else {
+                schedulerThread_.join();
+            }
+        });
 }
 
 void LogCollector::addLogRecord(const KaaUserLogRecord& record)
 {
-    LogRecordPtr serializedRecord(new LogRecord(record));
+    addLogRecord(record, LogPriority::NORMAL);
+}
+
+void LogCollector::addLogRecord(const KaaUserLogRecord& record, LogPriority priority)
+{
+    LogRecordPtr serializedRecord(new LogRecord(record, priority));
+    bool isBatchingStarted = false;
 
     {
         KAA_MUTEX_LOCKING(storageGuard_);
@@ -44,14 +82,40 @@ void LogCollector::addLogRecord(const KaaUserLogRecord& record)
         KAA_MUTEX_LOCKED(storageGuard_);
 
         storage_->addLogRecord(serializedRecord);
+        updateStorageMetrics();
+
+        if (!firstPendingRecordTS_.time_since_epoch().count()) {
+            firstPendingRecordTS_ = clock_t::now();
+            isBatchingStarted = (maxBatchingDelay_ != 0);
+        }
+    }
+
+    /*
+     * Wake the scheduler up in time to force the upload after the max batching delay.
+     */
+    if (isBatchingStarted) {
+        io_.post(std::bind(&LogCollector::scheduleUploadCheck, this));
+    }
+
+    if (recordsAdded_) {
+        recordsAdded_->increment();
     }
 
     if (isDeliveryTimeout()) {
         return;
     }
 
-    processLogUploadDecision(uploadStrategy_->isUploadNeeded(storage_->getStatus()));
+    LogUploadStrategyDecision decision = LogUploadStrategyDecision::NOOP;
+
+    {
+        KAA_MUTEX_LOCKING(storageGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, storageGuard_);
+        KAA_MUTEX_LOCKED(storageGuard_);
+
+        decision = uploadStrategy_->isUploadNeeded(storage_->getStatus());
+    }
 
+    processLogUploadDecision(decision);
 }
 
 void LogCollector::processLogUploadDecision(LogUploadStrategyDecision decision)
@@ -84,6 +148,7 @@ void LogCollector::setStorage(ILogStoragePtr storage)
 
     KAA_LOG_INFO("New log storage was set");
     storage_ = storage;
+    updateStorageMetrics();
 }
 
 void LogCollector::setUploadStrategy(ILogUploadStrategyPtr strategy)
@@ -101,10 +166,120 @@ void LogCollector::setUploadStrategy(ILogUploadStrategyPtr strategy)
     uploadStrategy_ = strategy;
 }
 
+void LogCollector::setMaxBatchingDelay(std::size_t delay)
+{
+    {
+        KAA_MUTEX_LOCKING(storageGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, storageGuard_);
+        KAA_MUTEX_LOCKED(storageGuard_);
+
+        KAA_LOG_INFO(boost::format("Max log batching delay is set to %1% seconds") % delay);
+        maxBatchingDelay_ = delay;
+    }
+
+    io_.post(std::bind(&LogCollector::scheduleUploadCheck, this));
+}
+
+void LogCollector::onConnectivityChanged()
+{
+    KAA_LOG_DEBUG("Connectivity changed. Going to check whether logs should be uploaded");
+    io_.post([this] () { onUploadCheckTimer(boost::system::error_code()); });
+}
+
+void LogCollector::scheduleUploadCheck()
+{
+    const auto& now = clock_t::now();
+    auto nextCheckTS = now + std::chrono::seconds(UPLOAD_CHECK_PERIOD);
+
+    {
+        KAA_MUTEX_LOCKING(timeoutsGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, timeoutsGuard_);
+        KAA_MUTEX_LOCKED(timeoutsGuard_);
+
+        for (const auto& request : timeoutsMap_) {
+            nextCheckTS = std::min(nextCheckTS, request.second);
+        }
+    }
+
+    {
+        KAA_MUTEX_LOCKING(storageGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, storageGuard_);
+        KAA_MUTEX_LOCKED(storageGuard_);
+
+        if (maxBatchingDelay_ && firstPendingRecordTS_.time_since_epoch().count()) {
+            nextCheckTS = std::min(nextCheckTS, firstPendingRecordTS_ + std::chrono::seconds(maxBatchingDelay_));
+        }
+    }
+
+    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(nextCheckTS - now).count();
+
+    uploadCheckTimer_.expires_from_now(boost::posix_time::milliseconds(std::max<std::int64_t>(delay, 0)));
+    uploadCheckTimer_.async_wait(std::bind(&LogCollector::onUploadCheckTimer, this, std::placeholders::_1));
+}
+
+void LogCollector::onUploadCheckTimer(const boost::system::error_code& err)
+{
+    if (err == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    try {
+        checkUpload();
+    } catch (std::exception& e) {
+        KAA_LOG_ERROR(boost::format("Failed to check log upload: %1%") % e.what());
+    }
+
+    scheduleUploadCheck();
+}
+
+void LogCollector::checkUpload()
+{
+    if (isDeliveryTimeout() || !transport_) {
+        return;
+    }
+
+    LogUploadStrategyDecision decision = LogUploadStrategyDecision::NOOP;
+
+    {
+        KAA_MUTEX_LOCKING(storageGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, storageGuard_);
+        KAA_MUTEX_LOCKED(storageGuard_);
+
+        auto& status = storage_->getStatus();
+        if (!status.getRecordsCount()) {
+            firstPendingRecordTS_ = std::chrono::time_point<clock_t>();
+            return;
+        }
+
+        /*
+         * Records may come back to the storage after a failed upload, start their batching delay now.
+         */
+        if (!firstPendingRecordTS_.time_since_epoch().count()) {
+            firstPendingRecordTS_ = clock_t::now();
+        }
+
+        decision = uploadStrategy_->isUploadNeeded(status);
+
+        if (decision == LogUploadStrategyDecision::NOOP && maxBatchingDelay_
+                && clock_t::now() >= firstPendingRecordTS_ + std::chrono::seconds(maxBatchingDelay_))
+        {
+            KAA_LOG_INFO(boost::format("Logs are buffered for more than %1% seconds") % maxBatchingDelay_);
+            /*
+             * Records left after the upload wait for one more delay at most.
+             */
+            firstPendingRecordTS_ = clock_t::now();
+            decision = LogUploadStrategyDecision::UPLOAD;
+        }
+    }
+
+    processLogUploadDecision(decision);
+}
+
 void LogCollector::doSync()
 {
-    if (transport_) {
-        transport_->sync();
+    LoggingTransport* transport = transport_;
+    if (transport) {
+        transport->sync();
     } else {
         KAA_LOG_ERROR("Failed to upload logs: log transport isn't initialized");
         throw TransportNotFoundException("Log transport isn't set");
@@ -115,23 +290,45 @@ bool LogCollector::isDeliveryTimeout()
 {
     bool isTimeout = false;
     const auto& now = clock_t::now();
+    ILogUploadStrategyPtr uploadStrategy;
+
+    {
+        KAA_MUTEX_LOCKING(storageGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(storageLock, storageGuard_);
+        KAA_MUTEX_LOCKED(storageGuard_);
 
-    for (const auto& request : timeoutsMap_) {
-        if (now >= request.second) {
-            isTimeout = true;
-            break;
+        KAA_MUTEX_LOCKING(timeoutsGuard_);
+        KAA_MUTEX_UNIQUE_DECLARE(lock, timeoutsGuard_);
+        KAA_MUTEX_LOCKED(timeoutsGuard_);
+
+        for (const auto& request : timeoutsMap_) {
+            if (now >= request.second) {
+                isTimeout = true;
+                break;
+            }
+        }
+
+        if (isTimeout) {
+            KAA_LOG_INFO("Log delivery timeout detected");
+
+            for (const auto& request : timeoutsMap_) {
+                storage_->notifyUploadFailed(request.first);
+            }
+
+            timeoutsMap_.clear();
+            uploadStrategy = uploadStrategy_;
         }
     }
 
+    /*
+     * The strategy may switch the server, so it's notified without holding the storage lock.
+     */
     if (isTimeout) {
-        KAA_LOG_INFO("Log delivery timeout detected");
-
-        for (const auto& request : timeoutsMap_) {
-            storage_->notifyUploadFailed(request.first);
+        if (uploadTimeouts_) {
+            uploadTimeouts_->increment();
         }
 
-        timeoutsMap_.clear();
-        uploadStrategy_->onTimeout();
+        uploadStrategy->onTimeout();
     }
 
     return isTimeout;
@@ -141,6 +338,7 @@ std::shared_ptr<LogSyncRequest> LogCollector::getLogUploadRequest()
 {
     ILogStorage::RecordPack recordPack;
     std::shared_ptr<LogSyncRequest> request;
+    std::size_t uploadTimeout = 0;
 
     {
         KAA_MUTEX_LOCKING(storageGuard_);
@@ -148,6 +346,11 @@ std::shared_ptr<LogSyncRequest> LogCollector::getLogUploadRequest()
         KAA_MUTEX_LOCKED(storageGuard_);
 
         recordPack = storage_->getRecordBlock(uploadStrategy_->getBatchSize());
+        uploadTimeout = uploadStrategy_->getTimeout();
+
+        if (!storage_->getStatus().getRecordsCount()) {
+            firstPendingRecordTS_ = std::chrono::time_point<clock_t>();
+        }
     }
 
     if (!recordPack.second.empty()) {
@@ -161,8 +364,23 @@ std::shared_ptr<LogSyncRequest> LogCollector::getLogUploadRequest()
         }
 
         request->logEntries.set_array(std::move(logs));
-        timeoutsMap_.insert(std::make_pair(request->requestId,
-                                           clock_t::now() + std::chrono::seconds(uploadStrategy_->getTimeout())));
+        if (uploadRequests_) {
+            uploadRequests_->increment();
+        }
+
+        {
+            KAA_MUTEX_LOCKING(timeoutsGuard_);
+            KAA_MUTEX_UNIQUE_DECLARE(lock, timeoutsGuard_);
+            KAA_MUTEX_LOCKED(timeoutsGuard_);
+
+            timeoutsMap_.insert(std::make_pair(request->requestId,
+                                               clock_t::now() + std::chrono::seconds(uploadTimeout)));
+        }
+
+        /*
+         * Wake the scheduler up in time to detect the delivery timeout.
+         */
+        io_.post(std::bind(&LogCollector::scheduleUploadCheck, this));
     }
 
     return request;
@@ -177,23 +395,35 @@ void LogCollector::onLogUploadResponse(const LogSyncResponse& response)
     if (!response.deliveryStatuses.is_null()) {
         const auto& deliveryStatuses = response.deliveryStatuses.get_array();
         for (const auto& status : deliveryStatuses) {
-            if (!timeoutsMap_.erase(status.requestId)) {
-                continue;
+            {
+                KAA_MUTEX_LOCKING(timeoutsGuard_);
+                KAA_MUTEX_UNIQUE_DECLARE(lock, timeoutsGuard_);
+                KAA_MUTEX_LOCKED(timeoutsGuard_);
+
+                if (!timeoutsMap_.erase(status.requestId)) {
+                    continue;
+                }
             }
 
             if (status.result == SyncResponseResultType::SUCCESS) {
                 KAA_LOG_INFO(boost::format("Logs (requestId %1%) successfully delivered") % status.requestId);
                 storage_->removeRecordBlock(status.requestId);
+                updateStorageMetrics();
             } else {
                 KAA_LOG_WARN(boost::format("Logs (requestId %1%) failed to deliver") % status.requestId);
                 storage_->notifyUploadFailed(status.requestId);
+                if (uploadFailures_) {
+                    uploadFailures_->increment();
+                }
+
+                ILogUploadStrategyPtr uploadStrategy = uploadStrategy_;
 
                 KAA_MUTEX_UNLOCKING(storageGuard_);
                 KAA_UNLOCK(storageLock);
                 KAA_MUTEX_UNLOCKED(storageGuard_);
 
                 if (!status.errorCode.is_null()) {
-                    uploadStrategy_->onFailure(status.errorCode.get_LogDeliveryErrorCode());
+                    uploadStrategy->onFailure(status.errorCode.get_LogDeliveryErrorCode());
                 } else {
                     KAA_LOG_ERROR("Log delivery failed, but no error code received");
                 }
@@ -213,5 +443,30 @@ void LogCollector::setTransport(LoggingTransport* transport)
     transport_ = transport;
 }
 
+void LogCollector::setMetricsRegistry(MetricsRegistry& registry)
+{
+    KAA_MUTEX_LOCKING(storageGuard_);
+    KAA_MUTEX_UNIQUE_DECLARE(lock, storageGuard_);
+    KAA_MUTEX_LOCKED(storageGuard_);
+
+    recordsAdded_ = &registry.getCounter("log.records_added");
+    uploadRequests_ = &registry.getCounter("log.upload_requests");
+    uploadFailures_ = &registry.getCounter("log.upload_failures");
+    uploadTimeouts_ = &registry.getCounter("log.upload_timeouts");
+    storageRecords_ = &registry.getGauge("log.storage_records");
+    storageVolume_ = &registry.getGauge("log.storage_bytes");
+
+    updateStorageMetrics();
+}
+
+void LogCollector::updateStorageMetrics()
+{
+    if (storageRecords_) {
+        auto& status = storage_->getStatus();
+        storageRecords_->setValue(status.getRecordsCount());
+        storageVolume_->setValue(status.getConsumedVolume());
+    }
+}
+
 }  // namespace kaa
 
@@ -21,6 +21,7 @@
 #include "kaa/KaaThread.hpp"
 #include "kaa/logging/Log.hpp"
 #include "kaa/log/LogRecord.hpp"
+#include "kaa/common/LzfCodec.hpp"
 
 namespace kaa {
 
@@ -54,14 +55,90 @@ void MemoryLogStorage::addLogRecord(LogRecordPtr serializedRecord)
         shrinkToSize(shrinkedSize_);
     }
 
-    logs_.push_back(LogRecordWrapper(serializedRecord));
+    auto& queue = queues_[static_cast<std::size_t>(serializedRecord->getPriority())];
+
+    queue.logs_.push_back(LogRecordWrapper(serializedRecord));
     totalOccupiedSize_ += serializedRecord->getSize();
-    occupiedSizeOfUnmarkedRecords_ += serializedRecord->getSize();
-    ++unmarkedRecordCount_;
+    queue.occupiedSizeOfUnmarkedRecords_ += serializedRecord->getSize();
+    ++queue.unmarkedRecordCount_;
+
+    KAA_LOG_TRACE(boost::format("Added log record (%1% bytes, priority %2%). Record count: %3%. Occupied size: %4% bytes")
+                        % serializedRecord->getSize() % static_cast<int>(serializedRecord->getPriority())
+                        % queue.logs_.size() % totalOccupiedSize_);
+
+    queue.uncompressedSize_ += serializedRecord->getSize();
+    if (compressionBlockSize_ && queue.uncompressedSize_ >= compressionBlockSize_) {
+        compressUnmarkedRecords(queue);
+    }
+}
+
+void MemoryLogStorage::setCompressionBlockSize(std::size_t blockSize)
+{
+    KAA_MUTEX_LOCKING(logsGuard_);
+    KAA_MUTEX_UNIQUE_DECLARE(logsLock, logsGuard_);
+    KAA_MUTEX_LOCKED(logsGuard_);
+
+    compressionBlockSize_ = blockSize;
+    KAA_LOG_INFO(boost::format("Log compression block size is set to %1% bytes") % blockSize);
+}
+
+void MemoryLogStorage::compressUnmarkedRecords(RecordQueue& queue)
+{
+    /*
+     * Compressed blocks are uploaded before the rest of the queue, so only records preceding the first one being
+     * uploaded can be packed. Otherwise they would get ahead of it if its upload failed.
+     */
+    std::size_t prefixSize = 0;
+    auto prefixEnd = queue.logs_.begin();
+    for (; prefixEnd != queue.logs_.end() && prefixEnd->blockId_ == NO_OWNER; ++prefixEnd) {
+        prefixSize += prefixEnd->record_->getSize();
+    }
+
+    if (prefixSize < compressionBlockSize_) {
+        return;
+    }
+
+    CompressedBlock compressedBlock;
+    std::vector<std::uint8_t> rawData;
+    rawData.reserve(prefixSize);
+
+    for (auto it = queue.logs_.begin(); it != prefixEnd; ++it) {
+        const auto& data = it->record_->getData();
+        rawData.insert(rawData.end(), data.begin(), data.end());
+        compressedBlock.records_.push_back(CompressedRecordInfo(data.size(), data.size()));
+    }
+
+    queue.logs_.erase(queue.logs_.begin(), prefixEnd);
+    queue.uncompressedSize_ -= prefixSize;
+
+    compressedBlock.rawSize_ = rawData.size();
+    compressedBlock.remainingRecordCount_ = compressedBlock.records_.size();
+
+    LzfCodec::compress(rawData.data(), rawData.size(), compressedBlock.data_);
+    if (compressedBlock.data_.size() < rawData.size()) {
+        compressedBlock.isCompressed_ = true;
 
-    KAA_LOG_TRACE(boost::format("Added log record (%1% bytes). Record count: %2%. Occupied size: %3% bytes")
-                                                % serializedRecord->getSize() % logs_.size() % totalOccupiedSize_);
+        /*
+         * Split the compressed size among records in proportion to their raw sizes,
+         * the last record takes the rounding remainder.
+         */
+        std::size_t distributedSize = 0;
+        for (auto& record : compressedBlock.records_) {
+            record.occupiedSize_ = (compressedBlock.data_.size() * record.size_) / rawData.size();
+            distributedSize += record.occupiedSize_;
+        }
+        compressedBlock.records_.back().occupiedSize_ += compressedBlock.data_.size() - distributedSize;
+    } else {
+        compressedBlock.data_ = std::move(rawData);
+    }
+
+    totalOccupiedSize_ -= compressedBlock.rawSize_ - compressedBlock.data_.size();
+    queue.occupiedSizeOfUnmarkedRecords_ -= compressedBlock.rawSize_ - compressedBlock.data_.size();
 
+    KAA_LOG_TRACE(boost::format("Packed %1% log records (%2% bytes) into %3% bytes")
+            % compressedBlock.records_.size() % compressedBlock.rawSize_ % compressedBlock.data_.size());
+
+    queue.compressedBlocks_.push_back(std::move(compressedBlock));
 }
 
 ILogStorage::RecordPack MemoryLogStorage::getRecordBlock(std::size_t blockSize)
@@ -74,15 +151,71 @@ ILogStorage::RecordPack MemoryLogStorage::getRecordBlock(std::size_t blockSize)
 
     RecordBlockId recordBlockId = recordBlockId_++;
 
-    for (auto& log : logs_) {
-        if (log.blockId_ == NO_OWNER) {
-            if (log.record_->getSize() > blockSize) {
-                if (block.empty()) {
-                    KAA_LOG_ERROR(boost::format("Failed to get logs: block size (%1%B) is less than the size of "
-                                        "the serialized log record (%2%B)") % blockSize % log.record_->getSize());
-                    throw KaaException("Block size is less than the size of the serialized log record");
+    for (auto queue = queues_.rbegin(); queue != queues_.rend(); ++queue) {
+        if (!fillRecordBlock(*queue, recordBlockId, block, blockSize)) {
+            break;
+        }
+    }
+
+    return ILogStorage::RecordPack((block.empty() ? -1 : recordBlockId), std::move(block));
+}
+
+bool MemoryLogStorage::fillRecordBlock(RecordQueue& queue, RecordBlockId recordBlockId,
+                                       RecordBlock& block, std::size_t& blockSize)
+{
+    auto isFitting = [&] (std::size_t recordSize) -> bool
+                        {
+                            if (recordSize > blockSize) {
+                                if (block.empty()) {
+                                    KAA_LOG_ERROR(boost::format("Failed to get logs: block size (%1%B) is less than "
+                                            "the size of the serialized log record (%2%B)") % blockSize % recordSize);
+                                    throw KaaException("Block size is less than the size of the serialized log record");
+                                }
+                                return false;
+                            }
+                            return true;
+                        };
+
+    const auto priority = static_cast<LogPriority>(&queue - queues_.data());
+
+    for (auto& compressedBlock : queue.compressedBlocks_) {
+        std::vector<std::uint8_t> rawData;
+        std::size_t offset = 0;
+
+        for (auto& record : compressedBlock.records_) {
+            if (!record.isRemoved_ && record.blockId_ == NO_OWNER) {
+                if (!isFitting(record.size_)) {
+                    return false;
+                }
+
+                /*
+                 * The block is decompressed only when one of its records is really going to be uploaded.
+                 */
+                if (compressedBlock.isCompressed_ && rawData.empty()) {
+                    rawData = LzfCodec::decompress(compressedBlock.data_.data(), compressedBlock.data_.size(),
+                                                   compressedBlock.rawSize_);
                 }
-                break;
+
+                const auto& source = (compressedBlock.isCompressed_ ? rawData : compressedBlock.data_);
+                block.push_back(std::make_shared<LogRecord>(
+                        std::vector<std::uint8_t>(source.begin() + offset, source.begin() + offset + record.size_),
+                        priority));
+                blockSize -= record.size_;
+
+                record.blockId_ = recordBlockId;
+
+                --queue.unmarkedRecordCount_;
+                queue.occupiedSizeOfUnmarkedRecords_ -= record.occupiedSize_;
+            }
+
+            offset += record.size_;
+        }
+    }
+
+    for (auto& log : queue.logs_) {
+        if (log.blockId_ == NO_OWNER) {
+            if (!isFitting(log.record_->getSize())) {
+                return false;
             }
 
             block.push_back(log.record_);
@@ -90,12 +223,13 @@ ILogStorage::RecordPack MemoryLogStorage::getRecordBlock(std::size_t blockSize)
 
             log.blockId_ = recordBlockId;
 
-            --unmarkedRecordCount_;
-            occupiedSizeOfUnmarkedRecords_ -= log.record_->getSize();
+            --queue.unmarkedRecordCount_;
+            queue.occupiedSizeOfUnmarkedRecords_ -= log.record_->getSize();
+            queue.uncompressedSize_ -= log.record_->getSize();
         }
     }
 
-    return ILogStorage::RecordPack((block.empty() ? -1 : recordBlockId), std::move(block));
+    return true;
 }
 
 void MemoryLogStorage::removeRecordBlock(RecordBlockId blockId)
@@ -106,15 +240,34 @@ void MemoryLogStorage::removeRecordBlock(RecordBlockId blockId)
 
     std::uint32_t removedRecordCount = 0;
 
-    logs_.remove_if([&] (const LogRecordWrapper& wrapper)
-                        {
-                             if (wrapper.blockId_ == blockId) {
-                                 totalOccupiedSize_ -= wrapper.record_->getSize();
-                                 ++removedRecordCount;
-                                 return true;
-                             }
-                             return false;
-                        });
+    for (auto& queue : queues_) {
+        for (auto it = queue.compressedBlocks_.begin(); it != queue.compressedBlocks_.end();) {
+            for (auto& record : it->records_) {
+                if (!record.isRemoved_ && record.blockId_ == blockId) {
+                    record.isRemoved_ = true;
+                    --it->remainingRecordCount_;
+                    ++removedRecordCount;
+                }
+            }
+
+            if (!it->remainingRecordCount_) {
+                totalOccupiedSize_ -= it->data_.size();
+                it = queue.compressedBlocks_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        queue.logs_.remove_if([&] (const LogRecordWrapper& wrapper)
+                                {
+                                     if (wrapper.blockId_ == blockId) {
+                                         totalOccupiedSize_ -= wrapper.record_->getSize();
+                                         ++removedRecordCount;
+                                         return true;
+                                     }
+                                     return false;
+                                });
+    }
 
     KAA_LOG_DEBUG(boost::format("Log block %1% removed (%2% records)") % blockId % removedRecordCount);
 }
@@ -127,15 +280,28 @@ void MemoryLogStorage::notifyUploadFailed(RecordBlockId blockId)
 
     std::uint32_t recordCount = 0;
 
-    std::for_each(logs_.begin(), logs_.end(), [&] (LogRecordWrapper& wrapper)
-                                                  {
-                                                      if (wrapper.blockId_ == blockId) {
-                                                          occupiedSizeOfUnmarkedRecords_ += wrapper.record_->getSize();
-                                                          ++recordCount;
-                                                          ++unmarkedRecordCount_;
-                                                          wrapper.blockId_ = NO_OWNER;
-                                                      }
-                                                  });
+    for (auto& queue : queues_) {
+        for (auto& compressedBlock : queue.compressedBlocks_) {
+            for (auto& record : compressedBlock.records_) {
+                if (!record.isRemoved_ && record.blockId_ == blockId) {
+                    queue.occupiedSizeOfUnmarkedRecords_ += record.occupiedSize_;
+                    ++recordCount;
+                    ++queue.unmarkedRecordCount_;
+                    record.blockId_ = NO_OWNER;
+                }
+            }
+        }
+
+        for (auto& wrapper : queue.logs_) {
+            if (wrapper.blockId_ == blockId) {
+                queue.occupiedSizeOfUnmarkedRecords_ += wrapper.record_->getSize();
+                queue.uncompressedSize_ += wrapper.record_->getSize();
+                ++recordCount;
+                ++queue.unmarkedRecordCount_;
+                wrapper.blockId_ = NO_OWNER;
+            }
+        }
+    }
 
     KAA_LOG_DEBUG(boost::format("Failed to upload %1% log block (%2% records unmarked)") % blockId % recordCount);
 }
@@ -143,27 +309,55 @@ void MemoryLogStorage::notifyUploadFailed(RecordBlockId blockId)
 void MemoryLogStorage::shrinkToSize(std::size_t newSize)
 {
     if (!newSize) {
-        logs_.clear();
-        unmarkedRecordCount_ = 0;
-        totalOccupiedSize_ = occupiedSizeOfUnmarkedRecords_ = 0;
+        for (auto& queue : queues_) {
+            queue = RecordQueue();
+        }
+        totalOccupiedSize_ = 0;
         KAA_LOG_INFO("All log were forcibly deleted");
         return;
     }
 
     size_t recordCount = 0;
-    while (totalOccupiedSize_ > newSize) {
-        const auto& wrapper = logs_.front();
+    for (auto& queue : queues_) {
+        if (totalOccupiedSize_ <= newSize) {
+            break;
+        }
+        shrinkQueue(queue, newSize, recordCount);
+    }
+
+    KAA_LOG_INFO(boost::format("%1% log records were forcibly deleted") % recordCount);
+}
+
+void MemoryLogStorage::shrinkQueue(RecordQueue& queue, std::size_t newSize, std::size_t& removedRecordCount)
+{
+    while (totalOccupiedSize_ > newSize && !queue.compressedBlocks_.empty()) {
+        const auto& compressedBlock = queue.compressedBlocks_.front();
+        for (const auto& record : compressedBlock.records_) {
+            if (!record.isRemoved_) {
+                if (record.blockId_ == NO_OWNER) {
+                    --queue.unmarkedRecordCount_;
+                    queue.occupiedSizeOfUnmarkedRecords_ -= record.occupiedSize_;
+                }
+                ++removedRecordCount;
+            }
+        }
+
+        totalOccupiedSize_ -= compressedBlock.data_.size();
+        queue.compressedBlocks_.pop_front();
+    }
+
+    while (totalOccupiedSize_ > newSize && !queue.logs_.empty()) {
+        const auto& wrapper = queue.logs_.front();
         if (wrapper.blockId_ == NO_OWNER) {
-            --unmarkedRecordCount_;
-            occupiedSizeOfUnmarkedRecords_ -= wrapper.record_->getSize();
+            --queue.unmarkedRecordCount_;
+            queue.occupiedSizeOfUnmarkedRecords_ -= wrapper.record_->getSize();
+            queue.uncompressedSize_ -= wrapper.record_->getSize();
         }
 
         totalOccupiedSize_ -= wrapper.record_->getSize();
-        logs_.pop_front();
-        ++recordCount;
+        queue.logs_.pop_front();
+        ++removedRecordCount;
     }
-
-    KAA_LOG_INFO(boost::format("%1% log records were forcibly deleted") % recordCount);
 }
 
 std::size_t MemoryLogStorage::getConsumedVolume()
@@ -171,7 +365,12 @@ std::size_t MemoryLogStorage::getConsumedVolume()
     KAA_MUTEX_LOCKING(logsGuard_);
     KAA_MUTEX_UNIQUE_DECLARE(logsLock, logsGuard_);
     KAA_MUTEX_LOCKED(logsGuard_);
-    return occupiedSizeOfUnmarkedRecords_;
+
+    std::size_t volume = 0;
+    for (const auto& queue : queues_) {
+        volume += queue.occupiedSizeOfUnmarkedRecords_;
+    }
+    return volume;
 }
 
 std::size_t MemoryLogStorage::getRecordsCount()
@@ -179,7 +378,28 @@ std::size_t MemoryLogStorage::getRecordsCount()
     KAA_MUTEX_LOCKING(logsGuard_);
     KAA_MUTEX_UNIQUE_DECLARE(logsLock, logsGuard_);
     KAA_MUTEX_LOCKED(logsGuard_);
-    return unmarkedRecordCount_;
+
+    std::size_t count = 0;
+    for (const auto& queue : queues_) {
+        count += queue.unmarkedRecordCount_;
+    }
+    return count;
+}
+
+std::size_t MemoryLogStorage::getConsumedVolume(LogPriority priority)
+{
+    KAA_MUTEX_LOCKING(logsGuard_);
+    KAA_MUTEX_UNIQUE_DECLARE(logsLock, logsGuard_);
+    KAA_MUTEX_LOCKED(logsGuard_);
+    return queues_[static_cast<std::size_t>(priority)].occupiedSizeOfUnmarkedRecords_;
+}
+
+std::size_t MemoryLogStorage::getRecordsCount(LogPriority priority)
+{
+    KAA_MUTEX_LOCKING(logsGuard_);
+    KAA_MUTEX_UNIQUE_DECLARE(logsLock, logsGuard_);
+    KAA_MUTEX_LOCKED(logsGuard_);
+    return queues_[static_cast<std::size_t>(priority)].unmarkedRecordCount_;
 }
 
 }  // namespace kaa
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "kaa/logging/AsyncLogger.hpp"
+
+#if KAA_LOG_LEVEL > KAA_LOG_LEVEL_NONE && defined(KAA_THREADSAFE)
+
+#include <cstring>
+#include <string>
+
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+constexpr char AsyncLogger::TRUNCATION_MARKER[];
+
+AsyncLogger::AsyncLogger(LoggerPtr target, std::size_t capacity)
+    : target_(target), entries_(capacity), head_(0), size_(0)
+    , droppedCount_(0), reportedDropCount_(0), stopped_(false)
+{
+    if (!target_) {
+        throw KaaException("Target logger is null");
+    }
+    if (!capacity) {
+        throw KaaException("Async logger queue capacity must be positive");
+    }
+
+    worker_ = std::thread([this] () { processQueue(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        KAA_MUTEX_UNIQUE_DECLARE(lock, queueGuard_);
+        stopped_ = true;
+    }
+    KAA_CONDITION_NOTIFY_ALL(queueCondition_);
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void AsyncLogger::log(LogLevel level, const char *message) const
+{
+    std::size_t length = std::strlen(message);
+    bool isTruncated = (length >= MAX_MESSAGE_LENGTH);
+    if (isTruncated) {
+        length = MAX_MESSAGE_LENGTH - sizeof(TRUNCATION_MARKER);
+    }
+
+    {
+        KAA_MUTEX_UNIQUE_DECLARE(lock, queueGuard_);
+        if (size_ == entries_.size()) {
+            ++droppedCount_;
+            return;
+        }
+
+        LogEntry& entry = entries_[(head_ + size_) % entries_.size()];
+        entry.level = level;
+        std::memcpy(entry.message, message, length);
+        if (isTruncated) {
+            std::memcpy(entry.message + length, TRUNCATION_MARKER, sizeof(TRUNCATION_MARKER));
+        } else {
+            entry.message[length] = '\0';
+        }
+        ++size_;
+    }
+
+    KAA_CONDITION_NOTIFY(queueCondition_);
+}
+
+void AsyncLogger::flush() const
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, queueGuard_);
+    KAA_CONDITION_WAIT_PRED(flushCondition_, lock, [this] () { return size_ == 0; });
+}
+
+void AsyncLogger::processQueue()
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, queueGuard_);
+
+    while (true) {
+        KAA_CONDITION_WAIT_PRED(queueCondition_, lock, [this] () { return stopped_ || size_ > 0; });
+        if (!size_) {
+            break;
+        }
+
+        /*
+         * The head entry isn't reused by producers until it's released below,
+         * so it may be written without holding the lock.
+         */
+        const LogEntry& entry = entries_[head_];
+        KAA_UNLOCK(lock);
+
+        std::uint64_t droppedCount = droppedCount_;
+        if (droppedCount != reportedDropCount_) {
+            const std::string& warning = std::to_string(droppedCount - reportedDropCount_) +
+                                            " log message(s) were dropped: the async logger queue is full";
+            target_->log(LogLevel::WARNING, warning.c_str());
+            reportedDropCount_ = droppedCount;
+        }
+
+        target_->log(entry.level, entry.message);
+
+        KAA_LOCK(lock);
+        head_ = (head_ + 1) % entries_.size();
+        if (--size_ == 0) {
+            KAA_CONDITION_NOTIFY_ALL(flushCondition_);
+        }
+    }
+}
+
+}  // namespace kaa
+
+#endif
@@ -18,16 +18,20 @@
 
 #if KAA_LOG_LEVEL > KAA_LOG_LEVEL_NONE
 
+#include <string>
+#include <cstring>
+
 #include <boost/format.hpp>
 
 namespace kaa {
 
-static const char * const KAA_LOG_FMT = "[%1%:%2%]:\t%3%";
-
 void kaa_log(const ILogger & logger, LogLevel level, const char *message, const char *file, size_t lineno)
 {
-    boost::format logline = boost::format(KAA_LOG_FMT) % file % lineno % message;
-    logger.log(level, logline.str().c_str());
+    // Builds "[file:line]:\tmessage" without the boost::format overhead.
+    std::string logline;
+    logline.reserve(std::strlen(file) + std::strlen(message) + 16);
+    logline.append("[").append(file).append(":").append(std::to_string(lineno)).append("]:\t").append(message);
+    logger.log(level, logline.c_str());
 }
 
 void kaa_log(const ILogger & logger, LogLevel level, const std::string &message, const char *file, size_t lineno)
@@ -23,11 +23,16 @@
 #include <sstream>
 
 #include "kaa/logging/DefaultLogger.hpp"
+#include "kaa/logging/AsyncLogger.hpp"
 
 namespace kaa {
 
 static LoggerPtr getDefaultLogger() {
+#if defined(KAA_ASYNC_LOGGER) && defined(KAA_THREADSAFE)
+    return LoggerPtr(new AsyncLogger(LoggerPtr(new DefaultLogger())));
+#else
     return LoggerPtr(new DefaultLogger());
+#endif
 }
 
 LoggerPtr LoggerFactory::logger_ = getDefaultLogger();
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "kaa/metrics/MetricsRegistry.hpp"
+
+#include <sstream>
+#include <algorithm>
+
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+const std::vector<std::uint64_t> Histogram::DEFAULT_LATENCY_BOUNDS =
+        { 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000 };
+
+Histogram::Histogram(const std::vector<std::uint64_t>& bounds)
+    : bounds_(bounds), count_(0), sum_(0)
+{
+    if (bounds_.empty() || !std::is_sorted(bounds_.begin(), bounds_.end())) {
+        throw KaaException("Histogram bounds must be non-empty and sorted");
+    }
+
+    buckets_.reset(new std::atomic<std::uint64_t>[bounds_.size() + 1]);
+    for (std::size_t i = 0; i <= bounds_.size(); ++i) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::record(std::uint64_t value)
+{
+    std::size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+HistogramSnapshot Histogram::getSnapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.bounds = bounds_;
+    snapshot.buckets.reserve(bounds_.size() + 1);
+    for (std::size_t i = 0; i <= bounds_.size(); ++i) {
+        snapshot.buckets.push_back(buckets_[i].load(std::memory_order_relaxed));
+    }
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+std::string MetricsSnapshot::toString() const
+{
+    std::ostringstream ss;
+    for (const auto& counter : counters) {
+        ss << counter.first << " " << counter.second << std::endl;
+    }
+    for (const auto& gauge : gauges) {
+        ss << gauge.first << " " << gauge.second << std::endl;
+    }
+    for (const auto& histogram : histograms) {
+        const auto& value = histogram.second;
+        ss << histogram.first << " count=" << value.count << " sum=" << value.sum << " buckets={";
+        for (std::size_t i = 0; i < value.buckets.size(); ++i) {
+            if (i) {
+                ss << ", ";
+            }
+            if (i < value.bounds.size()) {
+                ss << "<=" << value.bounds[i];
+            } else {
+                ss << ">" << value.bounds.back();
+            }
+            ss << ": " << value.buckets[i];
+        }
+        ss << "}" << std::endl;
+    }
+    return ss.str();
+}
+
+Counter& MetricsRegistry::getCounter(const std::string& name)
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, registryGuard_);
+    auto& counter = counters_[name];
+    if (!counter) {
+        counter.reset(new Counter);
+    }
+    return *counter;
+}
+
+Gauge& MetricsRegistry::getGauge(const std::string& name)
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, registryGuard_);
+    auto& gauge = gauges_[name];
+    if (!gauge) {
+        gauge.reset(new Gauge);
+    }
+    return *gauge;
+}
+
+Histogram& MetricsRegistry::getHistogram(const std::string& name, const std::vector<std::uint64_t>& bounds)
+{
+    KAA_MUTEX_UNIQUE_DECLARE(lock, registryGuard_);
+    auto it = histograms_.find(name);
+    if (it == histograms_.end()) {
+        std::unique_ptr<Histogram> histogram(new Histogram(bounds));
+        it = histograms_.insert(std::make_pair(name, std::move(histogram))).first;
+    }
+    return *it->second;
+}
+
+MetricsSnapshot MetricsRegistry::getSnapshot() const
+{
+    MetricsSnapshot snapshot;
+
+    KAA_MUTEX_UNIQUE_DECLARE(lock, registryGuard_);
+    for (const auto& counter : counters_) {
+        snapshot.counters.insert(std::make_pair(counter.first, counter.second->getValue()));
+    }
+    for (const auto& gauge : gauges_) {
+        snapshot.gauges.insert(std::make_pair(gauge.first, gauge.second->getValue()));
+    }
+    for (const auto& histogram : histograms_) {
+        snapshot.histograms.insert(std::make_pair(histogram.first, histogram.second->getSnapshot()));
+    }
+
+    return snapshot;
+}
+
+}  // namespace kaa
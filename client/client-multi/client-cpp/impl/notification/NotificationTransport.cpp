@@ -28,14 +28,72 @@
 
 namespace kaa {
 
+NotificationTransport::NotificationTransport(IKaaClientStateStoragePtr status, IKaaChannelManager& manager,
+                                             std::size_t acceptedUnicastIdsCapacity)
+    : AbstractKaaTransport(manager), notificationProcessor_(nullptr)
+    , acceptedUnicastNotificationIds_(acceptedUnicastIdsCapacity)
+{
+    setClientState(status);
+
+    if (clientStatus_) {
+        for (const auto& uid : clientStatus_->getAcceptedUnicastNotificationIds()) {
+            acceptedUnicastNotificationIds_.insert(uid);
+        }
+    }
+}
+
+void NotificationTransport::saveAcceptedUnicastNotificationIds()
+{
+    clientStatus_->setAcceptedUnicastNotificationIds(AcceptedUnicastNotificationIds(
+            acceptedUnicastNotificationIds_.begin(), acceptedUnicastNotificationIds_.end()));
+}
+
+HashDigest NotificationTransport::calculateTopicListHash(std::vector<Topic> topics)
+{
+    std::sort(topics.begin(), topics.end(), [] (const Topic& left, const Topic& right) { return left.id < right.id; });
+
+    std::string serializedTopics;
+    for (const auto& topic : topics) {
+        serializedTopics.append(topic.id).push_back('\0');
+        serializedTopics.append(topic.name).push_back('\0');
+        serializedTopics.push_back(static_cast<char>(topic.subscriptionType));
+    }
+
+    return EndpointObjectHash(serializedTopics).getHashDigest();
+}
+
+void NotificationTransport::setTopicListHash(NotificationSyncRequest& request)
+{
+    if (topicListHash_.empty()) {
+        const DetailedTopicStates& detailedStatesContainer = clientStatus_->getTopicStates();
+        if (!detailedStatesContainer.empty()) {
+            std::vector<Topic> topics;
+            topics.reserve(detailedStatesContainer.size());
+            for (const auto& state : detailedStatesContainer) {
+                Topic topic;
+                topic.id = state.second.topicId;
+                topic.name = state.second.topicName;
+                topic.subscriptionType = state.second.subscriptionType;
+                topics.push_back(topic);
+            }
+            topicListHash_ = calculateTopicListHash(std::move(topics));
+        }
+    }
+
+    if (!topicListHash_.empty()) {
+        request.topicListHash.set_bytes(topicListHash_);
+    } else {
+        request.topicListHash.set_null();
+    }
+}
+
 NotificationSyncRequestPtr NotificationTransport::createEmptyNotificationRequest()
 {
     NotificationSyncRequestPtr request(new NotificationSyncRequest);
 
     request->appStateSeqNumber = clientStatus_->getNotificationSequenceNumber();
 
-    /*TODO: topic list hash is a future feature */
-    request->topicListHash.set_null();
+    setTopicListHash(*request);
 
     const DetailedTopicStates& detailedStatesContainer = clientStatus_->getTopicStates();
     if (!detailedStatesContainer.empty()) {
@@ -65,8 +123,7 @@ NotificationSyncRequestPtr NotificationTransport::createNotificationRequest()
 
     request->appStateSeqNumber = clientStatus_->getNotificationSequenceNumber();
 
-    /*TODO: topic list hash is a future feature */
-    request->topicListHash.set_null();
+    setTopicListHash(*request);
 
     if (!acceptedUnicastNotificationIds_.empty()) {
         request->acceptedUnicastNotifications.set_array(std::vector<std::string>(
@@ -104,8 +161,9 @@ NotificationSyncRequestPtr NotificationTransport::createNotificationRequest()
 void NotificationTransport::onNotificationResponse(const NotificationSyncResponse& response)
 {
     subscriptions_.clear();
-    if (response.responseStatus == SyncResponseStatus::NO_DELTA) {
+    if (response.responseStatus == SyncResponseStatus::NO_DELTA && !acceptedUnicastNotificationIds_.empty()) {
         acceptedUnicastNotificationIds_.clear();
+        saveAcceptedUnicastNotificationIds();
     }
     clientStatus_->setNotificationSequenceNumber(response.appStateSeqNumber);
 
@@ -113,36 +171,44 @@ void NotificationTransport::onNotificationResponse(const NotificationSyncRespons
 
     if (!response.availableTopics.is_null()) {
         const auto& topics = response.availableTopics.get_array();
+        HashDigest receivedTopicListHash = calculateTopicListHash(topics);
 
-        detailedStatesContainer.clear();
+        if (receivedTopicListHash == topicListHash_) {
+            KAA_LOG_DEBUG("Topic list is unchanged");
+        } else {
+            topicListHash_ = receivedTopicListHash;
 
-        for (const auto& topic : topics) {
-            DetailedTopicState dts;
+            detailedStatesContainer.clear();
 
-            dts.topicId = topic.id;
-            dts.topicName = topic.name;
-            dts.subscriptionType = topic.subscriptionType;
-            dts.sequenceNumber = 0;
+            for (const auto& topic : topics) {
+                DetailedTopicState dts;
 
-            auto insertResult = notificationSubscriptions_.insert(std::make_pair(topic.id, 0));
-            if (!insertResult.second) {
-                dts.sequenceNumber = notificationSubscriptions_[topic.id];
-            }
+                dts.topicId = topic.id;
+                dts.topicName = topic.name;
+                dts.subscriptionType = topic.subscriptionType;
+                dts.sequenceNumber = 0;
 
-            detailedStatesContainer[topic.id] = dts;
-        }
+                auto insertResult = notificationSubscriptions_.insert(std::make_pair(topic.id, 0));
+                if (!insertResult.second) {
+                    dts.sequenceNumber = notificationSubscriptions_[topic.id];
+                }
 
-        if (notificationProcessor_ != nullptr) {
-            notificationProcessor_->topicsListUpdated(topics);
+                detailedStatesContainer[topic.id] = dts;
+            }
+
+            if (notificationProcessor_ != nullptr) {
+                notificationProcessor_->topicsListUpdated(topics);
+            }
         }
     }
 
     if (!response.notifications.is_null()) {
 
-        KAA_LOG_INFO(boost::format("Received notifications array: %1%") % LoggingUtils::NotificationToString(response.notifications));
-
         const auto& notifications = response.notifications.get_array();
 
+        KAA_LOG_INFO(boost::format("Received %1% notifications") % notifications.size());
+        KAA_LOG_TRACE(boost::format("Received notifications array: %1%") % LoggingUtils::NotificationToString(response.notifications));
+
         Notifications unicast = getUnicastNotifications(notifications);
         Notifications multicast = getMulticastNotifications(notifications);
 
@@ -151,16 +217,19 @@ void NotificationTransport::onNotificationResponse(const NotificationSyncRespons
         for (const auto& n : unicast) {
             const std::string& uid = n.uid.get_string();
             KAA_LOG_INFO(boost::format("Adding '%1%' to unicast accepted notifications") % uid);
-            auto addResultPair = acceptedUnicastNotificationIds_.insert(uid);
-            if (addResultPair.second) {
+            if (acceptedUnicastNotificationIds_.insert(uid)) {
                 newNotifications.push_back(n);
             } else {
                 KAA_LOG_INFO(boost::format("Notification with uid [%1%] was already received") % uid);
             }
         }
 
+        if (!unicast.empty()) {
+            saveAcceptedUnicastNotificationIds();
+        }
+
         for (const auto& n : multicast) {
-            KAA_LOG_DEBUG(boost::format("Notification: %1%, Stored sequence number: %2%")
+            KAA_LOG_TRACE(boost::format("Notification: %1%, Stored sequence number: %2%")
                     % LoggingUtils::SingleNotificationToString(n)
                     % notificationSubscriptions_[n.topicId]);
             auto& sequenceNumber = notificationSubscriptions_[n.topicId];
@@ -174,7 +243,7 @@ void NotificationTransport::onNotificationResponse(const NotificationSyncRespons
 
         if (notificationProcessor_ != nullptr) {
             for (const auto &n : newNotifications) {
-                KAA_LOG_DEBUG(boost::format("Passing notification %1%") % LoggingUtils::SingleNotificationToString(n));
+                KAA_LOG_TRACE(boost::format("Passing notification %1%") % LoggingUtils::SingleNotificationToString(n));
             }
             notificationProcessor_->notificationReceived(newNotifications);
         }
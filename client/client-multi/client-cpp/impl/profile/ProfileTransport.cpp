@@ -25,7 +25,7 @@ namespace kaa {
 ProfileTransport::ProfileTransport(IKaaChannelManager& channelManager
         , const PublicKey& publicKey)
     : AbstractKaaTransport(channelManager), profileManager_(nullptr),
-      publicKey_(publicKey.begin(), publicKey.end()) {}
+      publicKey_(publicKey.begin(), publicKey.end()), lastProfileRevision_(IProfileContainer::UNKNOWN_REVISION) {}
 
 bool ProfileTransport::isProfileOutDated(const HashDigest& profileHash)
 {
@@ -38,8 +38,17 @@ ProfileSyncRequestPtr ProfileTransport::createProfileRequest()
     ProfileSyncRequestPtr request;
 
     if (clientStatus_ && profileManager_) {
-        auto encodedProfile = profileManager_->getSerializedProfileContainer()->getSerializedProfile();
+        auto serializedContainer = profileManager_->getSerializedProfileContainer();
+        std::uint64_t revision = serializedContainer->getProfileRevision();
+        if (clientStatus_->isRegistered() && revision != IProfileContainer::UNKNOWN_REVISION
+                && revision == lastProfileRevision_) {
+            KAA_LOG_INFO("Profile is up to date");
+            return request;
+        }
+
+        auto encodedProfile = serializedContainer->getSerializedProfile();
         HashDigest newHash = EndpointObjectHash(encodedProfile).getHashDigest();
+        lastProfileRevision_ = revision;
         if (isProfileOutDated(newHash) || !clientStatus_->isRegistered()) {
             clientStatus_->setProfileHash(newHash);
             request.reset(new ProfileSyncRequest());
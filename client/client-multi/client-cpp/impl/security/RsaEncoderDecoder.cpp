@@ -22,14 +22,20 @@
 
 #include "kaa/logging/Log.hpp"
 #include "kaa/logging/LoggingUtils.hpp"
+#include "kaa/metrics/MetricsRegistry.hpp"
 
 namespace kaa {
 
 RsaEncoderDecoder::RsaEncoderDecoder(
         const PublicKey& pubKey,
         const PrivateKey& privKey,
-        const PublicKey& remoteKey)
+        const PublicKey& remoteKey,
+        MetricsRegistry *metrics)
     : pubKey_(nullptr), privKey_(nullptr), remoteKey_(nullptr), sessionKey_(KeyUtils().generateSessionKey(16))
+    , encodeLatency_(metrics ? &metrics->getHistogram("security.encode_us") : nullptr)
+    , decodeLatency_(metrics ? &metrics->getHistogram("security.decode_us") : nullptr)
+    , signLatency_(metrics ? &metrics->getHistogram("security.sign_us") : nullptr)
+    , verifyLatency_(metrics ? &metrics->getHistogram("security.verify_us") : nullptr)
 {
     KAA_LOG_TRACE("Creating MessageEncoderDecoder with following parameters: ");
 
@@ -72,22 +78,26 @@ std::string RsaEncoderDecoder::cipherPipe(const std::uint8_t *data, std::size_t
 
 std::string RsaEncoderDecoder::encodeData(const std::uint8_t *data, std::size_t size)
 {
+    ScopedLatency latency(encodeLatency_);
     return cipherPipe(data, size, Botan::ENCRYPTION);
 }
 
 std::string RsaEncoderDecoder::decodeData(const std::uint8_t *data, std::size_t size)
 {
+    ScopedLatency latency(decodeLatency_);
     return cipherPipe(data, size, Botan::DECRYPTION);
 }
 
 Botan::SecureVector<std::uint8_t> RsaEncoderDecoder::signData(const std::uint8_t *data, std::size_t size)
 {
+    ScopedLatency latency(signLatency_);
     Botan::PK_Signer signer(*privKey_, "EMSA3(SHA-1)");
     return signer.sign_message(data, size, rng_);
 }
 
 bool RsaEncoderDecoder::verifySignature(const std::uint8_t *data, std::size_t len, const std::uint8_t *sig, std::size_t sigLen)
 {
+    ScopedLatency latency(verifyLatency_);
     Botan::PK_Verifier verifier(*remoteKey_, "EMSA3(SHA-1)");
     return verifier.verify_message(data, len, sig, sigLen);
 }
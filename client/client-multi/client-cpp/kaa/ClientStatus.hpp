@@ -69,6 +69,9 @@ public:
     AttachedEndpoints getAttachedEndpoints() const;
     void setAttachedEndpoints(const AttachedEndpoints& endpoints);
 
+    AcceptedUnicastNotificationIds getAcceptedUnicastNotificationIds() const;
+    void setAcceptedUnicastNotificationIds(const AcceptedUnicastNotificationIds& ids);
+
     std::string getEndpointAccessToken();
     void setEndpointAccessToken(const std::string& token);
     std::string refreshEndpointAccessToken();
@@ -102,6 +105,7 @@ private:
     static const HashDigest                 endpointHashDefault_;
     static const DetailedTopicStates        topicStatesDefault_;
     static const AttachedEndpoints          attachedEndpoints_;
+    static const AcceptedUnicastNotificationIds acceptedUnicastNotificationIdsDefault_;
     static const bool                       endpointDefaultAttachStatus_;
     static const std::string                endpointKeyHashDefault_;
 };
@@ -27,6 +27,7 @@
 #include "kaa/event/registration/IDetachEndpointCallback.hpp"
 #include "kaa/event/registration/IUserAttachCallback.hpp"
 #include "kaa/event/registration/IAttachStatusListener.hpp"
+#include "kaa/event/IEventQueueListener.hpp"
 #include "kaa/log/ILogCollector.hpp"
 
 
@@ -40,6 +41,7 @@ class IKaaDataDemultiplexer;
 class IFetchEventListeners;
 class IConfigurationReceiver;
 class KeyPair;
+class MetricsRegistry;
 
 /**
  * Interface for the Kaa client.
@@ -334,9 +336,30 @@ public:
      * @return Request ID of submitted request
      */
     virtual std::int32_t findEventListeners(const std::list<std::string>& eventFQNs, IFetchEventListeners* listener) = 0;
+
+    /**
+     * Limits the queue of produced events waiting for delivery to the server.
+     *
+     * @param maxCount  Maximum number of pending events.
+     * @param maxSize   Maximum size (in bytes) of pending events.
+     * @param policy    What to do with a produced event which doesn't fit into the limits.
+     *
+     * @throw KaaException when any of the limits is zero
+     */
+    virtual void setPendingEventsLimits(std::size_t maxCount, std::size_t maxSize, EventQueueOverflowPolicy policy) = 0;
+
+    /**
+     * Sets listener to notify when produced events are discarded because the pending events queue is full
+     * and when the queue becomes available again.
+     *
+     * @param listener  Listener {@link IEventQueueListener}, may be null.
+     */
+    virtual void setEventQueueListener(IEventQueueListener* listener) = 0;
     virtual void addLogRecord(const KaaUserLogRecord& record) = 0;
+    virtual void addLogRecord(const KaaUserLogRecord& record, LogPriority priority) = 0;
     virtual void setLogStorage(ILogStoragePtr storage) = 0;
     virtual void setLogUploadStrategy(ILogUploadStrategyPtr strategy) = 0;
+    virtual void setMaxLogBatchingDelay(std::size_t delay) = 0;
 
     /**
      * Retrieves the Channel Manager
@@ -383,6 +406,14 @@ public:
      */
     virtual IKaaDataDemultiplexer&            getBootstrapDemultiplexer() = 0;
 
+    /**
+     * Retrieves runtime metrics of the client (traffic, sync latency, log storage occupancy, etc.)
+     *
+     * @return @link MetricsRegistry @endlink object, use @link MetricsRegistry::getSnapshot() @endlink
+     * to export current values
+     */
+    virtual MetricsRegistry&                  getMetricsRegistry() = 0;
+
     virtual ~IKaaClient() { }
 };
 
@@ -18,7 +18,9 @@
 #define ICLIENTSTATESTORAGE_HPP_
 
 #include <cstdint>
+#include <list>
 #include <memory>
+#include <string>
 #include "kaa/gen/EndpointGen.hpp"
 #include "kaa/common/EndpointObjectHash.hpp"
 
@@ -41,6 +43,11 @@ typedef std::map<std::string, DetailedTopicState> DetailedTopicStates;
 
 typedef std::map<std::string, std::string> AttachedEndpoints;
 
+/**
+ * Uids of accepted unicast notifications, ordered from the oldest to the most recent one.
+ */
+typedef std::list<std::string> AcceptedUnicastNotificationIds;
+
 class IKaaClientStateStorage {
 public:
     virtual ~IKaaClientStateStorage() {}
@@ -69,6 +76,9 @@ public:
     virtual AttachedEndpoints getAttachedEndpoints() const = 0;
     virtual void setAttachedEndpoints(const AttachedEndpoints& endpoints) = 0;
 
+    virtual AcceptedUnicastNotificationIds getAcceptedUnicastNotificationIds() const = 0;
+    virtual void setAcceptedUnicastNotificationIds(const AcceptedUnicastNotificationIds& ids) = 0;
+
     virtual std::string getEndpointAccessToken() = 0;
     virtual void setEndpointAccessToken(const std::string& token) = 0;
     virtual std::string refreshEndpointAccessToken() = 0;
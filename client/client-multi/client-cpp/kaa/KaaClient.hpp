@@ -38,6 +38,7 @@
 #include "kaa/configuration/manager/ConfigurationManager.hpp"
 #include "kaa/configuration/storage/ConfigurationPersistenceManager.hpp"
 #include "kaa/log/LogCollector.hpp"
+#include "kaa/metrics/MetricsRegistry.hpp"
 
 namespace kaa {
 
@@ -55,7 +56,7 @@ typedef enum KaaOption
 class KaaClient : public IKaaClient {
 public:
     KaaClient();
-    virtual ~KaaClient() { }
+    virtual ~KaaClient();
 
     void init(int options = KAA_DEFAULT_OPTIONS);
     void start();
@@ -70,8 +71,10 @@ public:
     virtual EventFamilyFactory&                 getEventFamilyFactory();
 
     virtual void                                addLogRecord(const KaaUserLogRecord& record);
+    virtual void                                addLogRecord(const KaaUserLogRecord& record, LogPriority priority);
     virtual void                                setLogStorage(ILogStoragePtr storage);
     virtual void                                setLogUploadStrategy(ILogUploadStrategyPtr strategy);
+    virtual void                                setMaxLogBatchingDelay(std::size_t delay);
     virtual void                                setProfileContainer(ProfileContainerPtr container);
     virtual void                                addTopicListListener(INotificationTopicListListenerPtr listener);
     virtual void                                removeTopicListListener(INotificationTopicListListenerPtr listener);
@@ -104,12 +107,16 @@ public:
     virtual bool                                isAttachedToUser();
     virtual std::int32_t                        findEventListeners(const std::list<std::string>& eventFQNs
                                                                   , IFetchEventListeners* listener);
+    virtual void                                setPendingEventsLimits(std::size_t maxCount, std::size_t maxSize
+                                                                     , EventQueueOverflowPolicy policy);
+    virtual void                                setEventQueueListener(IEventQueueListener* listener);
 
 
 
 
     virtual IKaaDataMultiplexer&                getBootstrapMultiplexer();
     virtual IKaaDataDemultiplexer&              getBootstrapDemultiplexer();
+    virtual MetricsRegistry&                    getMetricsRegistry();
 private:
     void initKaaConfiguration();
     void initKaaTransport();
@@ -122,6 +129,7 @@ public:
                                            KaaOption::USE_DEFAULT_OPERATION_KAATCP_CHANNEL |
                                            KaaOption::USE_DEFAULT_CONNECTIVITY_CHECKER;
 private:
+    MetricsRegistry                                 metrics_;
     IKaaClientStateStoragePtr                       status_;
     IBootstrapManagerPtr                            bootstrapManager_;
     std::unique_ptr<ProfileManager>                 profileManager_;
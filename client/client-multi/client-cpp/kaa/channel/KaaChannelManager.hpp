@@ -20,6 +20,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <functional>
 
 #include "kaa/KaaThread.hpp"
 #include "kaa/KaaDefaults.hpp"
@@ -56,6 +57,12 @@ public:
 
     virtual void setConnectivityChecker(ConnectivityCheckerPtr checker);
 
+    /**
+     * Registers the callback which is called when channels are given a new Operations server (including failover)
+     * and when they are resumed. It must be registered before the channel manager is in use.
+     */
+    void registerConnectivityChangeReceiver(std::function<void ()> onConnectivityChange) { onConnectivityChange_ = onConnectivityChange; }
+
     void shutdown();
     void pause();
     void resume();
@@ -93,6 +100,8 @@ private:
     std::map<TransportType, IDataChannelPtr>    mappedChannels_;
 
     ConnectivityCheckerPtr connectivityChecker_;
+
+    std::function<void ()> onConnectivityChange_;
 };
 
 } /* namespace kaa */
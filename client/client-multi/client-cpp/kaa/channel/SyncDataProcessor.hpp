@@ -35,6 +35,10 @@
 
 namespace kaa {
 
+class Counter;
+class Histogram;
+class MetricsRegistry;
+
 typedef std::shared_ptr<IMetaDataTransport>       IMetaDataTransportPtr;
 typedef std::shared_ptr<IBootstrapTransport>      IBootstrapTransportPtr;
 typedef std::shared_ptr<IConfigurationTransport>  IConfigurationTransportPtr;
@@ -59,6 +63,11 @@ public:
 
     virtual std::vector<std::uint8_t> compileRequest(const std::map<TransportType, ChannelDirection>& transportTypes);
     virtual void processResponse(const std::vector<std::uint8_t> &response);
+
+    /**
+     * Sets the registry which receives the number, size and processing time of sync requests and responses.
+     */
+    void setMetricsRegistry(MetricsRegistry& registry);
 private:
     AvroByteArrayConverter<SyncRequest>     requestConverter_;
     AvroByteArrayConverter<SyncResponse>    responseConverter_;
@@ -76,6 +85,13 @@ private:
     IKaaClientStateStoragePtr   clientStatus_;
 
     std::int32_t                requestId;
+
+    Counter                    *requestsCompiled_;
+    Counter                    *requestBytes_;
+    Counter                    *responsesProcessed_;
+    Counter                    *responseBytes_;
+    Histogram                  *compileLatency_;
+    Histogram                  *processLatency_;
 };
 
 }  // namespace kaa
@@ -78,11 +78,21 @@ protected:
         return "/EP/LongSync";
     }
 
+    /**
+     * Outbound requests are sent to the regular (short-lived) sync endpoint
+     * so that the parked long poll request isn't interrupted.
+     */
+    std::string getSyncURLSuffix() {
+        return "/EP/Sync";
+    }
+
 private:
     void startPoll();
-    void stopPoll();
+    void stopPoll(KAA_MUTEX_UNIQUE& channelLock);
     void postTask();
     void executeTask();
+    void postSyncTask(const std::map<TransportType, ChannelDirection>& types);
+    void executeSyncTask();
     void doShutdown();
 
 private:
@@ -94,6 +104,13 @@ private:
     boost::asio::io_service io_;
     boost::asio::io_service::work work_;
     std::thread pollThread_;
+
+    boost::asio::io_service syncIo_;
+    boost::asio::io_service::work syncWork_;
+    std::thread syncThread_;
+    std::map<TransportType, ChannelDirection> pendingSyncTypes_;
+    bool syncTaskPosted_;
+
     bool stopped_;
     bool isShutdown_;
     bool isPaused_;
@@ -106,8 +123,8 @@ private:
     std::shared_ptr<IPTransportInfo> currentServer_;
     HttpDataProcessor httpDataProcessor_;
     HttpClient httpClient_;
+    HttpClient syncClient_;
     KAA_CONDITION_VARIABLE_DECLARE(waitCondition_);
-    KAA_MUTEX_DECLARE(conditionMutex_);
     KAA_MUTEX_DECLARE(channelGuard_);
 };
 
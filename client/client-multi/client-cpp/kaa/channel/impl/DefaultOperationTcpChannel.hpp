@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <thread>
 #include <array>
+#include <chrono>
 
 #include <boost/asio.hpp>
 
@@ -40,6 +41,9 @@ namespace kaa {
 
 class IKaaTcpRequest;
 class KeyPair;
+class Counter;
+class Histogram;
+class MetricsRegistry;
 
 class DefaultOperationTcpChannel : public IDataChannel {
 public:
@@ -80,6 +84,11 @@ public:
         connectivityChecker_= checker;
     }
 
+    /**
+     * Sets the registry which receives traffic, connection and sync round-trip metrics of the channel.
+     */
+    void setMetricsRegistry(MetricsRegistry& registry);
+
     void onReadEvent(const boost::system::error_code& err);
     void onPingTimeout(const boost::system::error_code& err);
 
@@ -102,6 +111,8 @@ private:
     boost::system::error_code sendPingRequest();
     boost::system::error_code sendData(const IKaaTcpRequest& request);
 
+    void markSyncSent();
+
     void readFromSocket();
     void setTimer();
 
@@ -143,6 +154,16 @@ private:
     KAA_MUTEX_DECLARE(channelGuard_);
 
     ConnectivityCheckerPtr connectivityChecker_;
+
+    MetricsRegistry *metrics_;
+    Counter         *bytesSent_;
+    Counter         *bytesReceived_;
+    Counter         *connections_;
+    Counter         *serverFailures_;
+    Histogram       *syncRoundTrip_;
+
+    bool isSyncInProgress_;
+    std::chrono::steady_clock::time_point syncSentTime_;
 };
 
 }
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BOUNDEDLRUSET_HPP_
+#define BOUNDEDLRUSET_HPP_
+
+#include <list>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+/**
+ * Set of unique values holding at most @c capacity elements.
+ * When the set is full, inserting a new value evicts the least recently inserted or refreshed one.
+ * Lookups and inserts run in constant time regardless of how many values have passed through the set.
+ *
+ * Not thread-safe, the owner is responsible for synchronization.
+ */
+template <typename T, typename Hash = std::hash<T> >
+class BoundedLruSet {
+public:
+    typedef typename std::list<T>::const_iterator const_iterator;
+
+    /**
+     * Throws \ref KaaException if the capacity is zero.
+     */
+    explicit BoundedLruSet(std::size_t capacity) : capacity_(capacity)
+    {
+        if (capacity_ == 0) {
+            throw KaaException("Bounded set capacity must be greater than zero");
+        }
+    }
+
+    /**
+     * Returns true if the value was not present in the set.
+     * An already present value is only marked as the most recent one.
+     */
+    bool insert(const T& value)
+    {
+        auto it = index_.find(value);
+        if (it != index_.end()) {
+            values_.splice(values_.end(), values_, it->second);
+            return false;
+        }
+
+        if (index_.size() >= capacity_) {
+            index_.erase(values_.front());
+            values_.pop_front();
+        }
+
+        index_.insert(std::make_pair(value, values_.insert(values_.end(), value)));
+        return true;
+    }
+
+    bool contains(const T& value) const { return index_.find(value) != index_.end(); }
+
+    std::size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+    std::size_t getCapacity() const { return capacity_; }
+
+    void clear()
+    {
+        index_.clear();
+        values_.clear();
+    }
+
+    /**
+     * Iterates from the oldest value to the most recent one.
+     */
+    const_iterator begin() const { return values_.begin(); }
+    const_iterator end() const { return values_.end(); }
+
+private:
+    const std::size_t                                                capacity_;
+    std::list<T>                                                     values_;
+    std::unordered_map<T, typename std::list<T>::iterator, Hash>     index_;
+};
+
+} /* namespace kaa */
+
+#endif /* BOUNDEDLRUSET_HPP_ */
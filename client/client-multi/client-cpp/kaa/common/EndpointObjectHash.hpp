@@ -61,6 +61,11 @@ public:
      */
     EndpointObjectHash& operator=(EndpointObjectHash&& endpointHash);
 
+    /**
+     * Wraps an already calculated digest, no hashing is performed
+     */
+    static EndpointObjectHash fromDigest(const HashDigest& digest);
+
     /**
      * Retrieves digest
      * @return Buffer with digest or empty one if no data was put
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LZFCODEC_HPP_
+#define LZFCODEC_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace kaa {
+
+/**
+ * Fast dependency-free LZ77 compression producing the LZF stream format,
+ * the same one the C SDK uses for log buckets.
+ */
+class LzfCodec {
+public:
+    /**
+     * Compresses @c size bytes of @c data and appends the result to @c out.
+     */
+    static void compress(const std::uint8_t *data, std::size_t size, std::vector<std::uint8_t>& out);
+
+    /**
+     * Decompresses an LZF stream which is known to produce exactly @c rawSize bytes.
+     * Throws \ref KaaException if the stream is corrupted.
+     */
+    static std::vector<std::uint8_t> decompress(const std::uint8_t *data, std::size_t size, std::size_t rawSize);
+};
+
+}  // namespace kaa
+
+#endif /* LZFCODEC_HPP_ */
@@ -24,16 +24,34 @@
 
 namespace kaa {
 
+/**
+ * Stores configuration in a file.
+ *
+ * The data is written to a temporary file, synced to disk and renamed over the previous one,
+ * so a crash in the middle of a write leaves the old configuration intact.
+ * SHA-1 of the data is kept in a "<filename>.sha1" file next to it, this allows to skip writes of
+ * byte-identical data and to provide the hash on start-up without rehashing the stored configuration.
+ * The stored hash is ignored if the size or the modification time of the data file has changed since.
+ */
 class FileConfigurationStorage : public IConfigurationStorage {
 public:
     FileConfigurationStorage(const std::string& filename) : filename_(filename) { }
     FileConfigurationStorage(std::string&& filename) : filename_(std::move(filename)) { }
 
     virtual void saveConfiguration(std::vector<std::uint8_t>&& bytes);
+    virtual void saveConfiguration(std::vector<std::uint8_t>&& bytes, const HashDigest& hash);
     virtual std::vector<std::uint8_t> loadConfiguration();
+    virtual HashDigest getConfigurationHash();
+
+private:
+    std::string getHashFilename() const { return filename_ + ".sha1"; }
+
+    void readStoredHash();
+    void saveHash();
 
 private:
     std::string filename_;
+    HashDigest hash_;
 };
 
 }
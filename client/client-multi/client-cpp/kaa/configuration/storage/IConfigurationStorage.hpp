@@ -21,6 +21,8 @@
 #include <memory>
 #include <cstdint>
 
+#include "kaa/common/EndpointObjectHash.hpp"
+
 namespace kaa {
 
 /**
@@ -40,12 +42,30 @@ public:
      */
     virtual void saveConfiguration(std::vector<std::uint8_t>&& bytes) = 0;
 
+    /**
+     * Optional routine to persist configuration data along with its already calculated SHA-1 hash.
+     *
+     * @param bytes Configuration binary data.
+     * @param hash  SHA-1 hash of the configuration binary data.
+     */
+    virtual void saveConfiguration(std::vector<std::uint8_t>&& bytes, const HashDigest& hash)
+    {
+        saveConfiguration(std::move(bytes));
+    }
+
     /**
      * Specifies routine to load configuration data.
      *
      * @return Configuration binary data.
      */
     virtual std::vector<std::uint8_t> loadConfiguration() = 0;
+
+    /**
+     * Optional routine to get SHA-1 hash of the stored configuration data without rehashing it.
+     *
+     * @return Hash of the data returned by @link loadConfiguration @endlink or empty digest if unknown.
+     */
+    virtual HashDigest getConfigurationHash() { return HashDigest(); }
 };
 
 typedef std::shared_ptr<IConfigurationStorage> IConfigurationStoragePtr;
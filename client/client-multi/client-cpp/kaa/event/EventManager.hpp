@@ -31,6 +31,7 @@
 #include "kaa/event/IEventListenersResolver.hpp"
 #include "kaa/event/EventTransport.hpp"
 #include "kaa/event/IEventDataProcessor.hpp"
+#include "kaa/event/IEventQueueListener.hpp"
 #include "kaa/IKaaClientStateStorage.hpp"
 #include "kaa/transact/AbstractTransactable.hpp"
 
@@ -42,6 +43,11 @@ class EventManager : public IEventManager
                    , public AbstractTransactable<std::list<Event> >
 {
 public:
+    static const std::size_t DEFAULT_MAX_PENDING_EVENTS_COUNT = 1024; /*!< The default maximum number of
+                                                                          events waiting for delivery. */
+    static const std::size_t DEFAULT_MAX_PENDING_EVENTS_SIZE = 1024 * 1024; /*!< The default maximum size (in bytes)
+                                                                                of events waiting for delivery. */
+
     EventManager(IKaaClientStateStoragePtr status)
         : currentEventIndex_(0),eventTransport_(nullptr)
         , status_(status)
@@ -55,11 +61,34 @@ public:
                             , const std::string& target
                             , TransactionIdPtr trxId);
 
+    virtual void produceEvent(const std::string& fqn
+                            , std::vector<std::uint8_t>&& data
+                            , const std::string& target
+                            , TransactionIdPtr trxId);
+
+    /**
+     * Limits the queue of events waiting for delivery. The size of an event is
+     * the total length of its data, class FQN and target. Events which were sent
+     * but not yet acknowledged by the server count against the limits as well.
+     *
+     * @param maxCount  Maximum number of pending events.
+     * @param maxSize   Maximum size (in bytes) of pending events.
+     * @param policy    What to do with a produced event which doesn't fit into the limits.
+     *
+     * @throw KaaException when any of the limits is zero.
+     */
+    void setPendingEventsLimits(std::size_t maxCount, std::size_t maxSize, EventQueueOverflowPolicy policy);
+
+    void setEventQueueListener(IEventQueueListener *listener);
+
+    std::size_t getDroppedEventsCount() const;
+
     virtual void onEventsReceived(const EventSyncResponse::events_t& events);
     virtual void onEventListenersReceived(const EventSyncResponse::eventListenersResponses_t& listeners);
 
     virtual std::map<std::int32_t, Event> releasePendingEvents();
     virtual bool hasPendingEvents() const;
+    virtual void onEventsDelivered(const std::list<Event>& events);
 
     virtual std::map<std::int32_t, std::list<std::string> > getPendingListenerRequests();
     virtual bool hasPendingListenerRequests() const;
@@ -90,6 +119,23 @@ private:
                          , const std::string& source);
 
     void generateUniqueRequestId(std::string& requstId);
+
+    static std::size_t getEventSize(const Event& event);
+
+    /**
+     * Should be called under @c pendingEventsGuard_.
+     * @return true if an event of the given size doesn't fit into the limits
+     * together with the pending events and the ones being sent.
+     */
+    bool isEventQueueFull(std::size_t eventSize) const;
+
+    /**
+     * Should be called under @c pendingEventsGuard_.
+     * @return false if the event was rejected.
+     */
+    bool enqueuePendingEvent(Event&& event);
+
+    void onEventsDropped(std::size_t droppedEventsCount, IEventQueueListener *listener);
 private:
     std::set<IEventFamily*>   eventFamilies_;
     std::map<std::int32_t, Event>          pendingEvents_;
@@ -97,6 +143,16 @@ private:
 
     std::int32_t currentEventIndex_;
 
+    std::size_t pendingEventsSize_ = 0;
+    std::size_t inFlightEventsCount_ = 0;
+    std::size_t inFlightEventsSize_ = 0;
+    std::size_t maxPendingEventsCount_ = DEFAULT_MAX_PENDING_EVENTS_COUNT;
+    std::size_t maxPendingEventsSize_ = DEFAULT_MAX_PENDING_EVENTS_SIZE;
+    EventQueueOverflowPolicy overflowPolicy_ = EventQueueOverflowPolicy::REJECT_NEW;
+    std::size_t droppedEventsCount_ = 0;
+    bool isEventQueueFull_ = false;
+    IEventQueueListener *eventQueueListener_ = nullptr;
+
     EventTransport *          eventTransport_;
     IKaaClientStateStoragePtr status_;
 
@@ -29,6 +29,11 @@ class IEventDataProcessor {
 public:
     virtual std::map<std::int32_t, Event> releasePendingEvents() = 0;
     virtual bool hasPendingEvents() const  = 0;
+
+    /**
+     * Called when the server acknowledged events previously taken by @link releasePendingEvents @endlink.
+     */
+    virtual void onEventsDelivered(const std::list<Event>& events) = 0;
     virtual std::map<std::int32_t, std::list<std::string> > getPendingListenerRequests() = 0;
     virtual bool hasPendingListenerRequests() const = 0;
 
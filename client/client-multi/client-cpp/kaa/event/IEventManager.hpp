@@ -54,6 +54,14 @@ public:
                             , const std::string& target
                             , TransactionIdPtr trxId) = 0;
 
+    /**
+     * Same as above, but takes ownership of the event data instead of copying it.
+     */
+    virtual void produceEvent(const std::string& fqn
+                            , std::vector<std::uint8_t>&& data
+                            , const std::string& target
+                            , TransactionIdPtr trxId) = 0;
+
     virtual ~IEventManager() {}
 };
 
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef IEVENTQUEUELISTENER_HPP_
+#define IEVENTQUEUELISTENER_HPP_
+
+#include <cstddef>
+
+namespace kaa {
+
+/**
+ * Defines what happens to a produced event when the pending events queue is full.
+ */
+enum class EventQueueOverflowPolicy {
+    REJECT_NEW,     /*!< The produced event is discarded. */
+    DROP_OLDEST     /*!< The oldest pending events are discarded to free space for the produced one. */
+};
+
+/**
+ * Listener interface for the backpressure signals of the pending events queue.
+ *
+ * Events are queued while they can't be delivered to the server (e.g. during outages).
+ * Callbacks are invoked from the thread which produces or releases events,
+ * so they should not block.
+ */
+class IEventQueueListener {
+public:
+
+    /**
+     * Called each time an event is discarded because of the queue limits.
+     *
+     * @param droppedEventsCount    Total number of events discarded so far.
+     */
+    virtual void onEventQueueFull(std::size_t droppedEventsCount) = 0;
+
+    /**
+     * Called when the server acknowledged sent events and the queue has room again
+     * after it had been full.
+     */
+    virtual void onEventQueueAvailable() = 0;
+
+    virtual ~IEventQueueListener() {}
+};
+
+} /* namespace kaa */
+
+#endif /* IEVENTQUEUELISTENER_HPP_ */
@@ -36,6 +36,8 @@ public:
     virtual void closeConnection();
 
 private:
+    static const std::size_t RESPONSE_BUFFER_SIZE = 4096;
+
     void checkError(const boost::system::error_code& code);
     void doSocketClose();
 
@@ -22,26 +22,80 @@
 #include "kaa/http/IHttpResponse.hpp"
 
 #include <map>
+#include <string>
 
 namespace kaa {
 
+/**
+ * HTTP response which may be either parsed at once or built incrementally
+ * while bytes arrive from the socket (see @link feed @endlink).
+ *
+ * Both "Content-Length" and chunked transfer encoding are supported.
+ * If neither is present, the body lasts until the connection is closed.
+ * The body is written directly into the buffer returned by @link getBody @endlink.
+ */
 class HttpResponse : public IHttpResponse {
 public:
+    HttpResponse();
     HttpResponse(const char *data, std::size_t len);
     HttpResponse(const std::string& data);
     ~HttpResponse() { }
 
+    /**
+     * Consumes the next portion of the raw response.
+     *
+     * @return The number of consumed bytes. It is less than @c len only if the
+     * response has been completed and the rest of the data doesn't belong to it.
+     * @throws KaaException if the response is malformed.
+     */
+    std::size_t feed(const char *data, std::size_t len);
+
+    /**
+     * Notifies the parser that the server closed the connection.
+     *
+     * @throws KaaException if the response is incomplete.
+     */
+    void finish();
+
+    bool isComplete() const { return state_ == ParserState::COMPLETE; }
+
     virtual std::string getHeaderField(const std::string& name) const;
     virtual SharedBody getBody() const;
     virtual int getStatusCode() const;
 
 private:
     static const std::uint8_t  HTTP_VERSION_OFFSET = 9;
+    static const std::size_t   MAX_LINE_LENGTH = 8192;
+    static const std::size_t   MAX_BODY_SIZE = 64 * 1024 * 1024;
+
+    enum class ParserState {
+        STATUS_LINE,
+        HEADERS,
+        BODY,
+        BODY_UNTIL_CLOSE,
+        CHUNK_SIZE,
+        CHUNK_DATA,
+        CHUNK_DATA_END,
+        CHUNK_TRAILER,
+        COMPLETE
+    };
 
-    void parseResponse(const char *data, size_t len);
+    bool readLine(const char *&cursor, const char *end);
+    void processStatusLine();
+    void processHeaderLine();
+    void processHeadersEnd();
+    void processChunkSizeLine();
+    void reserveBody(std::size_t size);
+    void appendBody(const char *data, std::size_t len);
 
 private:
     SharedBody body_;
+    std::size_t bodyCapacity_;
+    std::size_t bytesToRead_;
+    std::string line_;
+    bool lineCompleted_;
+    ParserState state_;
+
     std::map<std::string, std::string> header_;
     int statusCode_;
 };
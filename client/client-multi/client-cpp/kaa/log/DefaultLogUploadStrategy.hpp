@@ -17,9 +17,12 @@
 #ifndef DEFAULTLOGUPLOADSTRATEGY_HPP_
 #define DEFAULTLOGUPLOADSTRATEGY_HPP_
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 
+#include "kaa/KaaThread.hpp"
+#include "kaa/log/LogPriority.hpp"
 #include "kaa/log/ILogUploadStrategy.hpp"
 #include "kaa/channel/IKaaChannelManager.hpp"
 
@@ -67,6 +70,24 @@ public:
     void setVolumeThreshold(std::size_t maxVolume) { uploadVolumeThreshold_ = maxVolume; }
     void setCountThreshold(std::size_t maxCount) { uploadCountThreshold_ = maxCount; }
 
+    /**
+     * Sets the log volume of the given priority to initiate the log upload regardless of other logs.
+     * 0 means logs of this priority are taken into account only by the overall volume threshold.
+     */
+    void setVolumeThreshold(LogPriority priority, std::size_t maxVolume)
+    {
+        priorityVolumeThresholds_[static_cast<std::size_t>(priority)] = maxVolume;
+    }
+
+    /**
+     * Sets the log count of the given priority to initiate the log upload regardless of other logs.
+     * 0 means logs of this priority are taken into account only by the overall count threshold.
+     */
+    void setCountThreshold(LogPriority priority, std::size_t maxCount)
+    {
+        priorityCountThresholds_[static_cast<std::size_t>(priority)] = maxCount;
+    }
+
 public:
     static const std::size_t DEFAULT_BATCH_SIZE = 8 * 1024; /*!< The default value (in bytes) for the maximum size of
                                                                  the report pack that will be delivered in a single
@@ -84,6 +105,13 @@ public:
     static const std::size_t DEFAULT_UPLOAD_COUNT_THRESHOLD = 64; /*!< The default value for the log count to initiate
                                                                        the log upload. */
 
+    static const std::size_t DEFAULT_CRITICAL_UPLOAD_COUNT_THRESHOLD = 1; /*!< The default value for the count of
+                                                                               @c LogPriority::CRITICAL logs to
+                                                                               initiate the log upload. */
+
+private:
+    LogUploadStrategyDecision checkPriorityThresholds(ILogStorageStatus& status);
+
 private:
     std::size_t batchSize_ = DEFAULT_BATCH_SIZE;
 
@@ -93,8 +121,13 @@ private:
     std::size_t uploadVolumeThreshold_ = DEFAULT_UPLOAD_VOLUME_THRESHOLD;
     std::size_t uploadCountThreshold_ = DEFAULT_UPLOAD_COUNT_THRESHOLD;
 
+    std::array<std::size_t, LOG_PRIORITY_COUNT> priorityVolumeThresholds_ = {{ 0, 0, 0, 0 }};
+    std::array<std::size_t, LOG_PRIORITY_COUNT> priorityCountThresholds_ = {{ 0, 0, 0,
+                                                                              DEFAULT_CRITICAL_UPLOAD_COUNT_THRESHOLD }};
+
     typedef std::chrono::system_clock Clock;
     std::chrono::time_point<Clock> nextUploadAttemptTS_;
+    KAA_MUTEX_DECLARE(nextUploadAttemptGuard_);
 
     IKaaChannelManagerPtr channelManager_;
 };
@@ -18,6 +18,7 @@
 #define ILOGCOLLECTOR_HPP_
 
 #include "kaa/log/gen/LogGen.hpp"
+#include "kaa/log/LogPriority.hpp"
 #include "kaa/log/ILogStorage.hpp"
 #include "kaa/log/ILogUploadStrategy.hpp"
 
@@ -47,10 +48,14 @@ typedef SuperRecord KaaUserLogRecord;
  * By default, @c MemoryLogStorage and @c DefaultLogUploadStrategy are used as the log storage and as the upload
  * strategy respectively.
  *
+ * Besides, the strategy is periodically evaluated by a timer, so buffered logs are uploaded even if no new records
+ * are added.
+ *
  * The subsystem also tracks whether the log delivery timeout is occurred. The timeout means the log delivery response
  * isn't received in time, specified by @link ILogUploadStrategy::getTimeout() @endlink.
- * The check is done in the lazy manner, on each the @link addLogRecord() @endlink call. If the timeout is occurred,
- * the log upload strategy will be notified of it via the @link ILogUploadStrategy::onTimeout() @endlink callback.
+ * The check is done by the same timer as soon as the timeout expires, and on each the @link addLogRecord() @endlink
+ * call. If the timeout is occurred, the log upload strategy will be notified of it via
+ * the @link ILogUploadStrategy::onTimeout() @endlink callback.
  */
 class ILogCollector {
 public:
@@ -67,6 +72,19 @@ public:
      */
     virtual void addLogRecord(const KaaUserLogRecord& record) = 0;
 
+    /**
+     * @brief Adds a new log record of the specified priority to the log storage.
+     *
+     * Records of higher priority are uploaded first and are the last to be deleted if the storage is full.
+     * @link addLogRecord(const KaaUserLogRecord&) @endlink adds records of @c LogPriority::NORMAL.
+     *
+     * @param[in] record      The log record to be added.
+     * @param[in] priority    The priority of the log record.
+     *
+     * @see LogPriority
+     */
+    virtual void addLogRecord(const KaaUserLogRecord& record, LogPriority priority) = 0;
+
     /**
      * @brief Sets the new log storage.
      *
@@ -89,6 +107,16 @@ public:
      */
     virtual void setUploadStrategy(ILogUploadStrategyPtr strategy) = 0;
 
+    /**
+     * @brief Sets the maximum time logs may be buffered before their upload is initiated.
+     *
+     * When the oldest buffered log record waits for longer than the delay, the upload is initiated even if
+     * the upload strategy doesn't require it yet.
+     *
+     * @param[in] delay    The delay in seconds. 0 (default) means logs are uploaded only by the strategy decision.
+     */
+    virtual void setMaxBatchingDelay(std::size_t delay) = 0;
+
     virtual ~ILogCollector() {}
 };
 
@@ -19,6 +19,8 @@
 
 #include <cstdint>
 
+#include "kaa/log/LogPriority.hpp"
+
 namespace kaa {
 
 /**
@@ -43,6 +45,30 @@ public:
      */
     virtual std::size_t getRecordsCount() = 0;
 
+    /**
+     * @brief Returns amount of bytes collected logs of the specified priority are consumed.
+     *
+     * Storages which don't distinguish priorities report all logs as @c LogPriority::NORMAL.
+     *
+     * @return Size (in bytes).
+     */
+    virtual std::size_t getConsumedVolume(LogPriority priority)
+    {
+        return (priority == LogPriority::NORMAL ? getConsumedVolume() : 0);
+    }
+
+    /**
+     * @brief Returns the number of collected logs of the specified priority.
+     *
+     * Storages which don't distinguish priorities report all logs as @c LogPriority::NORMAL.
+     *
+     * @return The number of collected logs.
+     */
+    virtual std::size_t getRecordsCount(LogPriority priority)
+    {
+        return (priority == LogPriority::NORMAL ? getRecordsCount() : 0);
+    }
+
     virtual ~ILogStorageStatus() {}
 };
 
@@ -78,6 +78,9 @@ public:
      * @brief Callback is used when the log delivery timeout detected.
      *
      * More information about the detection of the log delivery timeout read in the documentation for @c ILogCollector.
+     *
+     * @b NOTE: This callback and @link onFailure @endlink may be called concurrently with
+     * @link isUploadNeeded @endlink, e.g. from the log upload scheduler and the transport threads.
      */
     virtual void onTimeout() = 0;
 
@@ -18,10 +18,15 @@
 #define LOGCOLLECTOR_HPP_
 
 
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
+#include <boost/asio.hpp>
+
 #include "kaa/KaaThread.hpp"
 #include "kaa/log/ILogStorage.hpp"
 #include "kaa/log/ILogCollector.hpp"
@@ -32,6 +37,9 @@
 namespace kaa {
 
 class LoggingTransport;
+class Counter;
+class Gauge;
+class MetricsRegistry;
 
 /**
  * Default @c ILogCollector implementation.
@@ -39,23 +47,53 @@ class LoggingTransport;
 class LogCollector : public ILogCollector, public ILogProcessor {
 public:
     LogCollector(IKaaChannelManagerPtr manager);
+    ~LogCollector();
 
     virtual void addLogRecord(const KaaUserLogRecord& record);
+    virtual void addLogRecord(const KaaUserLogRecord& record, LogPriority priority);
 
     virtual void setStorage(ILogStoragePtr storage);
     virtual void setUploadStrategy(ILogUploadStrategyPtr strategy);
+    virtual void setMaxBatchingDelay(std::size_t delay);
 
     std::shared_ptr<LogSyncRequest> getLogUploadRequest();
     virtual void onLogUploadResponse(const LogSyncResponse& response);
 
     void setTransport(LoggingTransport* transport);
 
+    /**
+     * Sets the registry which receives the log record, upload and storage occupancy metrics.
+     */
+    void setMetricsRegistry(MetricsRegistry& registry);
+
+    /**
+     * Re-evaluates the upload strategy as soon as possible, e.g. when the connection to the server is restored.
+     */
+    void onConnectivityChanged();
+
+    /**
+     * Stops the log upload scheduler. Must be called before the log transport is destroyed. It's safe to call it
+     * more than once.
+     */
+    void shutdown();
+
+public:
+    static const std::size_t UPLOAD_CHECK_PERIOD = 5; /*!< The maximum period (in seconds) between two evaluations
+                                                           of the upload strategy which aren't caused by new log
+                                                           records. */
+
 private:
     void doSync();
     void processLogUploadDecision(LogUploadStrategyDecision decision);
 
     bool isDeliveryTimeout();
 
+    void scheduleUploadCheck();
+    void onUploadCheckTimer(const boost::system::error_code& err);
+    void checkUpload();
+
+    void updateStorageMetrics();
+
 private:
     ILogStoragePtr        storage_;
     ILogUploadStrategyPtr uploadStrategy_;
@@ -63,10 +101,27 @@ private:
     KAA_MUTEX_DECLARE(storageGuard_);
 
     RequestId requestId_;
-    LoggingTransport* transport_;
+    std::atomic<LoggingTransport*> transport_;
 
     typedef std::chrono::system_clock clock_t;
     std::unordered_map<std::int32_t, std::chrono::time_point<clock_t>> timeoutsMap_;
+    KAA_MUTEX_DECLARE(timeoutsGuard_);
+
+    Counter *recordsAdded_;
+    Counter *uploadRequests_;
+    Counter *uploadFailures_;
+    Counter *uploadTimeouts_;
+    Gauge   *storageRecords_;
+    Gauge   *storageVolume_;
+
+    std::size_t maxBatchingDelay_;
+    std::chrono::time_point<clock_t> firstPendingRecordTS_;
+
+    boost::asio::io_service io_;
+    boost::asio::io_service::work work_;
+    boost::asio::deadline_timer uploadCheckTimer_;
+    std::thread schedulerThread_;
+    std::once_flag shutdownFlag_;
 };
 
 }  // namespace kaa
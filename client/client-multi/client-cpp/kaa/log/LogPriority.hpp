@@ -0,0 +1,43 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOGPRIORITY_HPP_
+#define LOGPRIORITY_HPP_
+
+#include <cstddef>
+
+namespace kaa {
+
+/**
+ * @brief The importance class of a log record.
+ *
+ * Records of higher priority are uploaded first and are the last to be evicted when the log storage is full.
+ */
+enum class LogPriority {
+    LOW = 0,  /*!< Routine data which may be dropped first. */
+    NORMAL,   /*!< The priority of records added without an explicit priority. */
+    HIGH,     /*!< Important data. */
+    CRITICAL  /*!< Alarms which should be delivered as soon as possible. */
+};
+
+/**
+ * @brief The number of @c LogPriority classes.
+ */
+const std::size_t LOG_PRIORITY_COUNT = static_cast<std::size_t>(LogPriority::CRITICAL) + 1;
+
+}  // namespace kaa
+
+#endif /* LOGPRIORITY_HPP_ */
@@ -22,6 +22,7 @@
 
 #include "kaa/KaaThread.hpp"
 #include "kaa/gen/EndpointGen.hpp"
+#include "kaa/log/LogPriority.hpp"
 #include "kaa/log/ILogCollector.hpp"
 #include "kaa/common/AvroByteArrayConverter.hpp"
 
@@ -29,21 +30,34 @@ namespace kaa {
 
 class LogRecord {
 public:
-    LogRecord(const KaaUserLogRecord& record)
+    LogRecord(const KaaUserLogRecord& record, LogPriority priority = LogPriority::NORMAL)
+        : priority_(priority)
     {
         converter_.toByteArray(record, serializedLog_.data);
     }
 
+    /**
+     * Wraps the already serialized log record.
+     */
+    explicit LogRecord(std::vector<std::uint8_t>&& serializedData, LogPriority priority = LogPriority::NORMAL)
+        : priority_(priority)
+    {
+        serializedLog_.data = std::move(serializedData);
+    }
+
     const std::vector<std::uint8_t>& getData() const { return serializedLog_.data; }
     size_t getSize() const { return serializedLog_.data.size(); }
 
+    LogPriority getPriority() const { return priority_; }
+
     const LogEntry& getLogEntry() { return serializedLog_; }
 
 private:
     static kaa_thread_local AvroByteArrayConverter<KaaUserLogRecord> converter_;
 
 private:
-    LogEntry serializedLog_;
+    LogEntry       serializedLog_;
+    LogPriority    priority_;
 };
 
 typedef std::shared_ptr<LogRecord> LogRecordPtr;
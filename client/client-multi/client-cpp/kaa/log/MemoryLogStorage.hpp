@@ -18,6 +18,8 @@
 #define MEMORYLOGSTORAGE_HPP_
 
 #include <list>
+#include <array>
+#include <vector>
 #include <cstdint>
 
 #include "kaa/KaaThread.hpp"
@@ -29,6 +31,9 @@ namespace kaa {
 /**
  * @brief The default @c ILogStorage implementation.
  *
+ * Records of each @c LogPriority are kept in a separate queue. Upload blocks are filled starting from the highest
+ * priority, and if the storage is full, the lowest priority records are deleted first.
+ *
  * @b NOTE: Collected logs are stored in a memory. So logs will be lost if the SDK has been restarted earlier than
  * they are delivered to the Operations server.
  */
@@ -42,8 +47,8 @@ public:
     /**
      * @brief Creates the size-limited log storage.
      *
-     * If the size of collected logs exceeds the specified maximum size of the log storage, elder logs will be
-     * forcibly deleted. The amount of logs (in bytes) to be deleted is computed by the formula:
+     * If the size of collected logs exceeds the specified maximum size of the log storage, elder logs of the lowest
+     * priority will be forcibly deleted. The amount of logs (in bytes) to be deleted is computed by the formula:
      *
      * SIZE = (MAX_SIZE * PERCENT_TO_DELETE) / 100, where PERCENT_TO_DELETE is in the (0.0, 100.0] range.
      *
@@ -64,8 +69,28 @@ public:
     virtual std::size_t getConsumedVolume();
     virtual std::size_t getRecordsCount();
 
+    virtual std::size_t getConsumedVolume(LogPriority priority);
+    virtual std::size_t getRecordsCount(LogPriority priority);
+
+    /**
+     * @brief Enables packing of consecutive log records into compressed blocks.
+     *
+     * Once not yet uploaded records reach @c blockSize bytes, they are compressed together and
+     * decompressed back only when they are picked up by @link getRecordBlock @endlink. Both the storage
+     * size limit and @link getConsumedVolume @endlink then account for the compressed size. Records newer
+     * than one being uploaded are left as is until that upload completes, so records keep their order.
+     *
+     * @param[in] blockSize    The raw size (in bytes) of records to be compressed together. 0 disables compression.
+     */
+    void setCompressionBlockSize(std::size_t blockSize);
+
 private:
+    struct RecordQueue;
+
     void shrinkToSize(std::size_t allowedVolume);
+    void shrinkQueue(RecordQueue& queue, std::size_t allowedVolume, std::size_t& removedRecordCount);
+    void compressUnmarkedRecords(RecordQueue& queue);
+    bool fillRecordBlock(RecordQueue& queue, RecordBlockId recordBlockId, RecordBlock& block, std::size_t& blockSize);
 
 private:
     struct LogRecordWrapper {
@@ -76,18 +101,44 @@ private:
         RecordBlockId    blockId_;
     };
 
+    struct CompressedRecordInfo {
+        CompressedRecordInfo(std::size_t size, std::size_t occupiedSize)
+            : size_(size), occupiedSize_(occupiedSize), blockId_(NO_OWNER), isRemoved_(false) {}
+
+        std::size_t      size_;
+        std::size_t      occupiedSize_;
+        RecordBlockId    blockId_;
+        bool             isRemoved_;
+    };
+
+    struct CompressedBlock {
+        std::vector<std::uint8_t>            data_;
+        bool                                 isCompressed_ = false;
+        std::size_t                          rawSize_ = 0;
+        std::size_t                          remainingRecordCount_ = 0;
+        std::vector<CompressedRecordInfo>    records_;
+    };
+
+    struct RecordQueue {
+        size_t occupiedSizeOfUnmarkedRecords_ = 0;
+        size_t unmarkedRecordCount_ = 0;
+        size_t uncompressedSize_ = 0; // Raw size of unmarked records which are not compressed yet.
+
+        std::list<CompressedBlock> compressedBlocks_;
+        std::list<LogRecordWrapper> logs_;
+    };
+
     typedef RequestId BlockId;
 
 private:
     size_t totalOccupiedSize_ = 0;
-    size_t occupiedSizeOfUnmarkedRecords_ = 0;
-
-    size_t unmarkedRecordCount_ = 0;
 
     size_t maxOccupiedSize_ = 0;
     size_t shrinkedSize_ = 0;
 
-    std::list<LogRecordWrapper> logs_;
+    size_t compressionBlockSize_ = 0;
+
+    std::array<RecordQueue, LOG_PRIORITY_COUNT> queues_;
     KAA_MUTEX_DECLARE(logsGuard_);
 
     BlockId recordBlockId_;
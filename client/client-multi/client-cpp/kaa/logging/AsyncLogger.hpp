@@ -0,0 +1,102 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ASYNCLOGGER_HPP_
+#define ASYNCLOGGER_HPP_
+
+#include "kaa/KaaDefaults.hpp"
+
+#if KAA_LOG_LEVEL > KAA_LOG_LEVEL_NONE && defined(KAA_THREADSAFE)
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "kaa/KaaThread.hpp"
+#include "kaa/logging/ILogger.hpp"
+
+namespace kaa {
+
+/**
+ * Logger which moves writing of log messages off the calling thread.
+ *
+ * Messages are copied into a preallocated ring buffer and passed to the target
+ * logger by a background thread. If the buffer is full, the message is dropped
+ * and the drop counter is incremented, so the caller is never blocked by a slow sink.
+ * Messages longer than @c MAX_MESSAGE_LENGTH - 1 characters are cut and end with @c TRUNCATION_MARKER.
+ */
+class AsyncLogger : public ILogger {
+public:
+    static const std::size_t DEFAULT_QUEUE_CAPACITY = 1024;
+    static const std::size_t MAX_MESSAGE_LENGTH     = 512;
+    static constexpr char    TRUNCATION_MARKER[] = "...[truncated]";
+
+    /**
+     * @param target    The logger which actually writes messages.
+     * @param capacity  The maximum number of messages waiting to be written.
+     */
+    AsyncLogger(LoggerPtr target, std::size_t capacity = DEFAULT_QUEUE_CAPACITY);
+    ~AsyncLogger();
+
+    virtual void log(LogLevel level, const char *message) const;
+
+    virtual bool isLogLevelEnabled(LogLevel level) const {
+        return target_->isLogLevelEnabled(level);
+    }
+
+    /**
+     * Blocks until all queued messages are written by the target logger.
+     */
+    void flush() const;
+
+    /**
+     * @return The number of messages dropped because the queue was full.
+     */
+    std::uint64_t getDroppedCount() const { return droppedCount_; }
+
+private:
+    struct LogEntry {
+        LogLevel       level;
+        char           message[MAX_MESSAGE_LENGTH];
+    };
+
+    void processQueue();
+
+private:
+    LoggerPtr    target_;
+
+    mutable std::vector<LogEntry>   entries_;
+    mutable std::size_t             head_;
+    mutable std::size_t             size_;
+    mutable std::atomic<std::uint64_t> droppedCount_;
+
+    std::uint64_t   reportedDropCount_;
+    bool            stopped_;
+    std::thread     worker_;
+
+    KAA_MUTEX_MUTABLE_DECLARE(queueGuard_);
+    mutable KAA_CONDITION_VARIABLE_DECLARE(queueCondition_);
+    mutable KAA_CONDITION_VARIABLE_DECLARE(flushCondition_);
+};
+
+}  // namespace kaa
+
+#endif
+
+#endif /* ASYNCLOGGER_HPP_ */
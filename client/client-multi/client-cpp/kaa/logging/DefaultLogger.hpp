@@ -22,16 +22,34 @@
 #if KAA_LOG_LEVEL > KAA_LOG_LEVEL_NONE
 
 #include "kaa/logging/ILogger.hpp"
+
+#include <atomic>
 #include <boost/log/trivial.hpp>
 
 namespace kaa {
 
 class DefaultLogger : public ILogger {
 public:
+    DefaultLogger(LogLevel level = LogLevel::TRACE) : level_(level) {}
+
     void log(LogLevel level, const char *message) const {
         BOOST_LOG_STREAM_WITH_PARAMS(boost::log::trivial::logger::get(),
                 (boost::log::keywords::severity = (boost::log::trivial::severity_level)level)) << message;
     }
+
+    bool isLogLevelEnabled(LogLevel level) const {
+        return level >= level_;
+    }
+
+    /**
+     * Changes the minimal level of written messages at runtime.
+     */
+    void setLogLevel(LogLevel level) {
+        level_ = level;
+    }
+
+private:
+    std::atomic<LogLevel> level_;
 };
 
 }  // namespace kaa
@@ -17,6 +17,8 @@
 #ifndef ILOGGER_HPP_
 #define ILOGGER_HPP_
 
+#include <memory>
+
 namespace kaa {
 
 enum class LogLevel {
@@ -33,6 +35,13 @@ public:
     virtual ~ILogger() {}
 
     virtual void log(LogLevel level, const char *message) const = 0;
+
+    /**
+     * Used by the KAA_LOG_* macros to skip building messages which would be discarded.
+     *
+     * @return true if messages of the given level are written by this logger.
+     */
+    virtual bool isLogLevelEnabled(LogLevel level) const { return true; }
 };
 
 typedef std::shared_ptr<ILogger> LoggerPtr;
@@ -43,40 +43,52 @@ void kaa_log(const ILogger & logger, LogLevel level, const char *message, const
 void kaa_log(const ILogger & logger, LogLevel level, const std::string &message, const char *file, size_t lineno);
 void kaa_log(const ILogger & logger, LogLevel level, const boost::format& message, const char *file, size_t lineno);
 
+/*
+ * The message expression is evaluated only if the installed logger accepts
+ * the given level, so expensive dumps cost nothing when they are filtered out.
+ */
+#define KAA_LOG_IF_ENABLED(level, message) \
+    do { \
+        const ILogger& kaaActiveLogger = LoggerFactory::getLogger(); \
+        if (kaaActiveLogger.isLogLevelEnabled(level)) { \
+            kaa_log(kaaActiveLogger, level, (message), __LOGFILE, __LINE__); \
+        } \
+    } while (false);
+
 #endif
 
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_FINE_TRACE
-    #define KAA_LOG_FTRACE(message) kaa_log(LoggerFactory::getLogger(), LogLevel::TRACE,      (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_FTRACE(message) KAA_LOG_IF_ENABLED(LogLevel::TRACE, message)
 #else
     #define KAA_LOG_FTRACE(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_TRACE
-    #define KAA_LOG_TRACE(message)  kaa_log(LoggerFactory::getLogger(), LogLevel::TRACE,      (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_TRACE(message)  KAA_LOG_IF_ENABLED(LogLevel::TRACE, message)
 #else
     #define KAA_LOG_TRACE(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_DEBUG
-    #define KAA_LOG_DEBUG(message)  kaa_log(LoggerFactory::getLogger(), LogLevel::DEBUG,      (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_DEBUG(message)  KAA_LOG_IF_ENABLED(LogLevel::DEBUG, message)
 #else
     #define KAA_LOG_DEBUG(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_INFO
-    #define KAA_LOG_INFO(message)   kaa_log(LoggerFactory::getLogger(), LogLevel::INFO,       (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_INFO(message)   KAA_LOG_IF_ENABLED(LogLevel::INFO, message)
 #else
     #define KAA_LOG_INFO(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_WARNING
-    #define KAA_LOG_WARN(message)   kaa_log(LoggerFactory::getLogger(), LogLevel::WARNING,    (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_WARN(message)   KAA_LOG_IF_ENABLED(LogLevel::WARNING, message)
 #else
     #define KAA_LOG_WARN(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_ERROR
-    #define KAA_LOG_ERROR(message)  kaa_log(LoggerFactory::getLogger(), LogLevel::ERROR,      (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_ERROR(message)  KAA_LOG_IF_ENABLED(LogLevel::ERROR, message)
 #else
     #define KAA_LOG_ERROR(message)
 #endif
 #if KAA_LOG_LEVEL >= KAA_LOG_LEVEL_FATAL
-    #define KAA_LOG_FATAL(message)  kaa_log(LoggerFactory::getLogger(), LogLevel::FATAL,      (message), __LOGFILE, __LINE__);
+    #define KAA_LOG_FATAL(message)  KAA_LOG_IF_ENABLED(LogLevel::FATAL, message)
 #else
     #define KAA_LOG_FATAL(message)
 #endif
@@ -769,7 +769,97 @@ public:
         return result;
     }
 
+    /**
+     * Compact, bounded-size description of a sync request: only section presence,
+     * element counts and payload sizes are printed, never the payload itself.
+     */
+    static std::string SyncRequestSummaryToString(const SyncRequest& request) {
+        std::ostringstream ss;
+        ss << "{requestId: " << request.requestId;
+        if (!request.bootstrapSyncRequest.is_null()) {
+            ss << ", bootstrap: {protocols: " << request.bootstrapSyncRequest.get_BootstrapSyncRequest().supportedProtocols.size() << "}";
+        }
+        if (!request.profileSyncRequest.is_null()) {
+            ss << ", profile: {bodySize: " << request.profileSyncRequest.get_ProfileSyncRequest().profileBody.size() << "}";
+        }
+        if (!request.configurationSyncRequest.is_null()) {
+            ss << ", configuration: {appStateSeqNumber: " << request.configurationSyncRequest.get_ConfigurationSyncRequest().appStateSeqNumber << "}";
+        }
+        if (!request.notificationSyncRequest.is_null()) {
+            const auto& notificationRequest = request.notificationSyncRequest.get_NotificationSyncRequest();
+            ss << ", notification: {topicStates: " << NullableArraySize(notificationRequest.topicStates)
+               << ", accepted: " << NullableArraySize(notificationRequest.acceptedUnicastNotifications)
+               << ", commands: " << NullableArraySize(notificationRequest.subscriptionCommands) << "}";
+        }
+        if (!request.userSyncRequest.is_null()) {
+            const auto& userRequest = request.userSyncRequest.get_UserSyncRequest();
+            ss << ", user: {userAttach: " << (userRequest.userAttachRequest.is_null() ? 0 : 1)
+               << ", attach: " << NullableArraySize(userRequest.endpointAttachRequests)
+               << ", detach: " << NullableArraySize(userRequest.endpointDetachRequests) << "}";
+        }
+        if (!request.eventSyncRequest.is_null()) {
+            const auto& eventRequest = request.eventSyncRequest.get_EventSyncRequest();
+            ss << ", event: {events: " << NullableArraySize(eventRequest.events)
+               << ", listenersRequests: " << NullableArraySize(eventRequest.eventListenersRequests) << "}";
+        }
+        if (!request.logSyncRequest.is_null()) {
+            const auto& logRequest = request.logSyncRequest.get_LogSyncRequest();
+            ss << ", log: {requestId: " << logRequest.requestId << ", entries: " << NullableArraySize(logRequest.logEntries) << "}";
+        }
+        ss << "}";
+        return ss.str();
+    }
+
+    /**
+     * Compact, bounded-size description of a sync response (see @link SyncRequestSummaryToString @endlink).
+     */
+    static std::string SyncResponseSummaryToString(const SyncResponse& response) {
+        std::ostringstream ss;
+        ss << "{requestId: " << response.requestId << ", status: " << SyncResponseResultTypeToString(response.status);
+        if (!response.bootstrapSyncResponse.is_null()) {
+            ss << ", bootstrap: {protocols: " << response.bootstrapSyncResponse.get_BootstrapSyncResponse().supportedProtocols.size() << "}";
+        }
+        if (!response.profileSyncResponse.is_null()) {
+            ss << ", profile: {status: " << SyncResponseStatusToString(response.profileSyncResponse.get_ProfileSyncResponse().responseStatus) << "}";
+        }
+        if (!response.configurationSyncResponse.is_null()) {
+            const auto& configurationResponse = response.configurationSyncResponse.get_ConfigurationSyncResponse();
+            ss << ", configuration: {status: " << SyncResponseStatusToString(configurationResponse.responseStatus)
+               << ", deltaSize: " << (configurationResponse.confDeltaBody.is_null() ? 0 : configurationResponse.confDeltaBody.get_bytes().size()) << "}";
+        }
+        if (!response.notificationSyncResponse.is_null()) {
+            const auto& notificationResponse = response.notificationSyncResponse.get_NotificationSyncResponse();
+            ss << ", notification: {status: " << SyncResponseStatusToString(notificationResponse.responseStatus)
+               << ", topics: " << NullableArraySize(notificationResponse.availableTopics)
+               << ", notifications: " << NullableArraySize(notificationResponse.notifications) << "}";
+        }
+        if (!response.userSyncResponse.is_null()) {
+            const auto& userResponse = response.userSyncResponse.get_UserSyncResponse();
+            ss << ", user: {userAttach: " << (userResponse.userAttachResponse.is_null() ? 0 : 1)
+               << ", attach: " << NullableArraySize(userResponse.endpointAttachResponses)
+               << ", detach: " << NullableArraySize(userResponse.endpointDetachResponses) << "}";
+        }
+        if (!response.eventSyncResponse.is_null()) {
+            const auto& eventResponse = response.eventSyncResponse.get_EventSyncResponse();
+            ss << ", event: {events: " << NullableArraySize(eventResponse.events)
+               << ", listenersResponses: " << NullableArraySize(eventResponse.eventListenersResponses) << "}";
+        }
+        if (!response.logSyncResponse.is_null()) {
+            ss << ", log: {deliveryStatuses: " << NullableArraySize(response.logSyncResponse.get_LogSyncResponse().deliveryStatuses) << "}";
+        }
+        if (!response.redirectSyncResponse.is_null()) {
+            ss << ", redirect: {accessPointId: 0x" << std::hex << response.redirectSyncResponse.get_RedirectSyncResponse().accessPointId << std::dec << "}";
+        }
+        ss << "}";
+        return ss.str();
+    }
+
 private:
+    template <typename NullableArray>
+    static std::size_t NullableArraySize(const NullableArray& array) {
+        return array.is_null() ? 0 : array.get_array().size();
+    }
+
     static std::string EventsToString(const std::vector<Event>& events) {
         std::ostringstream stream;
         stream << "[";
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef METRICSREGISTRY_HPP_
+#define METRICSREGISTRY_HPP_
+
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "kaa/KaaThread.hpp"
+
+namespace kaa {
+
+/**
+ * Monotonically increasing value, e.g. the number of bytes sent.
+ */
+class Counter {
+public:
+    Counter() : value_(0) { }
+
+    void increment(std::uint64_t delta = 1) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    std::uint64_t getValue() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_;
+};
+
+/**
+ * Value which may go up and down, e.g. the number of records in the log storage.
+ */
+class Gauge {
+public:
+    Gauge() : value_(0) { }
+
+    void setValue(std::int64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t delta) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    std::int64_t getValue() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_;
+};
+
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> bounds;
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t              count;
+    std::uint64_t              sum;
+};
+
+/**
+ * Distribution of values over a fixed set of buckets.
+ *
+ * The bucket i counts values less than or equal to bounds[i] (and greater than bounds[i-1]),
+ * the last bucket counts values greater than the last bound.
+ */
+class Histogram {
+public:
+    /**
+     * Bucket bounds (in microseconds) used for latency histograms by default.
+     */
+    static const std::vector<std::uint64_t> DEFAULT_LATENCY_BOUNDS;
+
+    /**
+     * @param bounds Upper bounds of buckets. Must be non-empty and sorted in ascending order.
+     */
+    explicit Histogram(const std::vector<std::uint64_t>& bounds);
+
+    void record(std::uint64_t value);
+
+    HistogramSnapshot getSnapshot() const;
+
+private:
+    const std::vector<std::uint64_t>               bounds_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]>  buckets_;
+    std::atomic<std::uint64_t>                     count_;
+    std::atomic<std::uint64_t>                     sum_;
+};
+
+/**
+ * Records the time elapsed between its construction and destruction (in microseconds)
+ * into the given histogram. Does nothing if the histogram is null.
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram *histogram)
+        : histogram_(histogram), start_(histogram ? clock_t::now() : clock_t::time_point()) { }
+
+    ~ScopedLatency() {
+        if (histogram_) {
+            histogram_->record(std::chrono::duration_cast<std::chrono::microseconds>(clock_t::now() - start_).count());
+        }
+    }
+
+private:
+    typedef std::chrono::steady_clock clock_t;
+
+    Histogram             *histogram_;
+    clock_t::time_point    start_;
+};
+
+struct MetricsSnapshot {
+    std::map<std::string, std::uint64_t>        counters;
+    std::map<std::string, std::int64_t>         gauges;
+    std::map<std::string, HistogramSnapshot>    histograms;
+
+    /**
+     * @return Human-readable, one metric per line representation of the snapshot.
+     */
+    std::string toString() const;
+};
+
+/**
+ * Named runtime metrics of the client.
+ *
+ * Looking up a metric takes a lock, so components resolve the metrics they update
+ * once and keep the returned references, which stay valid for the registry's lifetime.
+ * Updating a metric is lock-free.
+ *
+ * Metrics reported by the SDK components:
+ * <ul>
+ * <li>tcp.* - bytes sent and received, connections, server failures and sync round-trip
+ * time (us) of the Kaa TCP operation channel;</li>
+ * <li>sync.* - number and size of compiled requests and processed responses, time (us)
+ * to compile a request and to process a response;</li>
+ * <li>log.* - added records, upload requests, failures and timeouts, log storage
+ * occupancy (records and bytes);</li>
+ * <li>security.* - time (us) spent encrypting, decrypting, signing and verifying data.</li>
+ * </ul>
+ */
+class MetricsRegistry {
+public:
+    Counter& getCounter(const std::string& name);
+    Gauge& getGauge(const std::string& name);
+
+    /**
+     * Returns the histogram with the given name, creating it with the specified bounds
+     * if it doesn't exist yet. Bounds of an existing histogram aren't changed.
+     */
+    Histogram& getHistogram(const std::string& name,
+                            const std::vector<std::uint64_t>& bounds = Histogram::DEFAULT_LATENCY_BOUNDS);
+
+    /**
+     * @return Current values of all registered metrics.
+     */
+    MetricsSnapshot getSnapshot() const;
+
+private:
+    std::map<std::string, std::unique_ptr<Counter>>      counters_;
+    std::map<std::string, std::unique_ptr<Gauge>>        gauges_;
+    std::map<std::string, std::unique_ptr<Histogram>>    histograms_;
+
+    KAA_MUTEX_MUTABLE_DECLARE(registryGuard_);
+};
+
+}  // namespace kaa
+
+#endif /* METRICSREGISTRY_HPP_ */
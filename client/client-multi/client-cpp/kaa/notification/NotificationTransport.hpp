@@ -18,13 +18,14 @@
 #define DEFAULTNOTIFICATIONTRANSPORT_HPP_
 
 #include <map>
-#include <set>
 #include <string>
+#include <vector>
 
 #include "kaa/channel/transport/IKaaTransport.hpp"
 #include "kaa/channel/transport/INotificationTransport.hpp"
 #include "kaa/channel/transport/AbstractKaaTransport.hpp"
 #include "kaa/IKaaClientStateStorage.hpp"
+#include "kaa/common/BoundedLruSet.hpp"
 #include "kaa/notification/INotificationProcessor.hpp"
 
 namespace kaa {
@@ -35,11 +36,17 @@ class NotificationTransport: public AbstractKaaTransport<TransportType::NOTIFICA
                              public INotificationTransport
 {
 public:
-    NotificationTransport(IKaaClientStateStoragePtr status, IKaaChannelManager& manager)
-        : AbstractKaaTransport(manager), notificationProcessor_(nullptr)
-    {
-        setClientState(status);
-    }
+    /**
+     * Default number of accepted unicast notification uids remembered for deduplication.
+     */
+    static const std::size_t DEFAULT_ACCEPTED_UNICAST_IDS_CAPACITY = 1024;
+
+    /**
+     * Uids of accepted unicast notifications are restored from the client status.
+     * Only the @c acceptedUnicastIdsCapacity most recent ones are kept, older uids are evicted.
+     */
+    NotificationTransport(IKaaClientStateStoragePtr status, IKaaChannelManager& manager,
+                          std::size_t acceptedUnicastIdsCapacity = DEFAULT_ACCEPTED_UNICAST_IDS_CAPACITY);
 
     virtual NotificationSyncRequestPtr createEmptyNotificationRequest();
 
@@ -62,12 +69,21 @@ private:
     Notifications getUnicastNotifications(const Notifications & notifications);
     Notifications getMulticastNotifications(const Notifications & notifications);
 
+    /**
+     * SHA-1 over the topics ordered by id, so the same list yields the same hash in any order.
+     */
+    static HashDigest calculateTopicListHash(std::vector<Topic> topics);
+    void setTopicListHash(NotificationSyncRequest& request);
+
+    void saveAcceptedUnicastNotificationIds();
+
 private:
     INotificationProcessor*   notificationProcessor_;
 
-    std::set<std::string>                    acceptedUnicastNotificationIds_;
+    BoundedLruSet<std::string>               acceptedUnicastNotificationIds_;
     std::map<std::string, std::int32_t>    notificationSubscriptions_;
     SubscriptionCommands                     subscriptions_;
+    HashDigest                               topicListHash_;
 };
 
 } /* namespace kaa */
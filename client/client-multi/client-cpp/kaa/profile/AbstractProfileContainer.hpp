@@ -31,7 +31,7 @@ namespace kaa {
 template<typename T>
 class AbstractProfileContainer : public IProfileContainer {
 public:
-    AbstractProfileContainer() {}
+    AbstractProfileContainer() : revision_(nextProfileRevision()) {}
     virtual ~AbstractProfileContainer() {}
 
     /**
@@ -45,6 +45,17 @@ public:
     }
 
 
+    /**
+     * Retrieves the profile revision. A new one is taken on construction and on each
+     * @link updateProfile() @endlink call.
+     * @see IProfileContainer
+     *
+     * @return Profile revision.
+     */
+    virtual std::uint64_t getProfileRevision() {
+        return revision_;
+    }
+
     /**
      * Sets new profile listener.
      * DO NOT use this API explicitly.
@@ -70,6 +81,7 @@ protected:
      * Updates profile. Call this method when you finish to update your profile.
      */
     void updateProfile() {
+        revision_ = nextProfileRevision();
         if (profileListener_) {
             profileListener_->onProfileUpdated(getSerializedProfile());
         }
@@ -78,6 +90,7 @@ protected:
 private:
     AvroByteArrayConverter<T>   avroConverter_;
     ProfileListenerPtr          profileListener_;
+    std::atomic<std::uint64_t>  revision_;
 };
 
 } /* namespace kaa */
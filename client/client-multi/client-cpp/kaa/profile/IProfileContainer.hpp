@@ -17,6 +17,9 @@
 #ifndef IPROFILECONTAINER_HPP_
 #define IPROFILECONTAINER_HPP_
 
+#include <atomic>
+#include <cstdint>
+
 #include "kaa/profile/IProfileListener.hpp"
 #include "kaa/common/EndpointObjectHash.hpp"
 
@@ -40,6 +43,16 @@ public:
      */
     virtual SharedDataBuffer getSerializedProfile() = 0;
 
+    /**
+     * Retrieves revision of the profile. The revision must change each time the profile
+     * is updated, so Kaa serializes and hashes the profile only when its revision differs
+     * from the previously synced one.
+     *
+     * @return profile revision or @link UNKNOWN_REVISION @endlink if the container doesn't
+     * track revisions, in which case the profile is serialized on every sync
+     */
+    virtual std::uint64_t getProfileRevision() { return UNKNOWN_REVISION; }
+
     /**
      * Set Kaa profile listener @link IProfileListener @endlink for the container.
      * DO NOT use this API explicitly. When user sets his implementation
@@ -51,6 +64,16 @@ public:
     virtual void setProfileListener(ProfileListenerPtr listener) = 0;
 
     virtual ~IProfileContainer() {}
+
+    static const std::uint64_t UNKNOWN_REVISION = 0;
+
+    /**
+     * Generates a new profile revision, unique among all containers in the process.
+     */
+    static std::uint64_t nextProfileRevision() {
+        static std::atomic<std::uint64_t> revision(UNKNOWN_REVISION);
+        return ++revision;
+    }
 };
 
 } /* namespace kaa */
@@ -18,6 +18,7 @@
 #define ISERIALIZEDPROFILECONTAINER_HPP_
 
 #include <memory>
+#include <cstdint>
 
 #include "kaa/common/EndpointObjectHash.hpp"
 
@@ -37,6 +38,12 @@ public:
      */
     virtual SharedDataBuffer getSerializedProfile() = 0;
 
+    /**
+     * Retrieves revision of the profile
+     * @see IProfileContainer::getProfileRevision()
+     */
+    virtual std::uint64_t getProfileRevision() = 0;
+
     virtual ~ISerializedProfileContainer() {}
 };
 
@@ -56,6 +56,7 @@ private:
 private:
     IProfileManager*               profileManager_;
     std::vector<std::uint8_t>      publicKey_;
+    std::uint64_t                  lastProfileRevision_;
 };
 
 } /* namespace kaa */
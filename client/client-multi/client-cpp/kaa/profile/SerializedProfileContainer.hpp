@@ -34,6 +34,15 @@ public:
      */
     virtual SharedDataBuffer getSerializedProfile();
 
+    /**
+     * Retrieves revision of the user-defined profile
+     * @see IProfileContainer::getProfileRevision()
+     */
+    virtual std::uint64_t getProfileRevision()
+    {
+        return profileContainer_ ? profileContainer_->getProfileRevision() : IProfileContainer::UNKNOWN_REVISION;
+    }
+
     /**
      * Set user-defined profile container
      * @param container user-defined profile container
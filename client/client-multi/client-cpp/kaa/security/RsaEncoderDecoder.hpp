@@ -25,11 +25,15 @@
 
 namespace kaa {
 
+class Histogram;
+class MetricsRegistry;
+
 class RsaEncoderDecoder : public IEncoderDecoder {
 public:
     RsaEncoderDecoder(const PublicKey& pubKey,
                       const PrivateKey& privKey,
-                      const PublicKey& remoteKey);
+                      const PublicKey& remoteKey,
+                      MetricsRegistry *metrics = nullptr);
     ~RsaEncoderDecoder() { }
 
     virtual EncodedSessionKey getEncodedSessionKey();
@@ -48,6 +52,11 @@ private:
     std::unique_ptr<Botan::X509_PublicKey>   remoteKey_;
 
     SessionKey sessionKey_;
+
+    Histogram *encodeLatency_;
+    Histogram *decodeLatency_;
+    Histogram *signLatency_;
+    Histogram *verifyLatency_;
 };
 
 }
@@ -14,60 +14,126 @@
  * limitations under the License.
  */
 
+
 #ifndef ABSTRACTTRANSACTABLE_HPP_
 #define ABSTRACTTRANSACTABLE_HPP_
 
-#include <map>
+#include <array>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+
 #include "kaa/KaaThread.hpp"
 #include "kaa/logging/Log.hpp"
 #include "kaa/transact/ITransactable.hpp"
 
 namespace kaa {
 
-template<class Container>
+/**
+ * Keeps open transactions in lock-sharded tables indexed by @link TransactionId::getNumericId() @endlink.
+ *
+ * Each transaction owns its container and a mutex, so items are appended to different
+ * transactions in parallel. A shard lock is held only while a transaction is looked up,
+ * added or removed.
+ */
+template<class Container, std::size_t ShardsCount = 16>
 class AbstractTransactable : public ITransactable {
 public:
     virtual TransactionIdPtr beginTransaction() {
         TransactionIdPtr trxId(new TransactionId);
-        KAA_MUTEX_LOCKING("transactionsGuard_")
-        KAA_MUTEX_UNIQUE_DECLARE(transactionsLock, transactionsGuard_);
-        KAA_MUTEX_LOCKED("transactionsGuard_")
+        Shard& shard = getShard(*trxId);
+
+        KAA_MUTEX_LOCKING("shard.guard_")
+        KAA_MUTEX_UNIQUE_DECLARE(shardLock, shard.guard_);
+        KAA_MUTEX_LOCKED("shard.guard_")
 
-        transactions_.insert(std::make_pair(trxId, Container()));
+        shard.transactions_.insert(std::make_pair(trxId->getNumericId(), std::make_shared<Transaction>()));
 
         return trxId;
     }
 
     virtual void rollback(TransactionIdPtr trxId) {
-        KAA_MUTEX_LOCKING("transactionsGuard_")
-        KAA_MUTEX_UNIQUE_DECLARE(transactionsLock, transactionsGuard_);
-        KAA_MUTEX_LOCKED("transactionsGuard_")
+        Container discarded;
+        releaseTransaction(trxId, discarded);
+    }
+
+    virtual ~AbstractTransactable() {}
+
+protected:
+    /**
+     * Appends an item to the transaction container, creating the transaction if it wasn't found.
+     */
+    template<typename Item>
+    void addToTransaction(TransactionIdPtr trxId, Item&& item) {
+        std::shared_ptr<Transaction> transaction = getTransaction(*trxId);
+
+        KAA_MUTEX_UNIQUE_DECLARE(transactionLock, transaction->guard_);
+        transaction->container_.push_back(std::forward<Item>(item));
+    }
 
-        auto it = transactions_.find(trxId);
-        if (it != transactions_.end()) {
-            transactions_.erase(it);
+    /**
+     * Removes the transaction and moves its container out.
+     *
+     * @return false if the transaction wasn't found.
+     */
+    bool releaseTransaction(TransactionIdPtr trxId, Container& container) {
+        std::shared_ptr<Transaction> transaction;
+        Shard& shard = getShard(*trxId);
+
+        KAA_MUTEX_LOCKING("shard.guard_")
+        KAA_MUTEX_UNIQUE_DECLARE(shardLock, shard.guard_);
+        KAA_MUTEX_LOCKED("shard.guard_")
+
+        auto it = shard.transactions_.find(trxId->getNumericId());
+        if (it == shard.transactions_.end()) {
+            return false;
         }
+
+        transaction = std::move(it->second);
+        shard.transactions_.erase(it);
+
+        KAA_MUTEX_UNLOCKING("shard.guard_")
+        KAA_UNLOCK(shardLock);
+        KAA_MUTEX_UNLOCKED("shard.guard_")
+
+        KAA_MUTEX_UNIQUE_DECLARE(transactionLock, transaction->guard_);
+        container = std::move(transaction->container_);
+        return true;
     }
 
-    Container & getContainerByTrxId(TransactionIdPtr trxId) {
-        KAA_MUTEX_LOCKING("transactionsGuard_")
-        KAA_MUTEX_UNIQUE_DECLARE(transactionsLock, transactionsGuard_);
-        KAA_MUTEX_LOCKED("transactionsGuard_")
+private:
+    struct Transaction {
+        Container container_;
+        KAA_MUTEX_DECLARE(guard_);
+    };
 
-        auto it = transactions_.find(trxId);
+    struct Shard {
+        std::unordered_map<std::uint64_t, std::shared_ptr<Transaction> > transactions_;
+        KAA_MUTEX_DECLARE(guard_);
+    };
 
-        if (it != transactions_.end()) {
-            return it->second;
-        } else {
-            KAA_LOG_DEBUG(boost::format("Transaction with id %1% was not found. Creating new instance") % trxId->getId());
-            return transactions_[trxId];
+    Shard& getShard(const TransactionId& trxId) {
+        return shards_[trxId.getNumericId() % ShardsCount];
+    }
+
+    std::shared_ptr<Transaction> getTransaction(TransactionId& trxId) {
+        Shard& shard = getShard(trxId);
+
+        KAA_MUTEX_LOCKING("shard.guard_")
+        KAA_MUTEX_UNIQUE_DECLARE(shardLock, shard.guard_);
+        KAA_MUTEX_LOCKED("shard.guard_")
+
+        std::shared_ptr<Transaction>& transaction = shard.transactions_[trxId.getNumericId()];
+        if (!transaction) {
+            KAA_LOG_DEBUG(boost::format("Transaction with id %1% was not found. Creating new instance") % trxId.getId());
+            transaction = std::make_shared<Transaction>();
         }
+        return transaction;
     }
 
-    virtual ~AbstractTransactable() {}
-protected:
-    std::map<TransactionIdPtr, Container> transactions_;
-    KAA_MUTEX_DECLARE(transactionsGuard_);
+private:
+    std::array<Shard, ShardsCount> shards_;
 };
 
 }
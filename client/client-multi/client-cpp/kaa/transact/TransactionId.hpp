@@ -18,8 +18,10 @@
 #define TRANSACTIONID_HPP_
 
 #include "kaa/common/UuidGenerator.hpp"
+#include <atomic>
 #include <string>
 #include <memory>
+#include <cstdint>
 
 namespace kaa {
 
@@ -38,19 +40,19 @@ public:
      * <br>
      * Generates random id object.
      */
-    TransactionId() : id_(UuidGenerator::generateUuid()) {}
+    TransactionId() : id_(UuidGenerator::generateUuid()), numericId_(nextNumericId()) {}
 
     /**
      * Copy constructor<br>
      * <br>
      * Copies TransactionId object.
      */
-    TransactionId(const TransactionId & trxId) : id_(trxId.id_) {}
+    TransactionId(const TransactionId & trxId) : id_(trxId.id_), numericId_(trxId.numericId_) {}
 
     /**
      * Constructs object from string value.
      */
-    TransactionId(const std::string & id) {
+    TransactionId(const std::string & id) : numericId_(nextNumericId()) {
         this->id_ = id;
     }
 
@@ -61,8 +63,22 @@ public:
         return this->id_;
     }
 
+    /**
+     * Get process-wide unique integer id, used for fast transaction lookups.
+     */
+    std::uint64_t getNumericId() const {
+        return numericId_;
+    }
+
+private:
+    static std::uint64_t nextNumericId() {
+        static std::atomic<std::uint64_t> counter(0);
+        return ++counter;
+    }
+
 private:
     std::string id_;
+    std::uint64_t numericId_;
 };
 
 typedef std::shared_ptr<TransactionId> TransactionIdPtr;
@@ -73,6 +73,14 @@ public:
 
     virtual void setAttachedEndpoints(const AttachedEndpoints&) {}
 
+    virtual AcceptedUnicastNotificationIds getAcceptedUnicastNotificationIds() const {
+        return acceptedUnicastNotificationIds_;
+    }
+
+    virtual void setAcceptedUnicastNotificationIds(const AcceptedUnicastNotificationIds& ids) {
+        acceptedUnicastNotificationIds_ = ids;
+    }
+
     virtual std::string getEndpointAccessToken() {
         static std::string token("token");
         return token;
@@ -102,6 +110,9 @@ public:
 
     virtual void read() {}
     virtual void save() {}
+
+private:
+    AcceptedUnicastNotificationIds acceptedUnicastNotificationIds_;
 };
 
 }
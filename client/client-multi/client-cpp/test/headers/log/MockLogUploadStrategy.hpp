@@ -17,6 +17,7 @@
 #ifndef MOCKLOGUPLOADSTRATEGY_HPP_
 #define MOCKLOGUPLOADSTRATEGY_HPP_
 
+#include <atomic>
 #include <cstdint>
 
 #include "kaa/log/ILogUploadStrategy.hpp"
@@ -36,11 +37,11 @@ public:
     std::size_t batchSize_ = 0;
     std::size_t timeout_ = 0;
 
-    std::size_t onIsUploadNeeded_ = 0;
-    std::size_t onGetBatchSize_ = 0;
-    std::size_t onGetTimeout_ = 0;
-    std::size_t onTimeout_ = 0;
-    std::size_t onFailure_ = 0;
+    std::atomic<std::size_t> onIsUploadNeeded_{0};
+    std::atomic<std::size_t> onGetBatchSize_{0};
+    std::atomic<std::size_t> onGetTimeout_{0};
+    std::atomic<std::size_t> onTimeout_{0};
+    std::atomic<std::size_t> onFailure_{0};
 };
 
 } /* namespace kaa */
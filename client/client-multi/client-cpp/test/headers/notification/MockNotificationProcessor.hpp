@@ -0,0 +1,42 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MOCKNOTIFICATIONPROCESSOR_HPP_
+#define MOCKNOTIFICATIONPROCESSOR_HPP_
+
+#include <cstdint>
+
+#include "kaa/notification/INotificationProcessor.hpp"
+
+namespace kaa {
+
+class MockNotificationProcessor: public INotificationProcessor {
+public:
+    virtual void topicsListUpdated(const Topics& topics) { ++onTopicsListUpdated_; topics_ = topics; }
+    virtual void notificationReceived(const Notifications& notifications) { ++onNotificationReceived_; notifications_ = notifications; }
+
+public:
+    Topics topics_;
+    Notifications notifications_;
+
+    std::size_t onTopicsListUpdated_ = 0;
+    std::size_t onNotificationReceived_ = 0;
+};
+
+} /* namespace kaa */
+
+#endif /* MOCKNOTIFICATIONPROCESSOR_HPP_ */
@@ -51,6 +51,7 @@ BOOST_AUTO_TEST_CASE(checkDefaults)
     BOOST_CHECK_EQUAL(cs.getAttachedEndpoints().size(), 0);
     BOOST_CHECK_EQUAL(cs.getEndpointAccessToken().empty(), true);
     BOOST_CHECK_EQUAL(cs.getEndpointAttachStatus(), false);
+    BOOST_CHECK(cs.getAcceptedUnicastNotificationIds().empty());
 
     cleanfile();
 }
@@ -122,6 +123,9 @@ BOOST_AUTO_TEST_CASE(checkSetAndSaveParameters)
     std::string endpointKeyHash = "thisEndpointKeyHash";
     cs.setEndpointKeyHash(endpointKeyHash);
 
+    AcceptedUnicastNotificationIds acceptedUids = {"uid1", "[uid,2]"};
+    cs.setAcceptedUnicastNotificationIds(acceptedUids);
+
     cs.save();
     ClientStatus cs_restored(filename);
 
@@ -147,6 +151,9 @@ BOOST_AUTO_TEST_CASE(checkSetAndSaveParameters)
     BOOST_CHECK_EQUAL(cs_restored.getEndpointAttachStatus(), isAttached);
     BOOST_CHECK_EQUAL(cs_restored.getEndpointKeyHash(), endpointKeyHash);
 
+    AcceptedUnicastNotificationIds restoredUids = cs_restored.getAcceptedUnicastNotificationIds();
+    BOOST_CHECK_EQUAL_COLLECTIONS(restoredUids.begin(), restoredUids.end(), acceptedUids.begin(), acceptedUids.end());
+
     cleanfile();
 }
 
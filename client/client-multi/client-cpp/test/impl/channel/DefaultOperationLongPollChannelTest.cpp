@@ -0,0 +1,262 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "kaa/channel/impl/DefaultOperationLongPollChannel.hpp"
+#include "kaa/channel/IKaaDataMultiplexer.hpp"
+#include "kaa/channel/IKaaDataDemultiplexer.hpp"
+#include "kaa/channel/TransportProtocolIdConstants.hpp"
+#include "kaa/security/KeyUtils.hpp"
+
+#include "headers/channel/MockChannelManager.hpp"
+
+namespace kaa {
+
+std::vector<uint8_t> serializeConnectionInfo(const std::string& publicKey
+                                           , const std::string& host
+                                           , const std::int32_t& port);
+
+ITransportConnectionInfoPtr createTransportConnectionInfo(ServerType type
+                                                        , const std::int32_t& accessPointId
+                                                        , TransportProtocolId protocolId
+                                                        , const std::vector<uint8_t>& connectionData);
+
+/**
+ * Resets long poll requests at once and keeps sync requests unanswered until they are dropped.
+ */
+class SyncParkingServer {
+public:
+    SyncParkingServer()
+        : acceptor_(io_, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)), parkedSyncCount_(0)
+    {
+        accept();
+        thread_ = std::thread([this] () { io_.run(); });
+    }
+
+    ~SyncParkingServer()
+    {
+        io_.stop();
+        thread_.join();
+    }
+
+    std::uint16_t getPort() const { return acceptor_.local_endpoint().port(); }
+
+    std::size_t getParkedSyncCount() const { return parkedSyncCount_; }
+
+    void dropParkedSyncs()
+    {
+        io_.post([this] ()
+            {
+                for (auto& connection : parkedSyncs_) {
+                    reset(connection->socket_);
+                }
+                parkedSyncs_.clear();
+                parkedSyncCount_ = 0;
+            });
+    }
+
+private:
+    struct Connection {
+        Connection(boost::asio::io_service& io) : socket_(io) {}
+
+        boost::asio::ip::tcp::socket socket_;
+        boost::asio::streambuf request_;
+    };
+
+    void accept()
+    {
+        auto connection = std::make_shared<Connection>(io_);
+        acceptor_.async_accept(connection->socket_, [this, connection] (const boost::system::error_code& code)
+            {
+                if (code) {
+                    return;
+                }
+
+                boost::asio::async_read_until(connection->socket_, connection->request_, "\r\n",
+                        [this, connection] (const boost::system::error_code& code, std::size_t)
+                        {
+                            std::istream stream(&connection->request_);
+                            std::string requestLine;
+                            std::getline(stream, requestLine);
+
+                            if (!code && requestLine.find("/EP/Sync ") != std::string::npos) {
+                                parkedSyncs_.push_back(connection);
+                                ++parkedSyncCount_;
+                            } else {
+                                reset(connection->socket_);
+                            }
+                        });
+                accept();
+            });
+    }
+
+    static void reset(boost::asio::ip::tcp::socket& socket)
+    {
+        boost::system::error_code code;
+        socket.set_option(boost::asio::socket_base::linger(true, 0), code);
+        socket.close(code);
+    }
+
+private:
+    boost::asio::io_service io_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::thread thread_;
+
+    std::vector<std::shared_ptr<Connection>> parkedSyncs_;
+    std::atomic<std::size_t> parkedSyncCount_;
+};
+
+class SyncRecordingMultiplexer : public IKaaDataMultiplexer {
+public:
+    virtual std::vector<std::uint8_t> compileRequest(const std::map<TransportType, ChannelDirection>& transportTypes)
+    {
+        // Long poll requests carry all supported types including the down-only EVENT one
+        if (!transportTypes.count(TransportType::EVENT)) {
+            std::lock_guard<std::mutex> lock(guard_);
+            std::set<TransportType> types;
+            for (const auto& type : transportTypes) {
+                types.insert(type.first);
+            }
+            syncRequests_.push_back(types);
+        }
+        return std::vector<std::uint8_t>();
+    }
+
+    std::vector<std::set<TransportType>> getSyncRequests()
+    {
+        std::lock_guard<std::mutex> lock(guard_);
+        return syncRequests_;
+    }
+
+private:
+    std::mutex guard_;
+    std::vector<std::set<TransportType>> syncRequests_;
+};
+
+class NullDemultiplexer : public IKaaDataDemultiplexer {
+public:
+    virtual void processResponse(const std::vector<std::uint8_t> &response) {}
+};
+
+/**
+ * Server failures are reported from both the poll and the sync threads.
+ */
+class FailureCountingChannelManager : public MockChannelManager {
+public:
+    virtual void onServerFailed(ITransportConnectionInfoPtr server) { ++serverFailures_; }
+
+    std::atomic<std::size_t> serverFailures_{0};
+};
+
+template <typename Predicate>
+static bool waitFor(Predicate predicate)
+{
+    for (std::size_t i = 0; i < 100 && !predicate(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return predicate();
+}
+
+static ITransportConnectionInfoPtr createServer(const KeyPair& keys, std::uint16_t port)
+{
+    const auto& publicKey = keys.getPublicKey();
+    return createTransportConnectionInfo(ServerType::OPERATIONS
+                                       , 0x111
+                                       , TransportProtocolIdConstants::HTTP_TRANSPORT_ID
+                                       , serializeConnectionInfo(std::string(publicKey.begin(), publicKey.end())
+                                                               , "127.0.0.1"
+                                                               , port));
+}
+
+BOOST_AUTO_TEST_SUITE(DefaultOperationLongPollChannelTestSuite)
+
+BOOST_AUTO_TEST_CASE(SyncTypesCoalescingTest)
+{
+    SyncParkingServer server;
+    SyncRecordingMultiplexer multiplexer;
+    NullDemultiplexer demultiplexer;
+    FailureCountingChannelManager channelManager;
+    KeyPair keys = KeyUtils().generateKeyPair(2048);
+
+    DefaultOperationLongPollChannel channel(&channelManager, keys);
+    channel.setMultiplexer(&multiplexer);
+    channel.setDemultiplexer(&demultiplexer);
+    channel.setServer(createServer(keys, server.getPort()));
+
+    channel.sync(TransportType::PROFILE);
+    BOOST_REQUIRE(waitFor([&server] () { return server.getParkedSyncCount() == 1; }));
+
+    // Requested while the first sync is in flight, so both are sent with one request
+    channel.sync(TransportType::CONFIGURATION);
+    channel.sync(TransportType::NOTIFICATION);
+    BOOST_CHECK_EQUAL(multiplexer.getSyncRequests().size(), 1);
+
+    // The failed sync is retried along with the pending ones
+    server.dropParkedSyncs();
+    BOOST_REQUIRE(waitFor([&multiplexer] () { return multiplexer.getSyncRequests().size() == 2; }));
+
+    const auto& syncRequests = multiplexer.getSyncRequests();
+    BOOST_CHECK(syncRequests[0] == std::set<TransportType>({ TransportType::PROFILE }));
+    BOOST_CHECK(syncRequests[1] == std::set<TransportType>({ TransportType::PROFILE
+                                                           , TransportType::CONFIGURATION
+                                                           , TransportType::NOTIFICATION }));
+}
+
+BOOST_AUTO_TEST_CASE(PendingSyncTypesOnPauseResumeTest)
+{
+    SyncParkingServer server;
+    SyncRecordingMultiplexer multiplexer;
+    NullDemultiplexer demultiplexer;
+    FailureCountingChannelManager channelManager;
+    KeyPair keys = KeyUtils().generateKeyPair(2048);
+
+    DefaultOperationLongPollChannel channel(&channelManager, keys);
+    channel.setMultiplexer(&multiplexer);
+    channel.setDemultiplexer(&demultiplexer);
+    channel.setServer(createServer(keys, server.getPort()));
+
+    channel.sync(TransportType::PROFILE);
+    BOOST_REQUIRE(waitFor([&server] () { return server.getParkedSyncCount() == 1; }));
+
+    channel.sync(TransportType::CONFIGURATION);
+    channel.pause();
+
+    // Neither the aborted sync nor the queued one are sent while the channel is paused
+    server.dropParkedSyncs();
+    BOOST_REQUIRE(waitFor([&server] () { return server.getParkedSyncCount() == 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    BOOST_CHECK_EQUAL(multiplexer.getSyncRequests().size(), 1);
+
+    channel.resume();
+    BOOST_REQUIRE(waitFor([&multiplexer] () { return multiplexer.getSyncRequests().size() == 2; }));
+    BOOST_CHECK(multiplexer.getSyncRequests()[1] == std::set<TransportType>({ TransportType::PROFILE
+                                                                             , TransportType::CONFIGURATION }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
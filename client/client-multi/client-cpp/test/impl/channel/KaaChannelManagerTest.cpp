@@ -559,6 +559,40 @@ BOOST_AUTO_TEST_CASE(ResumetTest)
 }
 
 
+BOOST_AUTO_TEST_CASE(ConnectivityChangeTest)
+{
+    std::unique_ptr<ConfLogDataChannel> userCh1(new ConfLogDataChannel);
+
+    MockBootstrapManager BootstrapManager;
+    KaaChannelManager channelManager(BootstrapManager, getBootstrapServers());
+
+    std::size_t connectivityChangeCount = 0;
+    channelManager.registerConnectivityChangeReceiver([&connectivityChangeCount] () { ++connectivityChangeCount; });
+
+    userCh1->id_ = "id1";
+    userCh1->protocolId_ = TransportProtocolIdConstants::HTTP_TRANSPORT_ID;
+    userCh1->serverType_ = ServerType::OPERATIONS;
+
+    channelManager.addChannel(userCh1.get());
+
+    channelManager.onTransportConnectionInfoUpdated(
+            createTransportConnectionInfo(ServerType::BOOTSTRAP, 0x111, TransportProtocolIdConstants::HTTP_TRANSPORT_ID,
+                                          serializeConnectionInfo("key", "host", 9888)));
+    BOOST_CHECK_EQUAL(connectivityChangeCount, 0);
+
+    channelManager.onTransportConnectionInfoUpdated(
+            createTransportConnectionInfo(ServerType::OPERATIONS, 0x112, TransportProtocolIdConstants::HTTP_TRANSPORT_ID,
+                                          serializeConnectionInfo("key", "host", 9889)));
+    BOOST_CHECK_EQUAL(connectivityChangeCount, 1);
+
+    channelManager.resume();
+    BOOST_CHECK_EQUAL(connectivityChangeCount, 1);
+
+    channelManager.pause();
+    channelManager.resume();
+    BOOST_CHECK_EQUAL(connectivityChangeCount, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include "kaa/common/BoundedLruSet.hpp"
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+BOOST_AUTO_TEST_SUITE(BoundedLruSetSuite)
+
+BOOST_AUTO_TEST_CASE(ZeroCapacityTest)
+{
+    BOOST_CHECK_THROW(BoundedLruSet<std::string> set(0), KaaException);
+}
+
+BOOST_AUTO_TEST_CASE(InsertTest)
+{
+    BoundedLruSet<std::string> set(3);
+
+    BOOST_CHECK(set.empty());
+    BOOST_CHECK(set.insert("a"));
+    BOOST_CHECK(set.insert("b"));
+    BOOST_CHECK(!set.insert("a"));
+
+    BOOST_CHECK_EQUAL(set.size(), 2);
+    BOOST_CHECK(set.contains("a"));
+    BOOST_CHECK(set.contains("b"));
+    BOOST_CHECK(!set.contains("c"));
+
+    set.clear();
+
+    BOOST_CHECK(set.empty());
+    BOOST_CHECK(!set.contains("a"));
+}
+
+BOOST_AUTO_TEST_CASE(EvictionTest)
+{
+    BoundedLruSet<std::string> set(3);
+
+    set.insert("a");
+    set.insert("b");
+    set.insert("c");
+
+    /* Refreshing "a" makes "b" the oldest value. */
+    BOOST_CHECK(!set.insert("a"));
+    BOOST_CHECK(set.insert("d"));
+
+    BOOST_CHECK_EQUAL(set.size(), set.getCapacity());
+    BOOST_CHECK(!set.contains("b"));
+
+    std::vector<std::string> expected = {"c", "a", "d"};
+    std::vector<std::string> actual(set.begin(), set.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "kaa/common/LzfCodec.hpp"
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+static void checkRoundTrip(const std::vector<std::uint8_t>& raw)
+{
+    std::vector<std::uint8_t> compressed;
+    LzfCodec::compress(raw.data(), raw.size(), compressed);
+
+    BOOST_CHECK(LzfCodec::decompress(compressed.data(), compressed.size(), raw.size()) == raw);
+}
+
+BOOST_AUTO_TEST_SUITE(LzfCodecSuite)
+
+BOOST_AUTO_TEST_CASE(EmptyDataTest)
+{
+    std::vector<std::uint8_t> compressed;
+    LzfCodec::compress(nullptr, 0, compressed);
+
+    BOOST_CHECK(compressed.empty());
+    BOOST_CHECK(LzfCodec::decompress(compressed.data(), compressed.size(), 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripTest)
+{
+    std::string text("test data");
+    checkRoundTrip(std::vector<std::uint8_t>(text.begin(), text.end()));
+
+    // Literal runs longer than the maximum run length
+    std::vector<std::uint8_t> incompressible;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        incompressible.push_back((i * 7919 + i / 13) & 0xFF);
+    }
+    checkRoundTrip(incompressible);
+
+    // Back references longer than the maximum match length, both short and long encoded
+    checkRoundTrip(std::vector<std::uint8_t>(1000, 'a'));
+
+    // Repeats farther than the maximum back reference distance
+    std::vector<std::uint8_t> repeated;
+    for (std::size_t i = 0; i < 3; ++i) {
+        repeated.insert(repeated.end(), incompressible.begin(), incompressible.end());
+        repeated.insert(repeated.end(), 10000, static_cast<std::uint8_t>(i));
+    }
+    checkRoundTrip(repeated);
+}
+
+BOOST_AUTO_TEST_CASE(CompressionTest)
+{
+    std::vector<std::uint8_t> raw;
+    for (std::size_t i = 0; i < 100; ++i) {
+        std::string record("test data #" + std::to_string(i));
+        raw.insert(raw.end(), record.begin(), record.end());
+    }
+
+    std::vector<std::uint8_t> compressed(3, 0xFF);
+    LzfCodec::compress(raw.data(), raw.size(), compressed);
+
+    BOOST_CHECK(compressed[0] == 0xFF && compressed[1] == 0xFF && compressed[2] == 0xFF);
+    BOOST_CHECK_LT(compressed.size() - 3, raw.size());
+    BOOST_CHECK(LzfCodec::decompress(compressed.data() + 3, compressed.size() - 3, raw.size()) == raw);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptedStreamTest)
+{
+    // Literal run past the end of the stream
+    const std::uint8_t truncatedLiteral[] = { 0x05, 'a' };
+    BOOST_CHECK_THROW(LzfCodec::decompress(truncatedLiteral, sizeof(truncatedLiteral), 6), KaaException);
+
+    // Back references without their length or distance bytes
+    const std::uint8_t truncatedLongReference[] = { 0x00, 'a', 0xE0 };
+    BOOST_CHECK_THROW(LzfCodec::decompress(truncatedLongReference, sizeof(truncatedLongReference), 20), KaaException);
+
+    const std::uint8_t truncatedReference[] = { 0x00, 'a', 0x20 };
+    BOOST_CHECK_THROW(LzfCodec::decompress(truncatedReference, sizeof(truncatedReference), 4), KaaException);
+
+    // Back reference before the start of the output
+    const std::uint8_t farReference[] = { 0x00, 'a', 0x20, 0x05 };
+    BOOST_CHECK_THROW(LzfCodec::decompress(farReference, sizeof(farReference), 4), KaaException);
+
+    // Valid stream producing a different amount of data
+    std::string text("test data");
+    std::vector<std::uint8_t> compressed;
+    LzfCodec::compress(reinterpret_cast<const std::uint8_t *>(text.data()), text.size(), compressed);
+
+    BOOST_CHECK_THROW(LzfCodec::decompress(compressed.data(), compressed.size(), text.size() - 1), KaaException);
+    BOOST_CHECK_THROW(LzfCodec::decompress(compressed.data(), compressed.size(), text.size() + 1), KaaException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -17,6 +17,11 @@
 
 #include "kaa/configuration/storage/FileConfigurationStorage.hpp"
 
+#include <cstdio>
+#include <fstream>
+
+#include <utime.h>
+
 #include <boost/test/unit_test.hpp>
 
 namespace kaa {
@@ -36,6 +41,88 @@ BOOST_AUTO_TEST_CASE(fileStorageTest)
     BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), testData, testData + 4);
 }
 
+BOOST_AUTO_TEST_CASE(storedHashTest)
+{
+    const std::string filename("configuration_hash.bin");
+    const std::vector<std::uint8_t> testData = { 't', 'e', 's', 't' };
+    const std::vector<std::uint8_t> updatedData = { 'u', 'p', 'd', 'a', 't', 'e', 'd' };
+
+    {
+        FileConfigurationStorage storage(filename);
+        storage.saveConfiguration(std::vector<std::uint8_t>(testData));
+    }
+
+    FileConfigurationStorage storage(filename);
+    BOOST_CHECK(storage.getConfigurationHash() == EndpointObjectHash(testData.data(), testData.size()).getHashDigest());
+
+    storage.saveConfiguration(std::vector<std::uint8_t>(updatedData));
+    BOOST_CHECK(storage.getConfigurationHash() == EndpointObjectHash(updatedData.data(), updatedData.size()).getHashDigest());
+
+    auto result = storage.loadConfiguration();
+    BOOST_CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), updatedData.begin(), updatedData.end());
+    BOOST_CHECK(!std::ifstream(filename + ".tmp").good());
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".sha1").c_str());
+}
+
+BOOST_AUTO_TEST_CASE(staleHashTest)
+{
+    const std::string filename("configuration_stale.bin");
+    const std::uint8_t testData[] = { 't', 'e', 's', 't' };
+
+    {
+        FileConfigurationStorage storage(filename);
+        storage.saveConfiguration(std::vector<std::uint8_t>(testData, testData + 4));
+    }
+
+    /* Data replaced behind the storage back: stored hash doesn't match its size anymore. */
+    std::ofstream(filename, std::ofstream::binary) << "changed data";
+
+    {
+        FileConfigurationStorage storage(filename);
+        BOOST_CHECK(storage.getConfigurationHash().empty());
+    }
+
+    {
+        FileConfigurationStorage storage(filename);
+        storage.saveConfiguration(std::vector<std::uint8_t>(testData, testData + 4));
+    }
+
+    /* Same size data replaced behind the storage back: only the modification time differs. */
+    std::ofstream(filename, std::ofstream::binary) << "tset";
+    struct utimbuf times = { 0, 0 };
+    utime(filename.c_str(), &times);
+
+    FileConfigurationStorage storage(filename);
+    BOOST_CHECK(storage.getConfigurationHash().empty());
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".sha1").c_str());
+}
+
+BOOST_AUTO_TEST_CASE(malformedHashTest)
+{
+    const std::string filename("configuration_malformed.bin");
+    const std::uint8_t testData[] = { 't', 'e', 's', 't' };
+
+    {
+        FileConfigurationStorage storage(filename);
+        storage.saveConfiguration(std::vector<std::uint8_t>(testData, testData + 4));
+    }
+
+    std::string size;
+    std::string modificationTime;
+    std::ifstream(filename + ".sha1") >> size >> modificationTime;
+    std::ofstream(filename + ".sha1") << size << " " << modificationTime << " zz" << std::endl;
+
+    FileConfigurationStorage storage(filename);
+    BOOST_CHECK(storage.getConfigurationHash().empty());
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".sha1").c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace kaa
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "kaa/event/EventManager.hpp"
+#include "kaa/common/exception/KaaException.hpp"
+
+#include "headers/MockKaaClientStateStorage.hpp"
+
+namespace kaa {
+
+class MockEventQueueListener : public IEventQueueListener {
+public:
+    virtual void onEventQueueFull(std::size_t droppedEventsCount) { ++onEventQueueFull_; droppedEventsCount_ = droppedEventsCount; }
+    virtual void onEventQueueAvailable() { ++onEventQueueAvailable_; }
+
+public:
+    std::size_t onEventQueueFull_ = 0;
+    std::size_t onEventQueueAvailable_ = 0;
+    std::size_t droppedEventsCount_ = 0;
+};
+
+static const std::string EVENT_FQN("org.kaa.test.Event");
+
+BOOST_AUTO_TEST_SUITE(EventManagerSuite)
+
+BOOST_AUTO_TEST_CASE(BadPendingEventsLimitsTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+
+    BOOST_CHECK_THROW(manager.setPendingEventsLimits(0, 1024, EventQueueOverflowPolicy::REJECT_NEW), KaaException);
+    BOOST_CHECK_THROW(manager.setPendingEventsLimits(16, 0, EventQueueOverflowPolicy::REJECT_NEW), KaaException);
+}
+
+BOOST_AUTO_TEST_CASE(MoveEventDataTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+
+    std::vector<std::uint8_t> data = { 1, 2, 3 };
+    std::vector<std::uint8_t> expected(data);
+
+    manager.produceEvent(EVENT_FQN, std::move(data), "", TransactionIdPtr());
+
+    auto events = manager.releasePendingEvents();
+    BOOST_REQUIRE_EQUAL(events.size(), 1);
+
+    const auto& actual = events.begin()->second.eventData;
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(RejectNewEventsTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+    MockEventQueueListener listener;
+
+    manager.setEventQueueListener(&listener);
+    manager.setPendingEventsLimits(2, 1024, EventQueueOverflowPolicy::REJECT_NEW);
+
+    for (std::uint8_t i = 0; i < 3; ++i) {
+        manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, i), "", TransactionIdPtr());
+    }
+
+    BOOST_CHECK_EQUAL(manager.getDroppedEventsCount(), 1);
+    BOOST_CHECK_EQUAL(listener.onEventQueueFull_, 1);
+    BOOST_CHECK_EQUAL(listener.droppedEventsCount_, 1);
+
+    auto events = manager.releasePendingEvents();
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_CHECK_EQUAL(events.begin()->second.eventData.front(), 0);
+
+    /* Released events are still being sent, so they keep occupying the queue until acknowledged. */
+    BOOST_CHECK_EQUAL(listener.onEventQueueAvailable_, 0);
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, 0), "", TransactionIdPtr());
+    BOOST_CHECK_EQUAL(manager.getDroppedEventsCount(), 2);
+    BOOST_CHECK(!manager.hasPendingEvents());
+
+    std::list<Event> deliveredEvents;
+    for (auto& pair : events) {
+        deliveredEvents.push_back(pair.second);
+    }
+    manager.onEventsDelivered(deliveredEvents);
+    BOOST_CHECK_EQUAL(listener.onEventQueueAvailable_, 1);
+
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, 0), "", TransactionIdPtr());
+    BOOST_CHECK(manager.hasPendingEvents());
+    manager.onEventsDelivered(std::list<Event>(1, manager.releasePendingEvents().begin()->second));
+    BOOST_CHECK_EQUAL(listener.onEventQueueAvailable_, 1);
+}
+
+BOOST_AUTO_TEST_CASE(DropOldestKeepsEventsBeingSentTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+
+    manager.setPendingEventsLimits(2, 1024, EventQueueOverflowPolicy::DROP_OLDEST);
+
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, 0), "", TransactionIdPtr());
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, 1), "", TransactionIdPtr());
+    BOOST_CHECK_EQUAL(manager.releasePendingEvents().size(), 2);
+
+    /* Nothing pending can be dropped to make room, so the new event is rejected. */
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, 2), "", TransactionIdPtr());
+    BOOST_CHECK_EQUAL(manager.getDroppedEventsCount(), 1);
+    BOOST_CHECK(!manager.hasPendingEvents());
+}
+
+BOOST_AUTO_TEST_CASE(DropOldestEventsTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+    MockEventQueueListener listener;
+
+    const std::size_t eventSize = EVENT_FQN.size() + 10;
+
+    manager.setEventQueueListener(&listener);
+    manager.setPendingEventsLimits(16, 2 * eventSize, EventQueueOverflowPolicy::DROP_OLDEST);
+
+    for (std::uint8_t i = 0; i < 3; ++i) {
+        manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(10, i), "", TransactionIdPtr());
+    }
+
+    /* The event which exceeds the size limit by itself is rejected under any policy. */
+    manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(3 * eventSize, 0), "", TransactionIdPtr());
+
+    BOOST_CHECK_EQUAL(manager.getDroppedEventsCount(), 2);
+    BOOST_CHECK_EQUAL(listener.onEventQueueFull_, 2);
+
+    auto events = manager.releasePendingEvents();
+    BOOST_REQUIRE_EQUAL(events.size(), 2);
+    BOOST_CHECK_EQUAL(events.begin()->second.eventData.front(), 1);
+    BOOST_CHECK_EQUAL(events.rbegin()->second.eventData.front(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CommitTransactionOverflowTest)
+{
+    EventManager manager(IKaaClientStateStoragePtr(new MockKaaClientStateStorage));
+
+    manager.setPendingEventsLimits(2, 1024, EventQueueOverflowPolicy::REJECT_NEW);
+
+    auto trxId = manager.beginTransaction();
+    for (std::uint8_t i = 0; i < 3; ++i) {
+        manager.produceEvent(EVENT_FQN, std::vector<std::uint8_t>(1, i), "", trxId);
+    }
+
+    BOOST_CHECK(!manager.hasPendingEvents());
+
+    manager.commit(trxId);
+
+    BOOST_CHECK_EQUAL(manager.getDroppedEventsCount(), 1);
+    BOOST_CHECK_EQUAL(manager.releasePendingEvents().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
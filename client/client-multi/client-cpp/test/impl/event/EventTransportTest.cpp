@@ -77,8 +77,19 @@ public:
     {
     }
 
+    virtual void onEventsDelivered(const std::list<Event>& events)
+    {
+        deliveredEventsCount_ += events.size();
+    }
+
+    std::size_t getDeliveredEventsCount() const
+    {
+        return deliveredEventsCount_;
+    }
+
 private:
     std::map<std::int32_t, Event> events_;
+    std::size_t deliveredEventsCount_ = 0;
 };
 
 BOOST_AUTO_TEST_SUITE(EventTransportTestSuite)
@@ -199,6 +210,53 @@ BOOST_AUTO_TEST_CASE(UnsychronizedEventSequenceNumberTest)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(EventsDeliveryAcknowledgementTest)
+{
+    std::int32_t sn = 10;
+    IKaaClientStateStoragePtr clientState(new TestKaaClientStateStorage);
+    clientState->setEventSequenceNumber(sn);
+
+    MockChannelManager channelManager;
+    TestEventDataProcessor processor;
+    EventTransport transport(processor, channelManager, clientState);
+
+    std::int32_t requestId = 1;
+    transport.createEventRequest(requestId++);
+
+    EventSyncResponse eventResponse;
+    EventSequenceNumberResponse esnr;
+    esnr.seqNum = sn - 1;
+
+    eventResponse.eventSequenceNumberResponse.set_EventSequenceNumberResponse(esnr);
+    eventResponse.eventListenersResponses.set_null();
+    eventResponse.events.set_null();
+
+    transport.onEventResponse(eventResponse);
+
+    std::map<std::int32_t, Event> pevents;
+    pevents[1] = createEvent(0);
+    pevents[2] = createEvent(0);
+    processor.setPendingEvents(pevents);
+
+    std::int32_t eventsRequestId = requestId++;
+    transport.createEventRequest(eventsRequestId);
+
+    /* Events are resent until the request which carried them is acknowledged. */
+    auto eventSyncRequest = transport.createEventRequest(requestId++);
+    BOOST_CHECK_EQUAL(eventSyncRequest->events.get_array().size(), 2);
+    BOOST_CHECK_EQUAL(processor.getDeliveredEventsCount(), 0);
+
+    transport.onSyncResponseId(eventsRequestId);
+    BOOST_CHECK_EQUAL(processor.getDeliveredEventsCount(), 2);
+
+    eventSyncRequest = transport.createEventRequest(requestId++);
+    BOOST_CHECK(eventSyncRequest->events.get_array().empty());
+
+    transport.onSyncResponseId(eventsRequestId);
+    BOOST_CHECK_EQUAL(processor.getDeliveredEventsCount(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -16,6 +16,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <string>
+#include <vector>
+
 #include "kaa/http/HttpResponse.hpp"
 #include "kaa/common/exception/KaaException.hpp"
 
@@ -23,6 +26,8 @@ namespace kaa {
 
 static const std::string response_wo_body = "HTTP/1.1\t200\r\nContent-Length: 0\r\nContent-Type: text/plain\r\n\r\n";
 static const std::string response_with_body = "HTTP/1.1\t200\r\nContent-Length: 10\r\nContent-Type: text/plain\r\n\r\n0123456789";
+static const std::string response_chunked = "HTTP/1.1 200 OK\r\ntransfer-encoding: chunked\r\n\r\n4\r\n0123\r\n6;ext=1\r\n456789\r\n0\r\nX-Trailer: 1\r\n\r\n";
+static const std::string response_until_close = "HTTP/1.0 200 OK\r\nContent-Type: text/plain\r\n\r\n0123456789";
 
 BOOST_AUTO_TEST_SUITE(HttpResponseSuite)
 
@@ -65,6 +70,84 @@ BOOST_AUTO_TEST_CASE(checkSimpleResponseWithBody)
     BOOST_CHECK_EQUAL_COLLECTIONS(body.first.get(), body.first.get() + expected_body_length, expected_body, expected_body + expected_body_length);
 }
 
+BOOST_AUTO_TEST_CASE(checkIncrementalResponseWithBody)
+{
+    HttpResponse hr;
+    for (std::size_t i = 0; i < response_with_body.length(); ++i) {
+        BOOST_CHECK(!hr.isComplete());
+        BOOST_CHECK_EQUAL(hr.feed(response_with_body.data() + i, 1), 1);
+    }
+    BOOST_CHECK(hr.isComplete());
+    BOOST_CHECK_EQUAL(hr.getStatusCode(), 200);
+    BOOST_CHECK_EQUAL(hr.getHeaderField("content-length"), "10");
+
+    const char * expected_body = "0123456789";
+    SharedBody body = hr.getBody();
+    BOOST_CHECK_EQUAL_COLLECTIONS(body.first.get(), body.first.get() + body.second, expected_body, expected_body + 10);
+
+    const std::string extra("HTTP/1.1");
+    BOOST_CHECK_EQUAL(hr.feed(extra.data(), extra.length()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(checkChunkedResponse)
+{
+    const char * expected_body = "0123456789";
+
+    HttpResponse whole(response_chunked);
+    SharedBody body = whole.getBody();
+    BOOST_CHECK_EQUAL_COLLECTIONS(body.first.get(), body.first.get() + body.second, expected_body, expected_body + 10);
+
+    HttpResponse hr;
+    std::size_t offset = 0;
+    while (offset < response_chunked.length()) {
+        std::size_t portion = std::min<std::size_t>(3, response_chunked.length() - offset);
+        offset += hr.feed(response_chunked.data() + offset, portion);
+    }
+    BOOST_CHECK(hr.isComplete());
+    body = hr.getBody();
+    BOOST_CHECK_EQUAL_COLLECTIONS(body.first.get(), body.first.get() + body.second, expected_body, expected_body + 10);
+}
+
+BOOST_AUTO_TEST_CASE(checkResponseUntilConnectionClose)
+{
+    HttpResponse hr;
+    hr.feed(response_until_close.data(), response_until_close.length());
+    BOOST_CHECK(!hr.isComplete());
+    hr.finish();
+    BOOST_CHECK(hr.isComplete());
+    BOOST_CHECK_EQUAL(hr.getBody().second, 10);
+}
+
+BOOST_AUTO_TEST_CASE(checkTruncatedResponse)
+{
+    const std::string truncated = response_with_body.substr(0, response_with_body.length() - 2);
+    BOOST_REQUIRE_THROW(HttpResponse hr(truncated), KaaException);
+
+    HttpResponse hr;
+    BOOST_REQUIRE_THROW(hr.finish(), KaaException);
+}
+
+BOOST_AUTO_TEST_CASE(checkInvalidContentLength)
+{
+    const std::vector<std::string> lengths = { "-1", "+10", "10abc", "abc", "99999999999999999999", "1073741824" };
+
+    for (const auto& length : lengths) {
+        const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " + length + "\r\n\r\n0123456789";
+        BOOST_CHECK_THROW(HttpResponse hr(response), KaaException);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(checkInvalidChunkSize)
+{
+    const std::vector<std::string> sizes = { "FFFFFFFFFFFFFFFF", "10000000000000000", "40000000", "-4", " 4", "4x", "" };
+
+    for (const auto& size : sizes) {
+        const std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                                     "4\r\n0123\r\n" + size + "\r\n0123\r\n0\r\n\r\n";
+        BOOST_CHECK_THROW(HttpResponse hr(response), KaaException);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace kaa
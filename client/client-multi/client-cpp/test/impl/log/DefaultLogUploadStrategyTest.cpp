@@ -113,6 +113,33 @@ BOOST_AUTO_TEST_CASE(UploadByRecordCountTest)
     BOOST_CHECK(strategy.isUploadNeeded(logStorageStatus) == LogUploadStrategyDecision::UPLOAD);
 }
 
+BOOST_AUTO_TEST_CASE(UploadByPriorityThresholdTest)
+{
+    const std::size_t PRIORITY_THRESHOLD_SIZE = 10;
+
+    MockLogStorageStatus logStorageStatus;
+    logStorageStatus.consumedVolume_ = PRIORITY_THRESHOLD_SIZE - 1;
+    logStorageStatus.recordsCount_ = 1;
+
+    MockChannelManager channelManager;
+    DefaultLogUploadStrategy strategy(&channelManager);
+
+    strategy.setVolumeThreshold(LogPriority::NORMAL, PRIORITY_THRESHOLD_SIZE);
+
+    BOOST_CHECK(strategy.isUploadNeeded(logStorageStatus) == LogUploadStrategyDecision::NOOP);
+
+    logStorageStatus.consumedVolume_ = PRIORITY_THRESHOLD_SIZE;
+
+    BOOST_CHECK(strategy.isUploadNeeded(logStorageStatus) == LogUploadStrategyDecision::UPLOAD);
+
+    strategy.setVolumeThreshold(LogPriority::NORMAL, 0);
+    strategy.setCountThreshold(LogPriority::NORMAL, 1);
+
+    logStorageStatus.consumedVolume_ = 0;
+
+    BOOST_CHECK(strategy.isUploadNeeded(logStorageStatus) == LogUploadStrategyDecision::UPLOAD);
+}
+
 BOOST_AUTO_TEST_CASE(OnFailureTest)
 {
     MockChannelManager channelManager;
@@ -16,6 +16,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <chrono>
@@ -39,7 +40,7 @@ public:
     virtual void sync() { ++onSync_; }
 
 public:
-    std::size_t onSync_ = 0;
+    std::atomic<std::size_t> onSync_{0};
 };
 
 #define LOG_TEST_DATA "test data"
@@ -193,6 +194,8 @@ BOOST_AUTO_TEST_CASE(CreateRequestWithLogsTest)
 BOOST_AUTO_TEST_CASE(SuccessDeliveryTest)
 {
     const size_t BATCH_SIZE = 100500;
+    const size_t DELIVERY_TIMEOUT = 60;
+
     MockChannelManager channelManager;
     LogCollector logCollector(&channelManager);
     CustomLoggingTransport transport(channelManager, logCollector);
@@ -212,6 +215,7 @@ BOOST_AUTO_TEST_CASE(SuccessDeliveryTest)
 
     std::shared_ptr<MockLogUploadStrategy> uploadStrategy(new MockLogUploadStrategy);
     uploadStrategy->batchSize_ = BATCH_SIZE;
+    uploadStrategy->timeout_ = DELIVERY_TIMEOUT;
     uploadStrategy->decision_ = LogUploadStrategyDecision::NOOP;
 
     logCollector.setStorage(logStorage);
@@ -235,6 +239,8 @@ BOOST_AUTO_TEST_CASE(SuccessDeliveryTest)
 BOOST_AUTO_TEST_CASE(FailedDeliveryTest)
 {
     const size_t BATCH_SIZE = 100500;
+    const size_t DELIVERY_TIMEOUT = 60;
+
     MockChannelManager channelManager;
     LogCollector logCollector(&channelManager);
     CustomLoggingTransport transport(channelManager, logCollector);
@@ -254,6 +260,7 @@ BOOST_AUTO_TEST_CASE(FailedDeliveryTest)
 
     std::shared_ptr<MockLogUploadStrategy> uploadStrategy(new MockLogUploadStrategy);
     uploadStrategy->batchSize_ = BATCH_SIZE;
+    uploadStrategy->timeout_ = DELIVERY_TIMEOUT;
     uploadStrategy->decision_ = LogUploadStrategyDecision::NOOP;
 
     logCollector.setStorage(logStorage);
@@ -275,7 +282,7 @@ BOOST_AUTO_TEST_CASE(FailedDeliveryTest)
     BOOST_CHECK_EQUAL(uploadStrategy->onIsUploadNeeded_, 1);
 }
 
-BOOST_AUTO_TEST_CASE(TimeoutLasyDetectionTest)
+BOOST_AUTO_TEST_CASE(TimeoutDetectionTest)
 {
     const size_t BATCH_SIZE = 100500;
     const size_t DELIVERY_TIMEOUT = 2;
@@ -310,17 +317,105 @@ BOOST_AUTO_TEST_CASE(TimeoutLasyDetectionTest)
     BOOST_CHECK_EQUAL(uploadStrategy->onTimeout_, 0);
     BOOST_CHECK_EQUAL(uploadStrategy->onGetTimeout_, 1);
 
-    std::this_thread::sleep_for(std::chrono::seconds(DELIVERY_TIMEOUT));
-
     /*
-     * Check on timeout do only on adding new record
+     * The timeout is detected by the scheduler, no new records are needed
      */
-    logCollector.addLogRecord(createLogRecord());
+    std::this_thread::sleep_for(std::chrono::milliseconds(DELIVERY_TIMEOUT * 1000 + 500));
+    logCollector.shutdown();
 
     BOOST_CHECK_EQUAL(uploadStrategy->onTimeout_, 1);
     BOOST_CHECK_EQUAL(logStorage->onNotifyUploadFailed_, 1);
 }
 
+BOOST_AUTO_TEST_CASE(MaxBatchingDelayTest)
+{
+    const size_t MAX_BATCHING_DELAY = 1;
+
+    MockChannelManager channelManager;
+    LogCollector logCollector(&channelManager);
+    CustomLoggingTransport transport(channelManager, logCollector);
+
+    logCollector.setTransport(&transport);
+
+    std::shared_ptr<MockLogStorage> logStorage(new MockLogStorage);
+    logStorage->storageStatus_.recordsCount_ = 1;
+    logStorage->storageStatus_.consumedVolume_ = 1;
+
+    std::shared_ptr<MockLogUploadStrategy> uploadStrategy(new MockLogUploadStrategy);
+    uploadStrategy->decision_ = LogUploadStrategyDecision::NOOP;
+
+    logCollector.setStorage(logStorage);
+    logCollector.setUploadStrategy(uploadStrategy);
+    logCollector.setMaxBatchingDelay(MAX_BATCHING_DELAY);
+
+    logCollector.addLogRecord(createLogRecord());
+
+    BOOST_CHECK_EQUAL(transport.onSync_, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(MAX_BATCHING_DELAY * 1000 + 500));
+    logCollector.shutdown();
+
+    BOOST_CHECK_EQUAL(transport.onSync_, 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxBatchingDelayOfStoredRecordsTest)
+{
+    const size_t MAX_BATCHING_DELAY = 1;
+
+    MockChannelManager channelManager;
+    LogCollector logCollector(&channelManager);
+    CustomLoggingTransport transport(channelManager, logCollector);
+
+    logCollector.setTransport(&transport);
+
+    /*
+     * Records are already in the storage, e.g. they are returned after a failed upload
+     */
+    std::shared_ptr<MockLogStorage> logStorage(new MockLogStorage);
+    logStorage->storageStatus_.recordsCount_ = 1;
+    logStorage->storageStatus_.consumedVolume_ = 1;
+
+    std::shared_ptr<MockLogUploadStrategy> uploadStrategy(new MockLogUploadStrategy);
+    uploadStrategy->decision_ = LogUploadStrategyDecision::NOOP;
+
+    logCollector.setStorage(logStorage);
+    logCollector.setUploadStrategy(uploadStrategy);
+    logCollector.setMaxBatchingDelay(MAX_BATCHING_DELAY);
+
+    logCollector.onConnectivityChanged();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(MAX_BATCHING_DELAY * 1000 + 500));
+    logCollector.shutdown();
+
+    BOOST_CHECK_EQUAL(transport.onSync_, 1);
+}
+
+BOOST_AUTO_TEST_CASE(ShutdownTest)
+{
+    MockChannelManager channelManager;
+    LogCollector logCollector(&channelManager);
+    CustomLoggingTransport transport(channelManager, logCollector);
+
+    logCollector.setTransport(&transport);
+
+    std::shared_ptr<MockLogStorage> logStorage(new MockLogStorage);
+    logStorage->storageStatus_.recordsCount_ = 1;
+
+    std::shared_ptr<MockLogUploadStrategy> uploadStrategy(new MockLogUploadStrategy);
+    uploadStrategy->decision_ = LogUploadStrategyDecision::UPLOAD;
+
+    logCollector.setStorage(logStorage);
+    logCollector.setUploadStrategy(uploadStrategy);
+
+    logCollector.shutdown();
+    logCollector.shutdown();
+
+    logCollector.onConnectivityChanged();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    BOOST_CHECK_EQUAL(transport.onSync_, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -16,7 +16,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <list>
 #include <string>
+#include <vector>
 
 #include "kaa/log/LogRecord.hpp"
 #include "kaa/log/MemoryLogStorage.hpp"
@@ -230,6 +232,189 @@ BOOST_AUTO_TEST_CASE(ForceRemovalOfSpecifiedPercentOfLogsTest)
     BOOST_CHECK_EQUAL(logStorage.getStatus().getConsumedVolume(), sizeAfterRemoval);
 }
 
+BOOST_AUTO_TEST_CASE(CompressedRecordsTest)
+{
+    std::size_t logRecordCount = 100;
+    std::size_t rawSize = 0;
+    std::list<LogRecordPtr> records;
+
+    for (std::size_t i = 0; i < logRecordCount; ++i) {
+        KaaUserLogRecord logRecord;
+        logRecord.logdata = std::string(LOG_TEST_DATA) + " #" + std::to_string(i);
+
+        records.push_back(std::make_shared<LogRecord>(logRecord));
+        rawSize += records.back()->getSize();
+    }
+
+    MemoryLogStorage logStorage;
+    logStorage.setCompressionBlockSize(rawSize / 4);
+
+    for (const auto& record : records) {
+        logStorage.addLogRecord(record);
+    }
+
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(), logRecordCount);
+    BOOST_CHECK_LT(logStorage.getStatus().getConsumedVolume(), rawSize);
+
+    auto pack = logStorage.getRecordBlock(rawSize);
+
+    BOOST_CHECK_EQUAL(pack.second.size(), logRecordCount);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(), 0);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getConsumedVolume(), 0);
+
+    auto expectedIt = records.begin();
+    for (const auto& record : pack.second) {
+        BOOST_CHECK((*expectedIt++)->getData() == record->getData());
+    }
+
+    logStorage.notifyUploadFailed(pack.first);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(), logRecordCount);
+
+    pack = logStorage.getRecordBlock(rawSize);
+    logStorage.removeRecordBlock(pack.first);
+
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(), 0);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getConsumedVolume(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DeliveredRecordsDoNotTriggerCompressionTest)
+{
+    auto serializedLogRecord = createSerializedLogRecord();
+
+    std::size_t logRecordCount = 5;
+    MemoryLogStorage logStorage;
+    logStorage.setCompressionBlockSize(logRecordCount * serializedLogRecord->getSize());
+
+    for (std::size_t i = 0; i < logRecordCount - 1; ++i) {
+        logStorage.addLogRecord(serializedLogRecord);
+    }
+
+    auto pack = logStorage.getRecordBlock(logRecordCount * serializedLogRecord->getSize());
+    logStorage.removeRecordBlock(pack.first);
+
+    /*
+     * The only unmarked record is far below the compression block size, so it is kept as is.
+     */
+    logStorage.addLogRecord(serializedLogRecord);
+
+    pack = logStorage.getRecordBlock(serializedLogRecord->getSize());
+
+    BOOST_REQUIRE_EQUAL(pack.second.size(), 1);
+    BOOST_CHECK(pack.second.front() == serializedLogRecord);
+}
+
+BOOST_AUTO_TEST_CASE(CompressedRecordsKeepPriorityTest)
+{
+    KaaUserLogRecord logRecord;
+    logRecord.logdata = LOG_TEST_DATA;
+
+    LogRecordPtr highRecord(new LogRecord(logRecord, LogPriority::HIGH));
+
+    std::size_t logRecordCount = 10;
+    MemoryLogStorage logStorage;
+    logStorage.setCompressionBlockSize(logRecordCount * highRecord->getSize());
+
+    for (std::size_t i = 0; i < logRecordCount; ++i) {
+        logStorage.addLogRecord(highRecord);
+    }
+
+    auto pack = logStorage.getRecordBlock(logRecordCount * highRecord->getSize());
+
+    BOOST_REQUIRE_EQUAL(pack.second.size(), logRecordCount);
+    for (const auto& record : pack.second) {
+        BOOST_CHECK(record != highRecord);
+        BOOST_CHECK(record->getPriority() == LogPriority::HIGH);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CompressedRecordsKeepOrderAfterFailedUploadTest)
+{
+    std::vector<LogRecordPtr> records;
+    for (std::size_t i = 0; i < 4; ++i) {
+        KaaUserLogRecord logRecord;
+        logRecord.logdata = std::string(LOG_TEST_DATA) + " #" + std::to_string(i);
+
+        records.push_back(std::make_shared<LogRecord>(logRecord));
+    }
+
+    const std::size_t recordSize = records.front()->getSize();
+    MemoryLogStorage logStorage;
+    logStorage.setCompressionBlockSize(3 * recordSize);
+
+    logStorage.addLogRecord(records[0]);
+    logStorage.addLogRecord(records[1]);
+
+    auto pack = logStorage.getRecordBlock(recordSize);
+    BOOST_REQUIRE_EQUAL(pack.second.size(), 1);
+
+    /*
+     * Newer records reach the compression block size while the oldest one is being uploaded.
+     */
+    logStorage.addLogRecord(records[2]);
+    logStorage.addLogRecord(records[3]);
+    logStorage.notifyUploadFailed(pack.first);
+
+    pack = logStorage.getRecordBlock(records.size() * recordSize);
+    BOOST_REQUIRE_EQUAL(pack.second.size(), records.size());
+
+    auto expectedIt = records.begin();
+    for (const auto& record : pack.second) {
+        BOOST_CHECK((*expectedIt++)->getData() == record->getData());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PriorityOrderTest)
+{
+    KaaUserLogRecord logRecord;
+    logRecord.logdata = LOG_TEST_DATA;
+
+    LogRecordPtr lowRecord(new LogRecord(logRecord, LogPriority::LOW));
+    LogRecordPtr criticalRecord(new LogRecord(logRecord, LogPriority::CRITICAL));
+
+    MemoryLogStorage logStorage;
+    logStorage.addLogRecord(lowRecord);
+    logStorage.addLogRecord(lowRecord);
+    logStorage.addLogRecord(criticalRecord);
+
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(), 3);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::LOW), 2);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::CRITICAL), 1);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getConsumedVolume(LogPriority::CRITICAL), criticalRecord->getSize());
+
+    auto pack = logStorage.getRecordBlock(criticalRecord->getSize() + lowRecord->getSize());
+
+    BOOST_REQUIRE_EQUAL(pack.second.size(), 2);
+    BOOST_CHECK(pack.second.front() == criticalRecord);
+    BOOST_CHECK(pack.second.back() == lowRecord);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::CRITICAL), 0);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::LOW), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ForceRemovalOfLowPriorityLogsFirstTest)
+{
+    KaaUserLogRecord logRecord;
+    logRecord.logdata = LOG_TEST_DATA;
+
+    LogRecordPtr lowRecord(new LogRecord(logRecord, LogPriority::LOW));
+    LogRecordPtr highRecord(new LogRecord(logRecord, LogPriority::HIGH));
+
+    std::size_t logRecordCount = 10;
+    MemoryLogStorage logStorage(logRecordCount * lowRecord->getSize(), 50.0);
+
+    for (std::size_t i = 0; i < logRecordCount / 2; ++i) {
+        logStorage.addLogRecord(highRecord);
+        logStorage.addLogRecord(lowRecord);
+    }
+
+    /*
+     * Should cause force removal of all the low priority logs
+     */
+    logStorage.addLogRecord(highRecord);
+
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::LOW), 0);
+    BOOST_CHECK_EQUAL(logStorage.getStatus().getRecordsCount(LogPriority::HIGH), logRecordCount / 2 + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <condition_variable>
+
+#include "kaa/logging/AsyncLogger.hpp"
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+class CollectingLogger : public ILogger {
+public:
+    CollectingLogger() : blocked_(false) {}
+
+    virtual void log(LogLevel level, const char *message) const {
+        std::unique_lock<std::mutex> lock(guard_);
+        condition_.wait(lock, [this] () { return !blocked_; });
+        messages_.push_back(std::make_pair(level, std::string(message)));
+    }
+
+    void block() {
+        std::unique_lock<std::mutex> lock(guard_);
+        blocked_ = true;
+    }
+
+    void unblock() {
+        std::unique_lock<std::mutex> lock(guard_);
+        blocked_ = false;
+        condition_.notify_all();
+    }
+
+    std::vector<std::pair<LogLevel, std::string> > getMessages() const {
+        std::unique_lock<std::mutex> lock(guard_);
+        return messages_;
+    }
+
+private:
+    bool blocked_;
+    mutable std::vector<std::pair<LogLevel, std::string> > messages_;
+    mutable std::mutex guard_;
+    mutable std::condition_variable condition_;
+};
+
+BOOST_AUTO_TEST_SUITE(AsyncLoggerTestSuite)
+
+BOOST_AUTO_TEST_CASE(BadInitializationParamsTest)
+{
+    BOOST_CHECK_THROW(AsyncLogger logger((LoggerPtr())), KaaException);
+    BOOST_CHECK_THROW(AsyncLogger logger(LoggerPtr(new CollectingLogger), 0), KaaException);
+}
+
+BOOST_AUTO_TEST_CASE(MessageOrderTest)
+{
+    std::shared_ptr<CollectingLogger> target(new CollectingLogger);
+    AsyncLogger logger(target);
+
+    const std::size_t messageCount = 100;
+    for (std::size_t i = 0; i < messageCount; ++i) {
+        logger.log(LogLevel::INFO, std::to_string(i).c_str());
+    }
+    logger.flush();
+
+    const auto& messages = target->getMessages();
+    BOOST_REQUIRE_EQUAL(messages.size(), messageCount);
+    for (std::size_t i = 0; i < messageCount; ++i) {
+        BOOST_CHECK(messages[i].first == LogLevel::INFO);
+        BOOST_CHECK_EQUAL(messages[i].second, std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(logger.getDroppedCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LongMessageTest)
+{
+    std::shared_ptr<CollectingLogger> target(new CollectingLogger);
+    AsyncLogger logger(target);
+
+    const std::string message(AsyncLogger::MAX_MESSAGE_LENGTH * 2, 'a');
+    logger.log(LogLevel::DEBUG, message.c_str());
+    logger.flush();
+
+    const auto& messages = target->getMessages();
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_CHECK_EQUAL(messages[0].second.size(), AsyncLogger::MAX_MESSAGE_LENGTH - 1);
+    BOOST_CHECK_EQUAL(messages[0].second,
+            message.substr(0, AsyncLogger::MAX_MESSAGE_LENGTH - sizeof(AsyncLogger::TRUNCATION_MARKER))
+                + AsyncLogger::TRUNCATION_MARKER);
+}
+
+BOOST_AUTO_TEST_CASE(DropOnOverflowTest)
+{
+    std::shared_ptr<CollectingLogger> target(new CollectingLogger);
+    const std::size_t capacity = 4;
+    AsyncLogger logger(target, capacity);
+
+    target->block();
+
+    /*
+     * The worker may have already taken one message from the queue,
+     * so one extra message is accepted at most.
+     */
+    const std::size_t messageCount = 10;
+    for (std::size_t i = 0; i < messageCount; ++i) {
+        logger.log(LogLevel::INFO, "message");
+    }
+
+    std::uint64_t droppedCount = logger.getDroppedCount();
+    BOOST_CHECK(droppedCount >= messageCount - capacity - 1);
+    BOOST_CHECK(droppedCount <= messageCount - capacity);
+
+    target->unblock();
+    logger.flush();
+
+    const auto& messages = target->getMessages();
+    BOOST_CHECK_EQUAL(messages.size(), messageCount - droppedCount + 1);
+
+    bool warningFound = false;
+    for (const auto& message : messages) {
+        warningFound |= (message.first == LogLevel::WARNING);
+    }
+    BOOST_CHECK(warningFound);
+}
+
+BOOST_AUTO_TEST_CASE(DrainOnDestructionTest)
+{
+    std::shared_ptr<CollectingLogger> target(new CollectingLogger);
+    {
+        AsyncLogger logger(target);
+        logger.log(LogLevel::ERROR, "first");
+        logger.log(LogLevel::FATAL, "second");
+    }
+
+    const auto& messages = target->getMessages();
+    BOOST_REQUIRE_EQUAL(messages.size(), 2);
+    BOOST_CHECK_EQUAL(messages[1].second, "second");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
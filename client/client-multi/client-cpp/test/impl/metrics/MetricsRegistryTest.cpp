@@ -0,0 +1,113 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "kaa/metrics/MetricsRegistry.hpp"
+#include "kaa/common/exception/KaaException.hpp"
+
+namespace kaa {
+
+BOOST_AUTO_TEST_SUITE(MetricsRegistryTestSuite)
+
+BOOST_AUTO_TEST_CASE(BadHistogramBoundsTest)
+{
+    BOOST_CHECK_THROW(Histogram(std::vector<std::uint64_t>()), KaaException);
+    BOOST_CHECK_THROW(Histogram({ 10, 5 }), KaaException);
+
+    MetricsRegistry registry;
+    BOOST_CHECK_THROW(registry.getHistogram("histogram", {}), KaaException);
+    BOOST_CHECK(registry.getSnapshot().histograms.empty());
+}
+
+BOOST_AUTO_TEST_CASE(SameNameSameMetricTest)
+{
+    MetricsRegistry registry;
+
+    BOOST_CHECK_EQUAL(&registry.getCounter("counter"), &registry.getCounter("counter"));
+    BOOST_CHECK_EQUAL(&registry.getGauge("gauge"), &registry.getGauge("gauge"));
+
+    Histogram *histogram = &registry.getHistogram("histogram", { 1 });
+    BOOST_CHECK_EQUAL(histogram, &registry.getHistogram("histogram", { 1, 2 }));
+    BOOST_CHECK_EQUAL(registry.getSnapshot().histograms["histogram"].bounds.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotTest)
+{
+    MetricsRegistry registry;
+
+    registry.getCounter("counter").increment();
+    registry.getCounter("counter").increment(4);
+    registry.getGauge("gauge").setValue(10);
+    registry.getGauge("gauge").add(-3);
+
+    auto& histogram = registry.getHistogram("histogram", { 10, 100 });
+    histogram.record(1);
+    histogram.record(10);
+    histogram.record(50);
+    histogram.record(1000);
+
+    const auto& snapshot = registry.getSnapshot();
+    BOOST_CHECK_EQUAL(snapshot.counters.at("counter"), 5);
+    BOOST_CHECK_EQUAL(snapshot.gauges.at("gauge"), 7);
+
+    const auto& histogramSnapshot = snapshot.histograms.at("histogram");
+    BOOST_CHECK_EQUAL(histogramSnapshot.count, 4);
+    BOOST_CHECK_EQUAL(histogramSnapshot.sum, 1061);
+
+    std::vector<std::uint64_t> expectedBuckets = { 2, 1, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(histogramSnapshot.buckets.begin(), histogramSnapshot.buckets.end(),
+                                  expectedBuckets.begin(), expectedBuckets.end());
+
+    BOOST_CHECK(!snapshot.toString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentUpdateTest)
+{
+    const std::size_t THREAD_COUNT = 4;
+    const std::size_t UPDATE_COUNT = 10000;
+
+    MetricsRegistry registry;
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < THREAD_COUNT; ++i) {
+        threads.push_back(std::thread([&registry, UPDATE_COUNT] ()
+            {
+                auto& counter = registry.getCounter("counter");
+                auto& histogram = registry.getHistogram("histogram");
+                for (std::size_t j = 0; j < UPDATE_COUNT; ++j) {
+                    counter.increment();
+                    histogram.record(j);
+                }
+            }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto& snapshot = registry.getSnapshot();
+    BOOST_CHECK_EQUAL(snapshot.counters.at("counter"), THREAD_COUNT * UPDATE_COUNT);
+    BOOST_CHECK_EQUAL(snapshot.histograms.at("histogram").count, THREAD_COUNT * UPDATE_COUNT);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
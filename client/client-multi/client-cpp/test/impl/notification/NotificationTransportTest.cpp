@@ -19,7 +19,9 @@
 #include "kaa/ClientStatus.hpp"
 #include "kaa/notification/NotificationTransport.hpp"
 
+#include "headers/MockKaaClientStateStorage.hpp"
 #include "headers/channel/MockChannelManager.hpp"
+#include "headers/notification/MockNotificationProcessor.hpp"
 
 namespace kaa {
 
@@ -120,6 +122,57 @@ BOOST_AUTO_TEST_CASE(AcceptedUnicastNotificationsTest)
     BOOST_CHECK(request2->acceptedUnicastNotifications.is_null());
 }
 
+BOOST_AUTO_TEST_CASE(BoundedAcceptedUnicastNotificationsTest)
+{
+    IKaaClientStateStoragePtr status(new MockKaaClientStateStorage);
+    MockChannelManager channelManager;
+    NotificationTransport transport(status, channelManager, 2);
+
+    std::vector<Notification> notifications(3);
+    for (std::size_t i = 0; i < notifications.size(); ++i) {
+        notifications[i].topicId = "id1";
+        notifications[i].uid.set_string("uid" + std::to_string(i));
+    }
+
+    NotificationSyncResponse response;
+    response.responseStatus = SyncResponseStatus::DELTA;
+    response.notifications.set_array(notifications);
+    transport.onNotificationResponse(response);
+
+    auto request = transport.createNotificationRequest();
+    BOOST_REQUIRE(!request->acceptedUnicastNotifications.is_null());
+
+    std::vector<std::string> expectedUids = {"uid1", "uid2"};
+    auto acceptedUids = request->acceptedUnicastNotifications.get_array();
+    BOOST_CHECK_EQUAL_COLLECTIONS(acceptedUids.begin(), acceptedUids.end(), expectedUids.begin(), expectedUids.end());
+
+    AcceptedUnicastNotificationIds storedUids = status->getAcceptedUnicastNotificationIds();
+    BOOST_CHECK_EQUAL_COLLECTIONS(storedUids.begin(), storedUids.end(), expectedUids.begin(), expectedUids.end());
+}
+
+BOOST_AUTO_TEST_CASE(RestoredAcceptedUnicastNotificationsTest)
+{
+    IKaaClientStateStoragePtr status(new MockKaaClientStateStorage);
+    status->setAcceptedUnicastNotificationIds({"uid1"});
+
+    MockChannelManager channelManager;
+    MockNotificationProcessor processor;
+    NotificationTransport transport(status, channelManager);
+    transport.setNotificationProcessor(&processor);
+
+    Notification nf;
+    nf.topicId = "id1";
+    nf.uid.set_string("uid1");
+
+    NotificationSyncResponse response;
+    response.responseStatus = SyncResponseStatus::DELTA;
+    response.notifications.set_array(std::vector<Notification>({nf}));
+    transport.onNotificationResponse(response);
+
+    BOOST_CHECK_EQUAL(processor.onNotificationReceived_, 1);
+    BOOST_CHECK(processor.notifications_.empty());
+}
+
 BOOST_AUTO_TEST_CASE(DetailedTopicStateTest)
 {
     IKaaClientStateStoragePtr status(new ClientStatus("fakePath"));
@@ -198,6 +251,87 @@ BOOST_AUTO_TEST_CASE(DetailedTopicStateTest)
     }
 }
 
+static Topic createTopic(const std::string& id, const std::string& name, SubscriptionType type)
+{
+    Topic topic;
+    topic.id = id;
+    topic.name = name;
+    topic.subscriptionType = type;
+    return topic;
+}
+
+BOOST_AUTO_TEST_CASE(TopicListHashTest)
+{
+    IKaaClientStateStoragePtr status(new ClientStatus("fakePath"));
+    MockChannelManager channelManager;
+    MockNotificationProcessor processor;
+    NotificationTransport transport(status, channelManager);
+    transport.setNotificationProcessor(&processor);
+
+    Topic topic1 = createTopic("id1", "name1", OPTIONAL);
+    Topic topic2 = createTopic("id2", "name2", MANDATORY);
+
+    NotificationSyncResponse response1;
+    response1.availableTopics.set_array(std::vector<Topic>({topic1, topic2}));
+    transport.onNotificationResponse(response1);
+
+    BOOST_CHECK_EQUAL(processor.onTopicsListUpdated_, 1);
+
+    auto request1 = transport.createNotificationRequest();
+    BOOST_REQUIRE(!request1->topicListHash.is_null());
+    const auto& hash1 = request1->topicListHash.get_bytes();
+    BOOST_CHECK_EQUAL(hash1.size(), 20);
+
+    /* Same topics in another order: the list isn't re-processed */
+    NotificationSyncResponse response2;
+    response2.availableTopics.set_array(std::vector<Topic>({topic2, topic1}));
+    transport.onNotificationResponse(response2);
+
+    BOOST_CHECK_EQUAL(processor.onTopicsListUpdated_, 1);
+    BOOST_CHECK(transport.createNotificationRequest()->topicListHash.get_bytes() == hash1);
+    BOOST_CHECK_EQUAL(status->getTopicStates().size(), 2);
+
+    /* Renamed topic: the list is updated and the hash changes */
+    NotificationSyncResponse response3;
+    response3.availableTopics.set_array(std::vector<Topic>({topic1, createTopic("id2", "renamed", MANDATORY)}));
+    transport.onNotificationResponse(response3);
+
+    BOOST_CHECK_EQUAL(processor.onTopicsListUpdated_, 2);
+    BOOST_CHECK(transport.createNotificationRequest()->topicListHash.get_bytes() != hash1);
+    BOOST_CHECK_EQUAL(status->getTopicStates().at("id2").topicName, "renamed");
+}
+
+BOOST_AUTO_TEST_CASE(TopicListHashFromStoredStateTest)
+{
+    IKaaClientStateStoragePtr status(new ClientStatus("fakePath"));
+    MockChannelManager channelManager;
+
+    Topic topic1 = createTopic("id1", "name1", OPTIONAL);
+
+    HashDigest expectedHash;
+    {
+        NotificationTransport transport(status, channelManager);
+        NotificationSyncResponse response;
+        response.availableTopics.set_array(std::vector<Topic>({topic1}));
+        transport.onNotificationResponse(response);
+        expectedHash = transport.createNotificationRequest()->topicListHash.get_bytes();
+    }
+
+    /* Transport created over the stored topic states restores the same hash */
+    MockNotificationProcessor processor;
+    NotificationTransport transport(status, channelManager);
+    transport.setNotificationProcessor(&processor);
+
+    auto request = transport.createNotificationRequest();
+    BOOST_REQUIRE(!request->topicListHash.is_null());
+    BOOST_CHECK(request->topicListHash.get_bytes() == expectedHash);
+
+    NotificationSyncResponse response;
+    response.availableTopics.set_array(std::vector<Topic>({topic1}));
+    transport.onNotificationResponse(response);
+    BOOST_CHECK_EQUAL(processor.onTopicsListUpdated_, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
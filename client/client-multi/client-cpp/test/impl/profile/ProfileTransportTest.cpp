@@ -0,0 +1,110 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+
+#include "kaa/profile/ProfileTransport.hpp"
+#include "kaa/profile/IProfileManager.hpp"
+
+#include "headers/MockKaaClientStateStorage.hpp"
+#include "headers/channel/MockChannelManager.hpp"
+
+namespace kaa {
+
+class MockSerializedProfileContainer : public ISerializedProfileContainer {
+public:
+    virtual SharedDataBuffer getSerializedProfile()
+    {
+        ++onGetSerializedProfile_;
+
+        const char *profile = "profile";
+        std::size_t size = std::strlen(profile);
+        boost::shared_array<std::uint8_t> buffer(new std::uint8_t[size]);
+        std::memcpy(buffer.get(), profile, size);
+        return SharedDataBuffer(buffer, size);
+    }
+
+    virtual std::uint64_t getProfileRevision() { return revision_; }
+
+public:
+    std::uint64_t revision_ = IProfileContainer::UNKNOWN_REVISION;
+    std::size_t onGetSerializedProfile_ = 0;
+};
+
+class MockProfileManager : public IProfileManager {
+public:
+    MockProfileManager() : container_(new MockSerializedProfileContainer) {}
+
+    virtual void setProfileContainer(ProfileContainerPtr container) {}
+    virtual ISerializedProfileContainerPtr getSerializedProfileContainer() { return container_; }
+
+public:
+    std::shared_ptr<MockSerializedProfileContainer> container_;
+};
+
+BOOST_AUTO_TEST_SUITE(ProfileTransportTestSuite)
+
+BOOST_AUTO_TEST_CASE(SkipSerializationOfUnchangedRevisionTest)
+{
+    MockChannelManager channelManager;
+    MockProfileManager profileManager;
+    IKaaClientStateStoragePtr status(new MockKaaClientStateStorage);
+
+    ProfileTransport transport(channelManager, PublicKey());
+    transport.setClientState(status);
+    transport.setProfileManager(&profileManager);
+
+    auto& container = *profileManager.container_;
+    container.revision_ = IProfileContainer::nextProfileRevision();
+
+    BOOST_CHECK(transport.createProfileRequest());
+    BOOST_CHECK_EQUAL(container.onGetSerializedProfile_, 1);
+
+    /*
+     * The revision is the same, so the profile isn't even serialized.
+     */
+    BOOST_CHECK(!transport.createProfileRequest());
+    BOOST_CHECK_EQUAL(container.onGetSerializedProfile_, 1);
+
+    container.revision_ = IProfileContainer::nextProfileRevision();
+
+    BOOST_CHECK(transport.createProfileRequest());
+    BOOST_CHECK_EQUAL(container.onGetSerializedProfile_, 2);
+}
+
+BOOST_AUTO_TEST_CASE(AlwaysSerializeUnknownRevisionTest)
+{
+    MockChannelManager channelManager;
+    MockProfileManager profileManager;
+    IKaaClientStateStoragePtr status(new MockKaaClientStateStorage);
+
+    ProfileTransport transport(channelManager, PublicKey());
+    transport.setClientState(status);
+    transport.setProfileManager(&profileManager);
+
+    auto& container = *profileManager.container_;
+
+    transport.createProfileRequest();
+    transport.createProfileRequest();
+
+    BOOST_CHECK_EQUAL(container.onGetSerializedProfile_, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
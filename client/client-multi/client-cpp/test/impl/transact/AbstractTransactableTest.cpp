@@ -0,0 +1,103 @@
+/*
+ * Copyright 2014-2015 CyberVision, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <thread>
+#include <vector>
+
+#include "kaa/transact/AbstractTransactable.hpp"
+
+namespace kaa {
+
+class TestTransactable : public AbstractTransactable<std::list<int> > {
+public:
+    virtual void commit(TransactionIdPtr trxId)
+    {
+        std::list<int> items;
+        if (releaseTransaction(trxId, items)) {
+            committed_.splice(committed_.end(), items);
+        }
+    }
+
+    void add(TransactionIdPtr trxId, int item) { addToTransaction(trxId, item); }
+
+public:
+    std::list<int> committed_;
+};
+
+BOOST_AUTO_TEST_SUITE(AbstractTransactableSuite)
+
+BOOST_AUTO_TEST_CASE(CommitAndRollbackTest)
+{
+    TestTransactable transactable;
+
+    auto committedTrx = transactable.beginTransaction();
+    auto rolledBackTrx = transactable.beginTransaction();
+
+    BOOST_CHECK(committedTrx->getNumericId() != rolledBackTrx->getNumericId());
+
+    transactable.add(committedTrx, 1);
+    transactable.add(rolledBackTrx, 2);
+    transactable.add(committedTrx, 3);
+
+    transactable.rollback(rolledBackTrx);
+    transactable.commit(rolledBackTrx);
+    transactable.commit(committedTrx);
+    transactable.commit(committedTrx);
+
+    std::list<int> expected = { 1, 3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(transactable.committed_.begin(), transactable.committed_.end(),
+                                  expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(ParallelTransactionsTest)
+{
+    const int threadsCount = 4;
+    const int itemsCount = 1000;
+
+    TestTransactable transactable;
+    std::vector<TransactionIdPtr> transactions;
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i < threadsCount; ++i) {
+        transactions.push_back(transactable.beginTransaction());
+    }
+
+    for (int i = 0; i < threadsCount; ++i) {
+        producers.emplace_back([&transactable, &transactions, i, itemsCount] {
+            for (int item = 0; item < itemsCount; ++item) {
+                transactable.add(transactions[i], item);
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    for (auto& trxId : transactions) {
+        transactable.commit(trxId);
+    }
+
+    BOOST_CHECK_EQUAL(transactable.committed_.size(), threadsCount * itemsCount);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}